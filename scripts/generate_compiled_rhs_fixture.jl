@@ -0,0 +1,38 @@
+#!/usr/bin/env julia
+"""
+Regenerate `src/DeepTreeEcho/compiled_rhs_fixture.cpp`, the NativeRHSExport
+unit that the Taskflow bridge self-test compiles, loads and checks against a
+C++ reference of the same system.
+
+    julia --project scripts/generate_compiled_rhs_fixture.jl
+
+`test/chua_circuit.jl` fails when the checked-in file differs from this
+output, so rerun the script after changing the emitter.
+"""
+
+using ModelingToolkit
+using ModelingToolkit: t_nounits as t, D_nounits as D
+using IfElse: ifelse
+
+isdefined(@__MODULE__, :NativeRHSExport) ||
+    include(joinpath(@__DIR__, "..", "src", "DeepTreeEcho", "NativeRHSExport.jl"))
+
+const COMPILED_RHS_FIXTURE = joinpath(@__DIR__, "..", "src", "DeepTreeEcho", "compiled_rhs_fixture.cpp")
+
+# Dimensionless Chua circuit; the piecewise-linear diode is an observed variable.
+# The self-test passes parameters in the order alpha, beta, m0, m1.
+function chua_fixture_source()
+    @variables x(t) y(t) z(t) g(t)
+    @parameters alpha beta m0 m1
+    eqs = [g ~ ifelse(x < -1, m1 * (x + 1) - m0, ifelse(x > 1, m1 * (x - 1) + m0, m0 * x)),
+           D(x) ~ alpha * (y - x - g),
+           D(y) ~ x - y + z,
+           D(z) ~ -beta * y]
+    @named chua = System(eqs, t)
+    return NativeRHSExport.emit_native_rhs(mtkcompile(chua); name = "chua")
+end
+
+if abspath(PROGRAM_FILE) == @__FILE__
+    NativeRHSExport.write_native_rhs(COMPILED_RHS_FIXTURE, chua_fixture_source())
+    println("Wrote ", COMPILED_RHS_FIXTURE)
+end
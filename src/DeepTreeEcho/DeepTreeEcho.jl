@@ -97,6 +97,7 @@ include("OntogeneticEngine.jl")
 include("TaskflowIntegration.jl")
 include("PackageIntegration.jl")
 include("Visualization.jl")
+include("NativeRHSExport.jl")
 
 using .A000081Parameters
 using .JSurfaceReactor
@@ -108,12 +109,14 @@ using .OntogeneticEngine
 using .TaskflowIntegration
 using .PackageIntegration
 using .Visualization
+using .NativeRHSExport
 
 export DeepTreeEchoSystem
 export initialize!, evolve!, process_input!, get_system_status
 export plant_trees!, harvest_feedback!, adapt_topology!
 export TaskflowOntogeneticSystem, evolve_with_taskflow!
 export get_parameter_set, explain_parameters, validate_parameters, A000081ParameterSet
+export NativeRHSSource, emit_native_rhs, compile_native_rhs, native_parameter_vector
 
 """
     DeepTreeEchoSystem
@@ -227,22 +227,19 @@ train_reservoir!(reservoir, training_data, targets)
 function train_reservoir!(reservoir::DeepTreeEchoReservoir,
                          training_data::AbstractArray,
                          targets::AbstractArray)
-    # Collect states from membrane network
-    states_history = []
+    # Collect states from membrane network, one column per timestep
+    network = reservoir.membrane_network
+    states_matrix = Matrix{Float64}(undef, membrane_network_size(network), size(training_data, 2))
     
     # Run through training data
     for t in 1:size(training_data, 2)
         input_dict = Dict(1 => [training_data[1, t]])
-        step!(reservoir.membrane_network, input_dict)
+        step!(network, input_dict)
         
         # Extract global state
-        global_state = extract_global_state(reservoir.membrane_network)
-        push!(states_history, global_state)
+        extract_global_state!(view(states_matrix, :, t), network)
     end
     
-    # Convert to matrix
-    states_matrix = hcat(states_history...)
-    
     # Train output weights using ridge regression (simplified)
     # In full implementation, would use ReservoirComputing.jl train function
     
@@ -269,17 +266,16 @@ predictions = predict(reservoir, test_inputs)
 """
 function predict(reservoir::DeepTreeEchoReservoir,
                 input_sequence::AbstractArray)
-    predictions = Float64[]
+    network = reservoir.membrane_network
+    predictions = Vector{Float64}(undef, size(input_sequence, 2))
     
     # Run through input sequence
     for t in 1:size(input_sequence, 2)
         input_dict = Dict(1 => [input_sequence[1, t]])
-        step!(reservoir.membrane_network, input_dict)
+        step!(network, input_dict)
         
         # Extract prediction (simplified - would use trained output weights)
-        global_state = extract_global_state(reservoir.membrane_network)
-        prediction = mean(global_state)  # Placeholder
-        push!(predictions, prediction)
+        predictions[t] = mean(network.global_state)  # Placeholder
     end
     
     return predictions
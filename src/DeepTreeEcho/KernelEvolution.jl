@@ -32,7 +32,7 @@ include("OntogeneticKernel.jl")
 using .OntogeneticKernel
 
 export EvolutionConfig, GenerationStats
-export evolve_kernel_population!, tournament_selection
+export evolve_kernel_population!, tournament_selection, pack_kernel_genomes
 export population_diversity, clone_kernel
 export print_generation_stats, print_population_status
 
@@ -86,6 +86,7 @@ end
     evolve_kernel_population!(population::Vector{Kernel},
                              config::EvolutionConfig;
                              domain_data=nothing,
+                             batch_fitness=nothing,
                              verbose::Bool=true)
 
 Evolve a population of kernels over multiple generations.
@@ -106,6 +107,10 @@ Evolve a population of kernels over multiple generations.
 - `population::Vector{Kernel}`: Initial population (modified in place)
 - `config::EvolutionConfig`: Evolution parameters
 - `domain_data`: Optional domain-specific test data
+- `batch_fitness`: Optional `(genomes, offsets) -> fitness` scoring the whole
+  population in one call on the buffers of `pack_kernel_genomes`, e.g. the
+  bridge's `evaluate_population` on a service built from `load_compiled_fitness`.
+  It replaces the per-kernel `evaluate_kernel_fitness!` loop and sets only `fitness`.
 - `verbose::Bool=true`: Print progress
 
 # Returns
@@ -117,6 +122,7 @@ Modifies population in place.
 function evolve_kernel_population!(population::Vector{Kernel},
                                   config::EvolutionConfig;
                                   domain_data=nothing,
+                                  batch_fitness=nothing,
                                   verbose::Bool=true)
     
     generations_stats = GenerationStats[]
@@ -135,8 +141,17 @@ function evolve_kernel_population!(population::Vector{Kernel},
     
     for gen in 1:config.max_generations
         # 1. Evaluate fitness for all kernels
-        for kernel in population
-            evaluate_kernel_fitness!(kernel, domain_data, population)
+        if batch_fitness === nothing
+            for kernel in population
+                evaluate_kernel_fitness!(kernel, domain_data, population)
+            end
+        else
+            fitness = batch_fitness(pack_kernel_genomes(population)...)
+            length(fitness) == length(population) ||
+                throw(DimensionMismatch("batch_fitness returned $(length(fitness)) values for $(length(population)) kernels"))
+            for (kernel, f) in zip(population, fitness)
+                kernel.fitness = f
+            end
         end
         
         # 2. Sort by fitness (descending)
@@ -219,6 +234,32 @@ function evolve_kernel_population!(population::Vector{Kernel},
     return generations_stats
 end
 
+"""
+    pack_kernel_genomes(population::Vector{Kernel}) -> (genomes, offsets)
+
+Ragged genome buffer for the bridge's batch fitness evaluation. Kernel `i`
+occupies `genomes[offsets[i] + 1 : offsets[i + 1]]` (offsets are 0-based, as
+`evaluate_population` expects); its coefficients are ordered by tree level
+sequence.
+
+# Examples
+```julia
+genomes, offsets = pack_kernel_genomes(population)
+```
+"""
+function pack_kernel_genomes(population::Vector{Kernel})
+    genomes = Float64[]
+    offsets = Int32[0]
+    for kernel in population
+        coefficients = kernel.genome.coefficients
+        for tree in sort!(collect(keys(coefficients)))
+            push!(genomes, coefficients[tree])
+        end
+        push!(offsets, length(genomes))
+    end
+    return genomes, offsets
+end
+
 """
     tournament_selection(population::Vector{Kernel}, 
                         tournament_size::Int)
@@ -6,6 +6,9 @@ reservoir computing, where each membrane contains a reservoir subnet and
 communication rules transfer reservoir states.
 """
 
+# Reservoir state: a contiguous slice of the network's global state buffer
+const StateView = SubArray{Float64, 1, Vector{Float64}, Tuple{UnitRange{Int}}, true}
+
 """
     MembraneReservoir
 
@@ -16,14 +19,15 @@ A membrane containing an embedded echo state network reservoir.
 - `reservoir::ESN`: Echo state network
 - `input_channels::Vector{Symbol}`: Input channel names
 - `output_channels::Vector{Symbol}`: Output channel names
-- `state::Vector{Float64}`: Current reservoir state
+- `state::StateView`: Current reservoir state; once the membrane is part of a
+  network, a view into the network's `global_state`
 """
 mutable struct MembraneReservoir
     membrane::Membrane
     reservoir::ESN
     input_channels::Vector{Symbol}
     output_channels::Vector{Symbol}
-    state::Vector{Float64}
+    state::StateView
     
     function MembraneReservoir(membrane::Membrane,
                               reservoir_size::Int,
@@ -41,7 +45,7 @@ mutable struct MembraneReservoir
         
         input_channels = Symbol[]
         output_channels = Symbol[]
-        state = zeros(Float64, reservoir_size)
+        state = view(zeros(Float64, reservoir_size), 1:reservoir_size)
         
         new(membrane, reservoir, input_channels, output_channels, state)
     end
@@ -57,19 +61,50 @@ Network of membrane-reservoir hybrids forming a hierarchical computational struc
 - `topology::PSystem`: P-system defining membrane structure and rules
 - `communication_matrix::SparseMatrixCSC{Float64}`: Inter-membrane communication weights
 - `generation::Int`: Current generation number
+- `order::Vector{Int}`: Membrane IDs in ascending order (matrix and state order)
+- `global_state::Vector{Float64}`: All reservoir states, concatenated in `order`
 """
 mutable struct MembraneReservoirNetwork
     membranes::Dict{Int, MembraneReservoir}
     topology::PSystem
     communication_matrix::SparseMatrixCSC{Float64}
     generation::Int
+    order::Vector{Int}
+    global_state::Vector{Float64}
     
     function MembraneReservoirNetwork(membranes::Dict{Int, MembraneReservoir},
                                      topology::PSystem)
         n = length(membranes)
         comm_matrix = spzeros(Float64, n, n)
-        new(membranes, topology, comm_matrix, 0)
+        network = new(membranes, topology, comm_matrix, 0, Int[], Float64[])
+        bind_global_state!(network)
+        return network
+    end
+end
+
+"""
+    bind_global_state!(network::MembraneReservoirNetwork)
+
+Rebuild the cached membrane order and the contiguous global state buffer,
+and rebind every membrane's `state` to its slice. Current states are kept.
+Called whenever membranes are added or removed.
+"""
+function bind_global_state!(network::MembraneReservoirNetwork)
+    order = sort!(collect(keys(network.membranes)))
+    total = sum((length(network.membranes[id].state) for id in order); init = 0)
+    buffer = Vector{Float64}(undef, total)
+    offset = 0
+    for id in order
+        mem_res = network.membranes[id]
+        n = length(mem_res.state)
+        range = (offset + 1):(offset + n)
+        copyto!(buffer, offset + 1, mem_res.state, 1, n)
+        mem_res.state = view(buffer, range)
+        offset += n
     end
+    network.order = order
+    network.global_state = buffer
+    return network
 end
 
 """
@@ -133,11 +168,8 @@ initialize_communication_matrix!(network)
 ```
 """
 function initialize_communication_matrix!(network::MembraneReservoirNetwork)
-    membrane_ids = sort(collect(keys(network.membranes)))
-    n = length(membrane_ids)
-    
-    # Create mapping from membrane ID to matrix index
-    id_to_idx = Dict(id => i for (i, id) in enumerate(membrane_ids))
+    # Matrix index = position in the cached membrane order
+    id_to_idx = Dict(id => i for (i, id) in enumerate(network.order))
     
     # Initialize communication weights based on parent-child relationships
     for (id, mem_res) in network.membranes
@@ -179,17 +211,14 @@ function step!(network::MembraneReservoirNetwork,
     for (mem_id, mem_res) in network.membranes
         input = get(inputs, mem_id, zeros(Float64, 1))
         
-        # Add communication from other membranes
-        membrane_ids = sort(collect(keys(network.membranes)))
-        id_to_idx = Dict(id => i for (i, id) in enumerate(membrane_ids))
+        # Add communication from other membranes (matrix index = position in network.order)
+        idx = searchsortedfirst(network.order, mem_id)
         
-        if haskey(id_to_idx, mem_id)
-            idx = id_to_idx[mem_id]
-            
+        if idx <= length(network.order) && network.order[idx] == mem_id
             # Sum weighted inputs from connected membranes
-            for (other_id, other_mem_res) in network.membranes
-                if other_id != mem_id && haskey(id_to_idx, other_id)
-                    other_idx = id_to_idx[other_id]
+            for (other_idx, other_id) in enumerate(network.order)
+                other_mem_res = network.membranes[other_id]
+                if other_id != mem_id
                     weight = network.communication_matrix[idx, other_idx]
                     
                     if weight > 0
@@ -207,8 +236,7 @@ function step!(network::MembraneReservoirNetwork,
         
         # x(t+1) = (1-α)x(t) + α·tanh(W·x(t) + W_in·u(t))
         if size(W, 1) == length(mem_res.state)
-            new_state = (1 - α) * mem_res.state + α * tanh.(W * mem_res.state .+ input[1])
-            mem_res.state = new_state
+            mem_res.state .= (1 - α) .* mem_res.state .+ α .* tanh.(W * mem_res.state .+ input[1])
         end
     end
     
@@ -279,7 +307,7 @@ function adapt_topology!(network::MembraneReservoirNetwork,
             )
             
             # Initialize with perturbed copy of parent state
-            new_mem_res.state = parent_mem_res.state .+ 0.1 * randn(res_size)
+            new_mem_res.state .= parent_mem_res.state .+ 0.1 .* randn(res_size)
             
             membranes_to_add[new_id] = new_mem_res
         end
@@ -295,8 +323,9 @@ function adapt_topology!(network::MembraneReservoirNetwork,
         network.membranes[mem_id] = mem_res
     end
     
-    # Reinitialize communication matrix
+    # Rebuild the state buffer and membrane order, then the communication matrix
     if !isempty(membranes_to_remove) || !isempty(membranes_to_add)
+        bind_global_state!(network)
         initialize_communication_matrix!(network)
     end
     
@@ -322,16 +351,31 @@ global_state = extract_global_state(network)
 ```
 """
 function extract_global_state(network::MembraneReservoirNetwork)
-    states = Float64[]
-    
-    # Sort by membrane ID for consistency
-    membrane_ids = sort(collect(keys(network.membranes)))
-    
-    for mem_id in membrane_ids
-        append!(states, network.membranes[mem_id].state)
-    end
-    
-    return states
+    return extract_global_state!(Vector{Float64}(undef, membrane_network_size(network)), network)
+end
+
+"""
+    extract_global_state!(dest::AbstractVector{Float64},
+                          network::MembraneReservoirNetwork) -> dest
+
+In-place variant of `extract_global_state`: copies `network.global_state`
+(membrane states in ascending membrane ID order) into `dest`, of length
+`membrane_network_size(network)`. `dest` may be a column view of a
+preallocated history matrix. Reading `network.global_state` directly
+avoids the copy.
+
+# Examples
+```julia
+history = Matrix{Float64}(undef, membrane_network_size(network), T)
+extract_global_state!(view(history, :, t), network)
+```
+"""
+function extract_global_state!(dest::AbstractVector{Float64},
+                               network::MembraneReservoirNetwork)
+    state = network.global_state
+    length(state) == length(dest) || throw(DimensionMismatch(
+        "destination has length $(length(dest)), global state has $(length(state))"))
+    return copyto!(dest, state)
 end
 
 """
@@ -351,9 +395,5 @@ size = membrane_network_size(network)
 ```
 """
 function membrane_network_size(network::MembraneReservoirNetwork)
-    total = 0
-    for (_, mem_res) in network.membranes
-        total += length(mem_res.state)
-    end
-    return total
+    return length(network.global_state)
 end
@@ -0,0 +1,291 @@
+"""
+    NativeRHSExport
+
+Export path from ModelingToolkit systems to native right-hand sides.
+
+A simplified ODE system (e.g. the output of `mtkcompile`) is emitted as a C++
+translation unit implementing the compiled RHS ABI of `compiled_rhs_abi.hpp`:
+
+- a generic `rhs(y, p, t, dy)` instantiated on doubles and on hyper-dual
+  numbers, so native B-series engines get exact elementary differentials
+- the symbolic Jacobian `∂f/∂y` as straight-line code
+- `extern "C"` entry points, loaded by `CompiledKernel` in the Taskflow bridge
+
+Native integrators and ensemble runners can then call the generated code
+directly, with no Julia dispatch or boxing per evaluation. The native engines
+integrate autonomous systems `y' = f(y)`, so systems whose equations use the
+independent variable are rejected.
+"""
+module NativeRHSExport
+
+import ModelingToolkit
+import Symbolics
+
+const SymbolicUtils = Symbolics.SymbolicUtils
+
+export NativeRHSSource, emit_native_rhs, write_native_rhs, compile_native_rhs
+export native_parameter_vector
+
+"""
+    NativeRHSSource
+
+Generated C++ source for one ODE system.
+
+Fields:
+- `name::String`: Kernel name reported through the ABI
+- `code::String`: Complete translation unit
+- `unknowns::Vector{Any}`: State ordering, `y[i - 1]` is `unknowns[i]`
+- `parameters::Vector{Any}`: Parameter ordering, `p[j - 1]` is `parameters[j]`
+"""
+struct NativeRHSSource
+    name::String
+    code::String
+    unknowns::Vector{Any}
+    parameters::Vector{Any}
+end
+
+# Elementary functions available on both doubles and hyper-duals
+const CXX_FUNCTIONS = Dict{Any, String}(
+    sin => "sin", cos => "cos", exp => "exp", log => "log",
+    sqrt => "sqrt", tanh => "tanh", abs => "compiled::abs"
+)
+
+const CXX_COMPARISONS = Dict{Any, String}(
+    (<) => "<", (>) => ">", (<=) => "<=", (>=) => ">=", (==) => "==", (!=) => "!="
+)
+
+struct EmitContext
+    names::Dict{Any, String}
+    iv::Any
+end
+
+function cxx_literal(x::Real)
+    v = Float64(x)
+    isnan(v) && return "std::numeric_limits<double>::quiet_NaN()"
+    isinf(v) && return v > 0 ? "std::numeric_limits<double>::infinity()" :
+                       "(-std::numeric_limits<double>::infinity())"
+    s = repr(v)
+    return v < 0 ? "($s)" : s
+end
+
+# Newer SymbolicUtils wrap literals in constant terms; older ones keep plain numbers
+@static if isdefined(SymbolicUtils, :unwrap_const)
+    unwrap_constant(x) = SymbolicUtils.unwrap_const(Symbolics.unwrap(x))
+else
+    unwrap_constant(x) = Symbolics.unwrap(x)
+end
+
+function emit_expr(x, ctx::EmitContext)
+    x = unwrap_constant(x)
+    x isa Bool && return x ? "true" : "false"
+    x isa Real && return cxx_literal(x)
+    haskey(ctx.names, x) && return ctx.names[x]
+    isequal(x, ctx.iv) && error("Native RHS export needs an autonomous system; the equations use $x")
+    SymbolicUtils.iscall(x) || error("Cannot emit symbol $x: not an unknown, parameter or observed variable")
+
+    op = SymbolicUtils.operation(x)
+    args = SymbolicUtils.arguments(x)
+    emitted() = [emit_expr(a, ctx) for a in args]
+
+    if op === (+)
+        return "(" * join(emitted(), " + ") * ")"
+    elseif op === (*)
+        return "(" * join(emitted(), " * ") * ")"
+    elseif op === (-)
+        a = emitted()
+        return length(a) == 1 ? "(-$(a[1]))" : "($(a[1]) - $(a[2]))"
+    elseif op === (/)
+        a = emitted()
+        return "($(a[1]) / $(a[2]))"
+    elseif op === (^)
+        return emit_power(args[1], unwrap_constant(args[2]), ctx)
+    elseif op === ifelse || (op isa Function && nameof(op) === :ifelse)
+        c, a, b = emitted()
+        return "($c ? S($a) : S($b))"
+    elseif haskey(CXX_COMPARISONS, op)
+        a = emitted()
+        return "(compiled::value($(a[1])) $(CXX_COMPARISONS[op]) compiled::value($(a[2])))"
+    elseif op === (&)
+        return "(" * join(emitted(), " && ") * ")"
+    elseif op === (|)
+        return "(" * join(emitted(), " || ") * ")"
+    elseif op === (!)
+        return "(!$(emitted()[1]))"
+    elseif op === tan
+        a = emitted()[1]
+        return "(sin($a) / cos($a))"
+    elseif op === max || op === min
+        a, b = emitted()
+        cmp = op === max ? ">" : "<"
+        return "((compiled::value($a) $cmp compiled::value($b)) ? S($a) : S($b))"
+    elseif haskey(CXX_FUNCTIONS, op)
+        return "$(CXX_FUNCTIONS[op])($(join(emitted(), ", ")))"
+    end
+    error("Unsupported operation in native RHS export: $op")
+end
+
+function emit_power(base, exponent, ctx::EmitContext)
+    b = emit_expr(base, ctx)
+    if exponent isa Real && isinteger(exponent)
+        n = Int(exponent)
+        n == 0 && return "S(1.0)"
+        n > 0 && return "compiled::ipow(S($b), $n)"
+        return "(1.0 / compiled::ipow(S($b), $(-n)))"
+    elseif exponent isa Real
+        return "pow(S($b), $(cxx_literal(exponent)))"
+    end
+    return "exp(log(S($b)) * $(emit_expr(exponent, ctx)))"
+end
+
+"""
+    emit_native_rhs(sys; name="rhs") -> NativeRHSSource
+
+Generate the C++ translation unit for a simplified ODE system.
+
+Every equation must have the form `D(x) ~ rhs`, and neither the equations nor
+the observed variables may use the independent variable. Observed equations
+are emitted as locals in their (topological) order; for the Jacobian they are
+substituted symbolically.
+
+# Examples
+```julia
+sys = mtkcompile(model)
+src = emit_native_rhs(sys; name="chua")
+```
+"""
+function emit_native_rhs(sys; name::AbstractString="rhs")
+    states = collect(Any, ModelingToolkit.unknowns(sys))
+    params = collect(Any, ModelingToolkit.parameters(sys))
+    iv = ModelingToolkit.get_iv(sys)
+    n = length(states)
+
+    names = Dict{Any, String}()
+    for (i, x) in enumerate(states)
+        names[Symbolics.unwrap(x)] = "y[$(i - 1)]"
+    end
+    for (j, q) in enumerate(params)
+        names[Symbolics.unwrap(q)] = "p[$(j - 1)]"
+    end
+    ctx = EmitContext(names, Symbolics.unwrap(iv))
+
+    # Right-hand sides in state order
+    state_index = Dict(Symbolics.unwrap(x) => i for (i, x) in enumerate(states))
+    rhss = Vector{Any}(undef, n)
+    for eq in ModelingToolkit.equations(sys)
+        lhs = Symbolics.unwrap(eq.lhs)
+        if !(SymbolicUtils.iscall(lhs) && SymbolicUtils.operation(lhs) isa Symbolics.Differential)
+            error("Native RHS export needs an explicit ODE system; got equation $eq")
+        end
+        x = SymbolicUtils.arguments(lhs)[1]
+        haskey(state_index, x) || error("Differentiated variable $x is not an unknown")
+        rhss[state_index[x]] = eq.rhs
+    end
+    any(i -> !isassigned(rhss, i), 1:n) && error("Some unknowns have no differential equation")
+
+    io = IOBuffer()
+    println(io, "// Generated by DeepTreeEcho.NativeRHSExport from $(nameof(sys)); do not edit.")
+    println(io, "//")
+    for (i, x) in enumerate(states)
+        println(io, "//   y[$(i - 1)] = $x")
+    end
+    for (j, q) in enumerate(params)
+        println(io, "//   p[$(j - 1)] = $q")
+    end
+    println(io)
+    println(io, "#include \"compiled_rhs_abi.hpp\"")
+    println(io)
+    println(io, "namespace {")
+    println(io)
+    println(io, "using namespace taskflow_bridge;")
+    println(io)
+
+    # Generic RHS with observed locals
+    println(io, "template <class S>")
+    println(io, "void rhs(const S* y, const double* p, double t, S* dy) {")
+    println(io, "    using std::sin; using std::cos; using std::exp; using std::log;")
+    println(io, "    using std::sqrt; using std::tanh; using std::pow;")
+    println(io, "    (void)y; (void)p; (void)t;")
+    observed = ModelingToolkit.observed(sys)
+    for (k, eq) in enumerate(observed)
+        local_name = "o$(k - 1)"
+        println(io, "    const S $local_name = S($(emit_expr(eq.rhs, ctx)));")
+        ctx.names[Symbolics.unwrap(eq.lhs)] = local_name
+    end
+    for i in 1:n
+        println(io, "    dy[$(i - 1)] = S($(emit_expr(rhss[i], ctx)));")
+    end
+    println(io, "}")
+    println(io)
+
+    # Jacobian with observed variables substituted
+    substitutions = Dict(Symbolics.unwrap(eq.lhs) => Symbolics.unwrap(eq.rhs) for eq in observed)
+    for eq in observed
+        delete!(ctx.names, Symbolics.unwrap(eq.lhs))
+    end
+    explicit = [Symbolics.fixpoint_sub(r, substitutions) for r in rhss]
+    J = Symbolics.jacobian(explicit, states)
+    println(io, "void jacobian(const double* y, const double* p, double t, double* J) {")
+    println(io, "    using S = double;")
+    println(io, "    using std::sin; using std::cos; using std::exp; using std::log;")
+    println(io, "    using std::sqrt; using std::tanh; using std::pow;")
+    println(io, "    (void)y; (void)p; (void)t;")
+    println(io, "    for (int k = 0; k < $(n * n); ++k) J[k] = 0.0;")
+    for i in 1:n, j in 1:n
+        entry = unwrap_constant(J[i, j])
+        (entry isa Real && iszero(entry)) && continue
+        println(io, "    J[$((i - 1) * n + j - 1)] = $(emit_expr(entry, ctx));")
+    end
+    println(io, "}")
+    println(io)
+    println(io, "} // namespace")
+    println(io)
+    println(io, "DTE_EXPORT_COMPILED_RHS(\"$name\", $n, $(length(params)), rhs, jacobian)")
+
+    return NativeRHSSource(String(name), String(take!(io)), states, params)
+end
+
+"""
+    write_native_rhs(path, src::NativeRHSSource) -> String
+
+Write the generated translation unit to `path`.
+"""
+function write_native_rhs(path::AbstractString, src::NativeRHSSource)
+    write(path, src.code)
+    return String(path)
+end
+
+"""
+    compile_native_rhs(src::NativeRHSSource, dir; cxx, flags) -> String
+
+Compile the generated source into `dir/lib<name>.so` and return its path,
+ready for `TaskflowBridge::load_compiled_kernel`.
+
+# Arguments
+- `src::NativeRHSSource`: Output of `emit_native_rhs`
+- `dir::AbstractString`: Output directory
+- `cxx::AbstractString`: C++ compiler (default `ENV["CXX"]` or `c++`)
+- `flags::Vector{String}`: Optimization flags (default `["-O3"]`)
+"""
+function compile_native_rhs(src::NativeRHSSource, dir::AbstractString;
+                            cxx::AbstractString=get(ENV, "CXX", "c++"),
+                            flags::Vector{String}=["-O3"])
+    mkpath(dir)
+    source = write_native_rhs(joinpath(dir, "$(src.name).cpp"), src)
+    library = joinpath(dir, "lib$(src.name).so")
+    run(`$cxx -std=c++17 $flags -shared -fPIC -fvisibility=hidden -I$(@__DIR__) $source -o $library`)
+    return library
+end
+
+"""
+    native_parameter_vector(src::NativeRHSSource, values) -> Vector{Float64}
+
+Order parameter values (a `Dict` or pairs keyed by parameter) as the
+generated `p` array expects.
+"""
+function native_parameter_vector(src::NativeRHSSource, values)
+    lookup = Dict(Symbolics.unwrap(k) => Float64(v) for (k, v) in values)
+    return [haskey(lookup, Symbolics.unwrap(q)) ? lookup[Symbolics.unwrap(q)] :
+            error("No value for parameter $q") for q in src.parameters]
+end
+
+end # module NativeRHSExport
@@ -0,0 +1,179 @@
+/**
+ * adjoint.hpp
+ *
+ * Tape-based reverse-mode automatic differentiation.
+ *
+ * AdjointVar records every operation on the thread's active AdjointTape as a
+ * node with at most two parents and their local partials. One backward sweep
+ * over the tape then yields the full gradient of a scalar output, at a small
+ * constant multiple of the cost of evaluating it. Constants carry id -1 and
+ * are never recorded. The tape keeps its capacity between evaluations, so a
+ * warmed-up tape records without allocating.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace taskflow_bridge {
+
+class AdjointTape {
+public:
+    struct Node {
+        std::int32_t a;
+        std::int32_t b;
+        double da;
+        double db;
+    };
+
+    // New independent variable
+    std::int32_t variable() {
+        nodes_.push_back({-1, -1, 0.0, 0.0});
+        return static_cast<std::int32_t>(nodes_.size() - 1);
+    }
+
+    std::int32_t record(std::int32_t a, double da, std::int32_t b = -1, double db = 0.0) {
+        if (a < 0 && b < 0) return -1;
+        nodes_.push_back({a, b, da, db});
+        return static_cast<std::int32_t>(nodes_.size() - 1);
+    }
+
+    void clear() { nodes_.clear(); }
+
+    // Adjoints of every node with respect to `output`
+    void backpropagate(std::int32_t output) {
+        adjoints_.assign(nodes_.size(), 0.0);
+        if (output < 0) return;
+        adjoints_[output] = 1.0;
+        for (std::int32_t i = output; i >= 0; --i) {
+            const double adj = adjoints_[i];
+            if (adj == 0.0) continue;
+            const Node& n = nodes_[i];
+            if (n.a >= 0) adjoints_[n.a] += n.da * adj;
+            if (n.b >= 0) adjoints_[n.b] += n.db * adj;
+        }
+    }
+
+    double adjoint(std::int32_t id) const { return id < 0 ? 0.0 : adjoints_[id]; }
+    std::size_t size() const { return nodes_.size(); }
+
+    // Tape used by AdjointVar arithmetic on this thread
+    static AdjointTape*& active() {
+        thread_local AdjointTape* tape = nullptr;
+        return tape;
+    }
+
+private:
+    std::vector<Node> nodes_;
+    std::vector<double> adjoints_;
+};
+
+// Makes `tape` the active tape for the current scope
+class AdjointTapeScope {
+public:
+    explicit AdjointTapeScope(AdjointTape& tape) : previous_(AdjointTape::active()) {
+        AdjointTape::active() = &tape;
+    }
+    ~AdjointTapeScope() { AdjointTape::active() = previous_; }
+
+    AdjointTapeScope(const AdjointTapeScope&) = delete;
+    AdjointTapeScope& operator=(const AdjointTapeScope&) = delete;
+
+private:
+    AdjointTape* previous_;
+};
+
+struct AdjointVar {
+    double value = 0.0;
+    std::int32_t id = -1;
+
+    AdjointVar() = default;
+    AdjointVar(double v) : value(v) {}
+    AdjointVar(double v, std::int32_t i) : value(v), id(i) {}
+
+    AdjointVar& operator+=(const AdjointVar& o) { return *this = *this + o; }
+    AdjointVar& operator-=(const AdjointVar& o) { return *this = *this - o; }
+    AdjointVar& operator*=(const AdjointVar& o) { return *this = *this * o; }
+    AdjointVar& operator/=(const AdjointVar& o) { return *this = *this / o; }
+
+    friend AdjointVar operator+(const AdjointVar& x, const AdjointVar& y) {
+        return {x.value + y.value, record(x.id, 1.0, y.id, 1.0)};
+    }
+    friend AdjointVar operator-(const AdjointVar& x, const AdjointVar& y) {
+        return {x.value - y.value, record(x.id, 1.0, y.id, -1.0)};
+    }
+    friend AdjointVar operator*(const AdjointVar& x, const AdjointVar& y) {
+        return {x.value * y.value, record(x.id, y.value, y.id, x.value)};
+    }
+    friend AdjointVar operator/(const AdjointVar& x, const AdjointVar& y) {
+        const double inv = 1.0 / y.value;
+        const double q = x.value * inv;
+        return {q, record(x.id, inv, y.id, -q * inv)};
+    }
+    friend AdjointVar operator-(const AdjointVar& x) {
+        return {-x.value, record(x.id, -1.0)};
+    }
+    friend AdjointVar operator+(const AdjointVar& x) { return x; }
+
+    friend bool operator<(const AdjointVar& x, const AdjointVar& y) { return x.value < y.value; }
+    friend bool operator>(const AdjointVar& x, const AdjointVar& y) { return x.value > y.value; }
+    friend bool operator<=(const AdjointVar& x, const AdjointVar& y) { return x.value <= y.value; }
+    friend bool operator>=(const AdjointVar& x, const AdjointVar& y) { return x.value >= y.value; }
+    friend bool operator==(const AdjointVar& x, const AdjointVar& y) { return x.value == y.value; }
+    friend bool operator!=(const AdjointVar& x, const AdjointVar& y) { return x.value != y.value; }
+
+    static std::int32_t record(std::int32_t a, double da, std::int32_t b = -1, double db = 0.0) {
+        AdjointTape* tape = AdjointTape::active();
+        return tape ? tape->record(a, da, b, db) : -1;
+    }
+};
+
+namespace detail {
+
+inline AdjointVar adjoint_unary(const AdjointVar& x, double value, double derivative) {
+    return {value, AdjointVar::record(x.id, derivative)};
+}
+
+} // namespace detail
+
+// Elementary functions
+
+inline AdjointVar exp(const AdjointVar& x) {
+    const double e = std::exp(x.value);
+    return detail::adjoint_unary(x, e, e);
+}
+
+inline AdjointVar log(const AdjointVar& x) {
+    return detail::adjoint_unary(x, std::log(x.value), 1.0 / x.value);
+}
+
+inline AdjointVar sin(const AdjointVar& x) {
+    return detail::adjoint_unary(x, std::sin(x.value), std::cos(x.value));
+}
+
+inline AdjointVar cos(const AdjointVar& x) {
+    return detail::adjoint_unary(x, std::cos(x.value), -std::sin(x.value));
+}
+
+inline AdjointVar sqrt(const AdjointVar& x) {
+    const double s = std::sqrt(x.value);
+    return detail::adjoint_unary(x, s, 0.5 / s);
+}
+
+inline AdjointVar tanh(const AdjointVar& x) {
+    const double t = std::tanh(x.value);
+    return detail::adjoint_unary(x, t, 1.0 - t * t);
+}
+
+inline AdjointVar abs(const AdjointVar& x) {
+    return detail::adjoint_unary(x, std::abs(x.value), x.value < 0.0 ? -1.0 : 1.0);
+}
+
+inline AdjointVar pow(const AdjointVar& x, double p) {
+    return detail::adjoint_unary(x, std::pow(x.value, p), p * std::pow(x.value, p - 1.0));
+}
+
+} // namespace taskflow_bridge
@@ -0,0 +1,194 @@
+/**
+ * bseries_stepper.hpp
+ *
+ * Allocation-free B-series integration step
+ *
+ *     y_{n+1} = y_n + Σ_{|τ| <= p} b(τ) h^|τ| / σ(τ) · F(τ)(y_n)
+ *
+ * on top of the shared-subtree ElementaryDifferentialDAG. The per-tree
+ * weights b(τ)·h^|τ|/σ(τ) are recomputed only when h or the coefficients
+ * change, and all contributions are accumulated with fused multiply-adds into
+ * one preallocated increment buffer. Trees with b(τ) = 0 (and subtrees only
+ * they need) are not evaluated at all.
+ */
+
+#pragma once
+
+#include "elementary_differentials.hpp"
+#include "rhs_kernel.hpp"
+#include "tree_arena.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * BSeriesWeights
+ *
+ * Coefficients b(τ) and the derived step weights b(τ)·h^|τ|/σ(τ) for a
+ * fixed list of trees (DAG slot order). Weights are refreshed lazily, only
+ * when h or a coefficient changes.
+ */
+class BSeriesWeights {
+public:
+    BSeriesWeights(const TreeArena& arena, const std::vector<TreeId>& trees, int max_order)
+        : coefficients_(trees.size(), 0.0),
+          weights_(trees.size(), 0.0),
+          inv_symmetry_(trees.size()),
+          inv_density_(trees.size()),
+          order_(trees.size()),
+          h_powers_(max_order + 1, 1.0) {
+        for (std::size_t s = 0; s < trees.size(); ++s) {
+            inv_symmetry_[s] = 1.0 / arena.symmetry(trees[s]);
+            inv_density_[s] = 1.0 / arena.density(trees[s]);
+            order_[s] = arena.order(trees[s]);
+        }
+    }
+
+    void set_coefficients(const std::vector<double>& b) {
+        if (b.size() != coefficients_.size()) {
+            throw std::runtime_error("Expected " + std::to_string(coefficients_.size()) +
+                                     " B-series coefficients, got " + std::to_string(b.size()));
+        }
+        coefficients_ = b;
+        dirty_ = true;
+    }
+
+    void set_coefficient(int slot, double b) {
+        coefficients_.at(slot) = b;
+        dirty_ = true;
+    }
+
+    /**
+     * b(τ) = 1/γ(τ) for |τ| <= order and 0 above: the Taylor expansion of
+     * the exact flow truncated at `order`.
+     */
+    void set_exact(int order) {
+        for (std::size_t s = 0; s < coefficients_.size(); ++s) {
+            coefficients_[s] = order_[s] <= order ? inv_density_[s] : 0.0;
+        }
+        dirty_ = true;
+    }
+
+    // Slots with a non-zero coefficient, for ElementaryDifferentialDAG::restrict_to
+    std::vector<char> required() const {
+        std::vector<char> mask(coefficients_.size());
+        for (std::size_t s = 0; s < coefficients_.size(); ++s) {
+            mask[s] = coefficients_[s] != 0.0;
+        }
+        return mask;
+    }
+
+    const std::vector<double>& at(double h) {
+        if (h != cached_h_ || dirty_) {
+            for (std::size_t k = 1; k < h_powers_.size(); ++k) {
+                h_powers_[k] = h_powers_[k - 1] * h;
+            }
+            for (std::size_t s = 0; s < weights_.size(); ++s) {
+                weights_[s] = coefficients_[s] * h_powers_[order_[s]] * inv_symmetry_[s];
+            }
+            cached_h_ = h;
+            dirty_ = false;
+        }
+        return weights_;
+    }
+
+    const std::vector<double>& coefficients() const { return coefficients_; }
+    std::size_t size() const { return coefficients_.size(); }
+
+private:
+    std::vector<double> coefficients_;
+    std::vector<double> weights_;
+    std::vector<double> inv_symmetry_;
+    std::vector<double> inv_density_;
+    std::vector<int> order_;
+    std::vector<double> h_powers_;
+
+    double cached_h_ = 0.0;
+    bool dirty_ = true;
+};
+
+/**
+ * BSeriesStepper
+ *
+ * Coefficients are indexed by DAG slot, i.e. in the order of
+ * TreeArena::enumerate_up_to(max_order).
+ */
+class BSeriesStepper {
+public:
+    BSeriesStepper(std::shared_ptr<const RhsKernel> kernel, TreeArena& arena, int max_order)
+        : dag_(std::move(kernel), arena, max_order),
+          weights_(arena, dag_.trees(), max_order) {
+        increment_.assign(dag_.dim(), 0.0);
+        set_exact_coefficients(max_order);
+    }
+
+    // Coefficients
+
+    void set_coefficients(const std::vector<double>& b) {
+        weights_.set_coefficients(b);
+        dag_.restrict_to(weights_.required());
+    }
+
+    void set_coefficient(TreeId tree, double b) {
+        weights_.set_coefficient(dag_.slot(tree), b);
+        dag_.restrict_to(weights_.required());
+    }
+
+    void set_exact_coefficients(int order) {
+        weights_.set_exact(order);
+        dag_.restrict_to(weights_.required());
+    }
+
+    // Stepping
+
+    /**
+     * Advance `state` (length dim) by one step of size h, in place.
+     */
+    void step(double* state, double h) {
+        const std::vector<double>& weights = weights_.at(h);
+
+        dag_.evaluate(state);
+
+        const int dim = dag_.dim();
+        const double* F = dag_.values().data();
+        double* inc = increment_.data();
+        for (int i = 0; i < dim; ++i) inc[i] = 0.0;
+
+        for (std::size_t s = 0; s < weights.size(); ++s) {
+            const double w = weights[s];
+            if (w == 0.0) continue;
+            const double* Fs = F + s * dim;
+            for (int i = 0; i < dim; ++i) {
+                inc[i] = std::fma(w, Fs[i], inc[i]);
+            }
+        }
+
+        for (int i = 0; i < dim; ++i) state[i] += inc[i];
+        ++steps_;
+    }
+
+    void integrate(double* state, double h, int num_steps) {
+        for (int k = 0; k < num_steps; ++k) step(state, h);
+    }
+
+    // Accessors
+
+    const std::vector<double>& coefficients() const { return weights_.coefficients(); }
+    const ElementaryDifferentialDAG& dag() const { return dag_; }
+    int dim() const { return dag_.dim(); }
+    std::uint64_t steps() const { return steps_; }
+
+private:
+    ElementaryDifferentialDAG dag_;
+    BSeriesWeights weights_;
+    std::vector<double> increment_;
+    std::uint64_t steps_ = 0;
+};
+
+} // namespace taskflow_bridge
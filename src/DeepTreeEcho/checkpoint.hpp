@@ -0,0 +1,514 @@
+/**
+ * checkpoint.hpp
+ *
+ * Versioned binary checkpoints of native state.
+ *
+ * A checkpoint is a set of named, typed columns (sections) in one file:
+ *
+ *     [ magic "DTECKPT\0" | u32 version | u32 num_sections | u64 file bytes | u64 reserved ]
+ *     num_sections × [ char name[48] | u32 type | u32 reserved | u64 offset | u64 count | u64 checksum ]
+ *     payloads, each 64-byte aligned
+ *
+ * all little endian. Objects add their columns under a prefix
+ * ("population.3.coefficients", ...) with save(writer, prefix), and
+ * rebuild from them with restore(reader, prefix).
+ *
+ * CheckpointWriter only records pointers to the live columns; the
+ * objects must outlive write(). The file is sized up front and mapped, and
+ * sections are copied and checksummed in 4 MiB chunks, one executor task
+ * per chunk. The magic is written last, then the file is synced and renamed
+ * over the target, so a crash mid-write leaves the previous checkpoint
+ * intact.
+ *
+ * CheckpointReader maps the file read-only. column<T>(name) is a view into
+ * the mapping, with no copy until an object restores from it. verify()
+ * recomputes the checksums in parallel. A reader can also wrap an in-memory
+ * image of the same layout (CheckpointWriter::image), which is how
+ * delta_checkpoint.hpp hands out a replayed state.
+ */
+
+#pragma once
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace taskflow_bridge {
+
+enum class CheckpointType : std::uint32_t {
+    Float64 = 1,
+    Int32 = 2,
+    Int64 = 3,
+    UInt32 = 4,
+    UInt64 = 5,
+    UInt8 = 6,
+};
+
+template <class T> struct CheckpointTypeOf;
+template <> struct CheckpointTypeOf<double> { static constexpr CheckpointType value = CheckpointType::Float64; };
+template <> struct CheckpointTypeOf<std::int32_t> { static constexpr CheckpointType value = CheckpointType::Int32; };
+template <> struct CheckpointTypeOf<std::int64_t> { static constexpr CheckpointType value = CheckpointType::Int64; };
+template <> struct CheckpointTypeOf<std::uint32_t> { static constexpr CheckpointType value = CheckpointType::UInt32; };
+template <> struct CheckpointTypeOf<std::uint64_t> { static constexpr CheckpointType value = CheckpointType::UInt64; };
+template <> struct CheckpointTypeOf<std::uint8_t> { static constexpr CheckpointType value = CheckpointType::UInt8; };
+
+struct CheckpointSection {
+    char name[48];
+    std::uint32_t type;
+    std::uint32_t reserved;
+    std::uint64_t offset;
+    std::uint64_t count;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(CheckpointSection) == 80, "Checkpoint section entries are 80 bytes");
+
+namespace checkpoint_detail {
+
+constexpr char kMagic[8] = {'D', 'T', 'E', 'C', 'K', 'P', 'T', '\0'};
+constexpr std::size_t kHeaderBytes = 32;
+constexpr std::size_t kAlignment = 64;
+constexpr std::size_t kChunkBytes = std::size_t{1} << 22;
+
+inline std::size_t element_bytes(CheckpointType type) {
+    switch (type) {
+        case CheckpointType::Float64:
+        case CheckpointType::Int64:
+        case CheckpointType::UInt64: return 8;
+        case CheckpointType::Int32:
+        case CheckpointType::UInt32: return 4;
+        case CheckpointType::UInt8: return 1;
+    }
+    throw std::runtime_error("Unknown checkpoint column type: " + std::to_string(static_cast<std::uint32_t>(type)));
+}
+
+inline std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t mix(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Four independent word lanes, so hashing keeps up with memcpy
+inline std::uint64_t hash_bytes(const char* p, std::size_t n, std::uint64_t seed) {
+    constexpr std::uint64_t k1 = 0x87c37b91114253d5ULL, k2 = 0x4cf5ad432745937fULL;
+    std::uint64_t h[4] = {seed, seed ^ k1, seed ^ k2, seed ^ (k1 + k2)};
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i + 8 * l, 8);
+            h[l] = rotl(h[l] ^ (w * k1), 31) * k2;
+        }
+    }
+    std::uint64_t tail = 0;
+    for (std::size_t k = 0; i + k < n; ++k) tail |= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i + k])) << (8 * (k & 7));
+    return mix(h[0] ^ rotl(h[1], 17) ^ rotl(h[2], 29) ^ rotl(h[3], 41) ^ mix(tail ^ n));
+}
+
+// Checksum of one section: chunk hashes folded in order
+inline std::uint64_t fold(const std::uint64_t* chunk_hashes, std::size_t num_chunks) {
+    std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ num_chunks;
+    for (std::size_t c = 0; c < num_chunks; ++c) h = mix(h ^ chunk_hashes[c]) + c;
+    return h;
+}
+
+inline std::size_t num_chunks(std::size_t bytes) { return std::max<std::size_t>(1, (bytes + kChunkBytes - 1) / kChunkBytes); }
+
+inline std::size_t align_up(std::size_t n) { return (n + kAlignment - 1) / kAlignment * kAlignment; }
+
+struct Chunk {
+    std::size_t section;
+    std::size_t begin;
+    std::size_t bytes;
+};
+
+// Splits each section into kChunkBytes pieces; section s owns chunks [first[s], first[s + 1])
+inline void plan_chunks(const std::vector<std::size_t>& section_bytes, std::vector<Chunk>& chunks,
+                        std::vector<std::size_t>& first) {
+    chunks.clear();
+    first.assign(section_bytes.size() + 1, 0);
+    for (std::size_t s = 0; s < section_bytes.size(); ++s) {
+        const std::size_t bytes = section_bytes[s];
+        first[s] = chunks.size();
+        for (std::size_t c = 0; c < num_chunks(bytes); ++c) {
+            const std::size_t begin = c * kChunkBytes;
+            chunks.push_back({s, begin, std::min(kChunkBytes, bytes - std::min(bytes, begin))});
+        }
+    }
+    first[section_bytes.size()] = chunks.size();
+}
+
+} // namespace checkpoint_detail
+
+// Read-only view of one column inside a mapped checkpoint
+template <class T>
+struct CheckpointColumn {
+    const T* data = nullptr;
+    std::size_t size = 0;
+
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const T& operator[](std::size_t i) const { return data[i]; }
+    std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+};
+
+/**
+ * CheckpointWriter
+ */
+class CheckpointWriter {
+public:
+    template <class T>
+    void add(const std::string& name, const T* data, std::size_t count) {
+        add_raw(name, CheckpointTypeOf<T>::value, data, count);
+    }
+
+    template <class T>
+    void add(const std::string& name, const std::vector<T>& column) {
+        add(name, column.data(), column.size());
+    }
+
+    // Small columns (counters, shapes) are copied and owned by the writer
+    template <class T>
+    void add_values(const std::string& name, std::vector<T> values) {
+        owned_.emplace_back(reinterpret_cast<const char*>(values.data()),
+                            reinterpret_cast<const char*>(values.data() + values.size()));
+        add_raw(name, CheckpointTypeOf<T>::value, owned_.back().data(), values.size());
+    }
+
+    // A column of raw elements of the given type
+    void add(const std::string& name, CheckpointType type, const void* data, std::size_t count) {
+        checkpoint_detail::element_bytes(type);
+        add_raw(name, type, data, count);
+    }
+
+    // Takes ownership of bytes holding whole elements of the given type
+    void add_bytes(const std::string& name, CheckpointType type, std::vector<char> bytes) {
+        const std::size_t size = checkpoint_detail::element_bytes(type);
+        if (bytes.size() % size != 0) {
+            throw std::runtime_error("Checkpoint section is not a whole number of elements: " + name);
+        }
+        owned_.push_back(std::move(bytes));
+        add_raw(name, type, owned_.back().data(), owned_.back().size() / size);
+    }
+
+    /**
+     * Write every section to path (via path + ".tmp" and rename). Returns
+     * the file size in bytes.
+     */
+    std::size_t write(tf::Executor& executor, const std::string& path) {
+        using namespace checkpoint_detail;
+        const Layout layout = plan();
+        const std::string tmp = path + ".tmp";
+        const int fd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open checkpoint file: " + tmp);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(layout.bytes)) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot size checkpoint file: " + tmp);
+        }
+        void* map = ::mmap(nullptr, layout.bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot mmap checkpoint file: " + tmp);
+        }
+        char* base = static_cast<char*>(map);
+        fill(executor, layout, base);
+        ::msync(base, layout.bytes, MS_SYNC);
+        std::memcpy(base, kMagic, 8);
+        const bool synced = ::msync(base, kHeaderBytes, MS_SYNC) == 0 && ::fsync(fd) == 0;
+        ::munmap(base, layout.bytes);
+        ::close(fd);
+        if (!synced || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("Cannot commit checkpoint file: " + path);
+        }
+        return layout.bytes;
+    }
+
+    // The same bytes write() would produce, in memory
+    std::vector<char> image(tf::Executor& executor) const {
+        const Layout layout = plan();
+        std::vector<char> out(layout.bytes, 0);
+        fill(executor, layout, out.data());
+        std::memcpy(out.data(), checkpoint_detail::kMagic, 8);
+        return out;
+    }
+
+    struct Column {
+        std::string name;
+        CheckpointType type;
+        const char* data;
+        std::size_t count;
+
+        std::size_t bytes() const { return count * checkpoint_detail::element_bytes(type); }
+    };
+
+    const std::vector<Column>& columns() const { return columns_; }
+    std::size_t num_sections() const { return columns_.size(); }
+
+    static constexpr std::uint32_t kVersion = 1;
+
+private:
+    struct Layout {
+        std::vector<CheckpointSection> table;
+        std::vector<checkpoint_detail::Chunk> chunks;
+        std::vector<std::size_t> first_chunk;
+        std::size_t bytes;
+    };
+
+    Layout plan() const {
+        using namespace checkpoint_detail;
+        const std::size_t S = columns_.size();
+        Layout layout;
+        layout.table.resize(S);
+        std::size_t offset = align_up(kHeaderBytes + S * sizeof(CheckpointSection));
+        std::vector<std::size_t> section_bytes(S);
+        for (std::size_t s = 0; s < S; ++s) {
+            const Column& p = columns_[s];
+            CheckpointSection& entry = layout.table[s];
+            std::memset(&entry, 0, sizeof(CheckpointSection));
+            std::memcpy(entry.name, p.name.data(), p.name.size());
+            entry.type = static_cast<std::uint32_t>(p.type);
+            entry.offset = offset;
+            entry.count = p.count;
+            section_bytes[s] = p.bytes();
+            offset = align_up(offset + section_bytes[s]);
+        }
+        plan_chunks(section_bytes, layout.chunks, layout.first_chunk);
+        layout.bytes = offset;
+        return layout;
+    }
+
+    // Everything except the magic, which the caller publishes last
+    void fill(tf::Executor& executor, const Layout& layout, char* base) const {
+        using namespace checkpoint_detail;
+        const std::size_t S = columns_.size();
+        std::vector<CheckpointSection> table = layout.table;
+        std::vector<std::uint64_t> chunk_hashes(layout.chunks.size());
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t{0}, layout.chunks.size(), std::size_t{1}, [&](std::size_t c) {
+            const Chunk& chunk = layout.chunks[c];
+            char* out = base + table[chunk.section].offset + chunk.begin;
+            if (chunk.bytes > 0) std::memcpy(out, columns_[chunk.section].data + chunk.begin, chunk.bytes);
+            chunk_hashes[c] = hash_bytes(out, chunk.bytes, c - layout.first_chunk[chunk.section]);
+        });
+        executor.run(taskflow).wait();
+        for (std::size_t s = 0; s < S; ++s) {
+            table[s].checksum = fold(chunk_hashes.data() + layout.first_chunk[s],
+                                     layout.first_chunk[s + 1] - layout.first_chunk[s]);
+        }
+
+        const std::uint32_t version = kVersion, num_sections = static_cast<std::uint32_t>(S);
+        const std::uint64_t bytes64 = layout.bytes;
+        std::memcpy(base + 8, &version, 4);
+        std::memcpy(base + 12, &num_sections, 4);
+        std::memcpy(base + 16, &bytes64, 8);
+        if (S > 0) std::memcpy(base + kHeaderBytes, table.data(), S * sizeof(CheckpointSection));
+    }
+
+    void add_raw(const std::string& name, CheckpointType type, const void* data, std::size_t count) {
+        if (name.empty() || name.size() >= sizeof(CheckpointSection::name)) {
+            throw std::runtime_error("Checkpoint section name must have 1 to 47 characters: " + name);
+        }
+        if (!names_.emplace(name, columns_.size()).second) {
+            throw std::runtime_error("Duplicate checkpoint section: " + name);
+        }
+        columns_.push_back({name, type, static_cast<const char*>(data), count});
+    }
+
+    std::vector<Column> columns_;
+    std::unordered_map<std::string, std::size_t> names_;
+    std::deque<std::vector<char>> owned_;
+};
+
+/**
+ * CheckpointReader
+ */
+class CheckpointReader {
+public:
+    explicit CheckpointReader(const std::string& path) : path_(path) {
+        using namespace checkpoint_detail;
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open checkpoint file: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || static_cast<std::size_t>(st.st_size) < kHeaderBytes) {
+            ::close(fd_);
+            throw std::runtime_error("Not a checkpoint file: " + path);
+        }
+        bytes_ = static_cast<std::size_t>(st.st_size);
+        void* map = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot mmap checkpoint file: " + path);
+        }
+        base_ = static_cast<const char*>(map);
+        mapped_ = true;
+        try {
+            parse();
+        } catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    // A checkpoint held in memory (CheckpointWriter::image); name is for messages
+    CheckpointReader(std::vector<char> image, std::string name) : path_(std::move(name)), image_(std::move(image)) {
+        if (image_.size() < checkpoint_detail::kHeaderBytes) {
+            throw std::runtime_error("Not a checkpoint image: " + path_);
+        }
+        base_ = image_.data();
+        bytes_ = image_.size();
+        parse();
+    }
+
+    ~CheckpointReader() { close(); }
+
+    CheckpointReader(const CheckpointReader&) = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    bool has(const std::string& name) const { return index_.count(name) != 0; }
+
+    template <class T>
+    CheckpointColumn<T> column(const std::string& name) const {
+        const CheckpointSection& s = section(name);
+        if (s.type != static_cast<std::uint32_t>(CheckpointTypeOf<T>::value)) {
+            throw std::runtime_error("Checkpoint section has another type: " + name);
+        }
+        return {reinterpret_cast<const T*>(base_ + s.offset), static_cast<std::size_t>(s.count)};
+    }
+
+    // column<T>(name), required to hold exactly count values
+    template <class T>
+    CheckpointColumn<T> column(const std::string& name, std::size_t count) const {
+        CheckpointColumn<T> c = column<T>(name);
+        if (c.size != count) {
+            throw std::runtime_error("Checkpoint section has the wrong length: " + name);
+        }
+        return c;
+    }
+
+    // Raw bytes of a section of any type
+    CheckpointColumn<char> raw(const std::string& name) const {
+        const CheckpointSection& s = section(name);
+        return {base_ + s.offset, static_cast<std::size_t>(s.count) *
+                                      checkpoint_detail::element_bytes(static_cast<CheckpointType>(s.type))};
+    }
+
+    const CheckpointSection& section(const std::string& name) const {
+        auto it = index_.find(name);
+        if (it == index_.end()) {
+            throw std::runtime_error("Checkpoint section not found: " + name);
+        }
+        return sections_[it->second];
+    }
+
+    // Recompute every checksum; returns the names of sections that differ
+    std::vector<std::string> verify(tf::Executor& executor) const {
+        using namespace checkpoint_detail;
+        std::vector<std::size_t> section_bytes(sections_.size());
+        for (std::size_t s = 0; s < sections_.size(); ++s) {
+            section_bytes[s] = sections_[s].count * element_bytes(static_cast<CheckpointType>(sections_[s].type));
+        }
+        std::vector<Chunk> chunks;
+        std::vector<std::size_t> first_chunk;
+        plan_chunks(section_bytes, chunks, first_chunk);
+
+        std::vector<std::uint64_t> chunk_hashes(chunks.size());
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t{0}, chunks.size(), std::size_t{1}, [&](std::size_t c) {
+            const Chunk& chunk = chunks[c];
+            chunk_hashes[c] = hash_bytes(base_ + sections_[chunk.section].offset + chunk.begin, chunk.bytes,
+                                         c - first_chunk[chunk.section]);
+        });
+        executor.run(taskflow).wait();
+
+        std::vector<std::string> corrupt;
+        for (std::size_t s = 0; s < sections_.size(); ++s) {
+            if (fold(chunk_hashes.data() + first_chunk[s], first_chunk[s + 1] - first_chunk[s]) != sections_[s].checksum) {
+                corrupt.push_back(sections_[s].name);
+            }
+        }
+        return corrupt;
+    }
+
+    std::uint32_t version() const { return version_; }
+    std::size_t bytes() const { return bytes_; }
+    const char* data() const { return base_; }
+    const std::vector<CheckpointSection>& sections() const { return sections_; }
+    const std::string& path() const { return path_; }
+
+private:
+    void parse() {
+        using namespace checkpoint_detail;
+        if (std::memcmp(base_, kMagic, 8) != 0) {
+            throw std::runtime_error("Not a checkpoint file: " + path_);
+        }
+        std::uint32_t num_sections;
+        std::uint64_t file_bytes;
+        std::memcpy(&version_, base_ + 8, 4);
+        std::memcpy(&num_sections, base_ + 12, 4);
+        std::memcpy(&file_bytes, base_ + 16, 8);
+        if (version_ != CheckpointWriter::kVersion) {
+            throw std::runtime_error("Unsupported checkpoint version: " + std::to_string(version_));
+        }
+        if (file_bytes != bytes_ || kHeaderBytes + num_sections * sizeof(CheckpointSection) > bytes_) {
+            throw std::runtime_error("Truncated checkpoint file: " + path_);
+        }
+        sections_.resize(num_sections);
+        std::memcpy(sections_.data(), base_ + kHeaderBytes, num_sections * sizeof(CheckpointSection));
+        for (std::size_t s = 0; s < sections_.size(); ++s) {
+            CheckpointSection& section = sections_[s];
+            section.name[sizeof(section.name) - 1] = '\0';
+            const std::size_t size = element_bytes(static_cast<CheckpointType>(section.type));
+            if (section.offset % kAlignment != 0 || section.offset > bytes_ || section.count > (bytes_ - section.offset) / size) {
+                throw std::runtime_error("Checkpoint section out of bounds: " + std::string(section.name));
+            }
+            index_.emplace(section.name, s);
+        }
+    }
+
+    void close() {
+        if (base_ && mapped_) {
+            ::munmap(const_cast<char*>(base_), bytes_);
+        }
+        base_ = nullptr;
+        mapped_ = false;
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    std::string path_;
+    int fd_ = -1;
+    const char* base_ = nullptr;
+    bool mapped_ = false;
+    std::vector<char> image_;
+    std::size_t bytes_ = 0;
+    std::uint32_t version_ = 0;
+    std::vector<CheckpointSection> sections_;
+    std::unordered_map<std::string, std::size_t> index_;
+};
+
+} // namespace taskflow_bridge
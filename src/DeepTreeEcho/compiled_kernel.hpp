@@ -0,0 +1,380 @@
+/**
+ * compiled_kernel.hpp
+ *
+ * RhsKernel backed by a shared library that implements the compiled RHS ABI
+ * (compiled_rhs_abi.hpp), typically emitted from a ModelingToolkit system by
+ * NativeRHSExport.jl, and the objectives and operators of
+ * compiled_objective_abi.hpp. Native integrators then call generated code directly,
+ * with parameters held by the kernel instead of boxed Julia closures. Like
+ * every RhsKernel it is autonomous: the exporter rejects systems that use the
+ * independent variable, and the ABI time argument is always 0.
+ */
+
+#pragma once
+
+#include "compiled_objective_abi.hpp"
+#include "compiled_rhs_abi.hpp"
+#include "fitness_service.hpp"
+#include "gradient_service.hpp"
+#include "rhs_kernel.hpp"
+#include "steady_state.hpp"
+#include "symplectic.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <dlfcn.h>
+
+namespace taskflow_bridge {
+
+namespace detail {
+
+/**
+ * CompiledLibrary
+ *
+ * dlopen handle shared by every kernel loaded from it; the library stays
+ * loaded for as long as any of them is alive.
+ */
+class CompiledLibrary {
+public:
+    explicit CompiledLibrary(const std::string& path) : path_(path) {
+        void* handle = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle) {
+            const char* err = ::dlerror();
+            throw std::runtime_error("Cannot load compiled kernel " + path + ": " + (err ? err : "unknown error"));
+        }
+        handle_ = std::shared_ptr<void>(handle, [](void* h) { ::dlclose(h); });
+    }
+
+    template <class Fn>
+    Fn symbol(const char* name) const {
+        void* sym = ::dlsym(handle_.get(), name);
+        if (!sym) {
+            throw std::runtime_error(std::string("Compiled kernel ") + path_ + " lacks " + name);
+        }
+        return reinterpret_cast<Fn>(sym);
+    }
+
+    // Throws unless the entry point `name` returns `expected`
+    void check_version(const char* name, std::int32_t expected) const {
+        using VersionFn = std::int32_t (*)();
+        if (symbol<VersionFn>(name)() != expected) {
+            throw std::runtime_error("Compiled kernel ABI mismatch: " + path_);
+        }
+    }
+
+    const std::shared_ptr<void>& handle() const { return handle_; }
+
+private:
+    std::string path_;
+    std::shared_ptr<void> handle_;
+};
+
+// Parameter count check shared by the compiled kernels
+inline void check_parameter_count(const std::string& name, int expected, std::size_t given) {
+    if (static_cast<int>(given) != expected) {
+        throw std::runtime_error("Compiled kernel " + name + " expects " +
+                                 std::to_string(expected) + " parameters");
+    }
+}
+
+} // namespace detail
+
+/**
+ * CompiledKernel
+ *
+ * The library stays loaded for as long as any kernel references it.
+ */
+class CompiledKernel final : public RhsKernel {
+public:
+    static std::shared_ptr<CompiledKernel> load(const std::string& path, std::vector<double> params) {
+        detail::CompiledLibrary library(path);
+        library.check_version("dte_rhs_abi_version", DTE_COMPILED_RHS_ABI_VERSION);
+
+        Entry entry;
+        entry.eval = library.symbol<dte_rhs_eval_fn>("dte_rhs_eval");
+        entry.eval_dual = library.symbol<dte_rhs_eval_dual_fn>("dte_rhs_eval_dual");
+        entry.jacobian = library.symbol<dte_rhs_jacobian_fn>("dte_rhs_jacobian");
+        const int dim = library.symbol<dte_rhs_dim_fn>("dte_rhs_dim")();
+        const int num_params = library.symbol<dte_rhs_num_params_fn>("dte_rhs_num_params")();
+        const std::string name = library.symbol<dte_rhs_name_fn>("dte_rhs_name")();
+
+        auto kernel = std::shared_ptr<CompiledKernel>(
+            new CompiledKernel(library.handle(), entry, dim, num_params, name));
+        kernel->set_parameters(std::move(params));
+        return kernel;
+    }
+
+    using RhsKernel::eval;
+
+#define DTE_DEFINE_COMPILED_EVAL(Scalar) \
+    void eval(const Scalar* y, Scalar* dy) const override { dispatch(y, dy); }
+    DTE_RHS_KERNEL_SCALARS(DTE_DEFINE_COMPILED_EVAL)
+#undef DTE_DEFINE_COMPILED_EVAL
+
+    // ∂f/∂y, row-major dim × dim
+    void jacobian(const double* y, double* J) const {
+        entry_.jacobian(y, params_.data(), kTime, J);
+    }
+
+    void set_parameters(std::vector<double> params) {
+        detail::check_parameter_count(name(), num_params_, params.size());
+        params_ = std::move(params);
+    }
+
+    int num_params() const { return num_params_; }
+    const std::vector<double>& parameters() const { return params_; }
+
+private:
+    struct Entry {
+        dte_rhs_eval_fn eval = nullptr;
+        dte_rhs_eval_dual_fn eval_dual = nullptr;
+        dte_rhs_jacobian_fn jacobian = nullptr;
+    };
+
+    CompiledKernel(std::shared_ptr<void> library, Entry entry, int dim, int num_params,
+                   const std::string& name)
+        : RhsKernel(dim, name), library_(std::move(library)), entry_(entry),
+          num_params_(num_params) {}
+
+    void dispatch(const double* y, double* dy) const {
+        entry_.eval(y, params_.data(), kTime, dy);
+    }
+
+    // Hyper-duals cross the ABI as blocks of 2^K doubles
+    template <int K>
+    void dispatch(const HyperDual<K>* y, HyperDual<K>* dy) const {
+        const int ok = entry_.eval_dual(K, reinterpret_cast<const double*>(y), params_.data(), kTime,
+                                        reinterpret_cast<double*>(dy));
+        if (!ok) {
+            throw std::runtime_error("Compiled kernel " + name() + " lacks " +
+                                     std::to_string(K) + "-direction duals");
+        }
+    }
+
+    std::shared_ptr<void> library_;
+    Entry entry_;
+    int num_params_;
+    std::vector<double> params_;
+
+    // Generated kernels never read t (see NativeRHSExport.emit_native_rhs)
+    static constexpr double kTime = 0.0;
+};
+
+inline std::shared_ptr<CompiledKernel> load_compiled_kernel(const std::string& path,
+                                                            std::vector<double> params) {
+    return CompiledKernel::load(path, std::move(params));
+}
+
+/**
+ * CompiledFitness
+ *
+ * FitnessKernel over dte_fitness_eval with parameters held by the kernel.
+ */
+class CompiledFitness final : public FitnessKernel {
+public:
+    static std::shared_ptr<CompiledFitness> load(const std::string& path, std::vector<double> params) {
+        detail::CompiledLibrary library(path);
+        library.check_version("dte_fitness_abi_version", DTE_COMPILED_OBJECTIVE_ABI_VERSION);
+
+        const std::string name = library.symbol<dte_objective_name_fn>("dte_fitness_name")();
+        const int num_params = library.symbol<dte_objective_count_fn>("dte_fitness_num_params")();
+        detail::check_parameter_count(name, num_params, params.size());
+        return std::shared_ptr<CompiledFitness>(new CompiledFitness(
+            library.handle(), library.symbol<dte_fitness_eval_fn>("dte_fitness_eval"), name, std::move(params)));
+    }
+
+    double evaluate(const double* genome, int length, const EvaluationBudget& /*budget*/) const override {
+        return eval_(genome, length, params_.data());
+    }
+
+    const std::vector<double>& parameters() const { return params_; }
+
+private:
+    CompiledFitness(std::shared_ptr<void> library, dte_fitness_eval_fn eval, const std::string& name,
+                    std::vector<double> params)
+        : FitnessKernel(name), library_(std::move(library)), eval_(eval), params_(std::move(params)) {}
+
+    std::shared_ptr<void> library_;
+    dte_fitness_eval_fn eval_;
+    std::vector<double> params_;
+};
+
+inline std::shared_ptr<CompiledFitness> load_compiled_fitness(const std::string& path,
+                                                              std::vector<double> params) {
+    return CompiledFitness::load(path, std::move(params));
+}
+
+/**
+ * CompiledOperators
+ *
+ * Steady-state crossover and mutation from a library; selection stays the
+ * default tournament. The operators draw from the ticket's PhiloxStream.
+ */
+class CompiledOperators final : public SteadyStateOperators {
+public:
+    static std::shared_ptr<CompiledOperators> load(const std::string& path, std::vector<double> params,
+                                                   int tournament_size) {
+        detail::CompiledLibrary library(path);
+        library.check_version("dte_operators_abi_version", DTE_COMPILED_OBJECTIVE_ABI_VERSION);
+
+        const std::string name = library.symbol<dte_objective_name_fn>("dte_operators_name")();
+        const int num_params = library.symbol<dte_objective_count_fn>("dte_operators_num_params")();
+        detail::check_parameter_count(name, num_params, params.size());
+        return std::shared_ptr<CompiledOperators>(new CompiledOperators(
+            library.handle(), library.symbol<dte_operators_crossover_fn>("dte_operators_crossover"),
+            library.symbol<dte_operators_mutate_fn>("dte_operators_mutate"), std::move(params), tournament_size));
+    }
+
+    void crossover(const double* a, const double* b, int length, double* child, PhiloxStream& rng) const override {
+        const dte_random random = wrap(rng);
+        crossover_(a, b, length, child, params_.data(), &random);
+    }
+
+    void mutate(double* genome, int length, PhiloxStream& rng) const override {
+        const dte_random random = wrap(rng);
+        mutate_(genome, length, params_.data(), &random);
+    }
+
+private:
+    CompiledOperators(std::shared_ptr<void> library, dte_operators_crossover_fn crossover,
+                      dte_operators_mutate_fn mutate, std::vector<double> params, int tournament_size)
+        : SteadyStateOperators(tournament_size), library_(std::move(library)), crossover_(crossover),
+          mutate_(mutate), params_(std::move(params)) {}
+
+    static dte_random wrap(PhiloxStream& rng) {
+        return {&rng,
+                [](void* state) { return static_cast<PhiloxStream*>(state)->uniform(); },
+                [](void* state) { return static_cast<PhiloxStream*>(state)->normal(); }};
+    }
+
+    std::shared_ptr<void> library_;
+    dte_operators_crossover_fn crossover_;
+    dte_operators_mutate_fn mutate_;
+    std::vector<double> params_;
+};
+
+/**
+ * CompiledHamiltonian
+ *
+ * Hamiltonian over the dte_hamiltonian_* entry points. Gradients come from
+ * the library's own reverse-mode tape, so the scratch space goes unused.
+ */
+class CompiledHamiltonian final : public Hamiltonian {
+public:
+    static std::shared_ptr<CompiledHamiltonian> load(const std::string& path, std::vector<double> params) {
+        detail::CompiledLibrary library(path);
+        library.check_version("dte_hamiltonian_abi_version", DTE_COMPILED_OBJECTIVE_ABI_VERSION);
+
+        const std::string name = library.symbol<dte_objective_name_fn>("dte_hamiltonian_name")();
+        const int dof = library.symbol<dte_objective_count_fn>("dte_hamiltonian_dof")();
+        const int num_params = library.symbol<dte_objective_count_fn>("dte_hamiltonian_num_params")();
+        if (dof <= 0) {
+            throw std::runtime_error("Compiled Hamiltonian " + name + " has no degrees of freedom");
+        }
+        detail::check_parameter_count(name, num_params, params.size());
+
+        const bool separable = library.symbol<dte_objective_count_fn>("dte_hamiltonian_separable")() != 0;
+        auto h = std::shared_ptr<CompiledHamiltonian>(new CompiledHamiltonian(dof, library.handle(),
+                                                                              std::move(params)));
+        h->energy_ = library.symbol<dte_objective_value_fn>("dte_hamiltonian_energy");
+        h->gradient_ = library.symbol<dte_objective_gradient_fn>("dte_hamiltonian_gradient");
+        if (separable) {
+            h->grad_kinetic_ = library.symbol<dte_objective_gradient_fn>("dte_hamiltonian_grad_kinetic");
+            h->grad_potential_ = library.symbol<dte_objective_gradient_fn>("dte_hamiltonian_grad_potential");
+        }
+        return h;
+    }
+
+    double energy(const double* z) const override { return energy_(z, params_.data()); }
+
+    void gradient(const double* z, double* grad, GradientScratch& /*scratch*/) const override {
+        gradient_(z, params_.data(), grad);
+    }
+
+    bool separable() const override { return grad_kinetic_ != nullptr; }
+
+    void grad_potential(const double* q, double* dV_dq, GradientScratch& scratch) const override {
+        if (!grad_potential_) return Hamiltonian::grad_potential(q, dV_dq, scratch);
+        grad_potential_(q, params_.data(), dV_dq);
+    }
+
+    void grad_kinetic(const double* p, double* dT_dp, GradientScratch& scratch) const override {
+        if (!grad_kinetic_) return Hamiltonian::grad_kinetic(p, dT_dp, scratch);
+        grad_kinetic_(p, params_.data(), dT_dp);
+    }
+
+    const std::vector<double>& parameters() const { return params_; }
+
+private:
+    CompiledHamiltonian(int dof, std::shared_ptr<void> library, std::vector<double> params)
+        : Hamiltonian(dof), library_(std::move(library)), params_(std::move(params)) {}
+
+    std::shared_ptr<void> library_;
+    std::vector<double> params_;
+    dte_objective_value_fn energy_ = nullptr;
+    dte_objective_gradient_fn gradient_ = nullptr;
+    dte_objective_gradient_fn grad_kinetic_ = nullptr;
+    dte_objective_gradient_fn grad_potential_ = nullptr;
+};
+
+/**
+ * CompiledLoss
+ *
+ * LossKernel over dte_loss_*. On an adjoint tape the library returns the
+ * whole gradient at once, and the output is recorded as one chain of nodes
+ * L = Σ ∂L/∂c_i · c_i linking it to the inputs.
+ */
+class CompiledLoss final : public LossKernel {
+public:
+    static std::shared_ptr<CompiledLoss> load(const std::string& path, std::vector<double> params) {
+        detail::CompiledLibrary library(path);
+        library.check_version("dte_loss_abi_version", DTE_COMPILED_OBJECTIVE_ABI_VERSION);
+
+        const std::string name = library.symbol<dte_objective_name_fn>("dte_loss_name")();
+        const int dim = library.symbol<dte_objective_count_fn>("dte_loss_dim")();
+        const int num_params = library.symbol<dte_objective_count_fn>("dte_loss_num_params")();
+        if (dim <= 0) {
+            throw std::runtime_error("Compiled loss " + name + " has no coefficients");
+        }
+        detail::check_parameter_count(name, num_params, params.size());
+        return std::shared_ptr<CompiledLoss>(new CompiledLoss(
+            dim, name, library.handle(), library.symbol<dte_objective_value_fn>("dte_loss_eval"),
+            library.symbol<dte_objective_gradient_fn>("dte_loss_gradient"), std::move(params)));
+    }
+
+    double eval(const double* c) const override { return eval_(c, params_.data()); }
+
+    AdjointVar eval(const AdjointVar* c) const override {
+        const int n = dim();
+        thread_local std::vector<double> values;
+        thread_local std::vector<double> grad;
+        values.resize(n);
+        grad.resize(n);
+        for (int i = 0; i < n; ++i) values[i] = c[i].value;
+        const double value = gradient_(values.data(), params_.data(), grad.data());
+
+        std::int32_t id = -1;
+        for (int i = 0; i < n; ++i) id = AdjointVar::record(id, 1.0, c[i].id, grad[i]);
+        return {value, id};
+    }
+
+    const std::vector<double>& parameters() const { return params_; }
+
+private:
+    CompiledLoss(int dim, const std::string& name, std::shared_ptr<void> library, dte_objective_value_fn eval,
+                 dte_objective_gradient_fn gradient, std::vector<double> params)
+        : LossKernel(dim, name), library_(std::move(library)), eval_(eval), gradient_(gradient),
+          params_(std::move(params)) {}
+
+    std::shared_ptr<void> library_;
+    dte_objective_value_fn eval_;
+    dte_objective_gradient_fn gradient_;
+    std::vector<double> params_;
+};
+
+} // namespace taskflow_bridge
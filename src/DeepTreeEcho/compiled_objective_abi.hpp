@@ -0,0 +1,247 @@
+/**
+ * compiled_objective_abi.hpp
+ *
+ * Stable C ABI for objectives and evolution operators compiled ahead of
+ * time, so that the engines of the Taskflow bridge that take C++ functors can
+ * be fed from Julia: write them as a translation unit, build it with
+ * `-shared -fPIC -fvisibility=hidden -I<this directory>` and load it with
+ * TaskflowBridge::load_compiled_*.
+ *
+ * Each kind has its own entry points, so one library may export a right-hand
+ * side (compiled_rhs_abi.hpp) and any of the kinds below.
+ *
+ * Fitness, DTE_EXPORT_COMPILED_FITNESS(name, num_params, fitness) with
+ *
+ *     double fitness(const double* genome, int length, const double* p);
+ *
+ *     int32_t     dte_fitness_abi_version();
+ *     const char* dte_fitness_name();
+ *     int32_t     dte_fitness_num_params();
+ *     double      dte_fitness_eval(const double* genome, int32_t length, const double* p);
+ *
+ * Fitness must be safe to call concurrently. Compiled fitness cannot poll the
+ * evaluation budget; a late result is still replaced by the service penalty.
+ *
+ * Steady-state operators, DTE_EXPORT_COMPILED_OPERATORS(name, num_params,
+ * crossover, mutate) with
+ *
+ *     void crossover(const double* a, const double* b, int length, double* child,
+ *                    const double* p, const dte_random* rng);
+ *     void mutate(double* genome, int length, const double* p, const dte_random* rng);
+ *
+ *     int32_t     dte_operators_abi_version();
+ *     const char* dte_operators_name();
+ *     int32_t     dte_operators_num_params();
+ *     void        dte_operators_crossover(...);   // as above
+ *     void        dte_operators_mutate(...);
+ *
+ * Randomness must come from rng (the engine's Philox stream for the ticket),
+ * which keeps runs reproducible. Operators must be safe to call concurrently.
+ *
+ * Hamiltonians on z = (q, p), DTE_EXPORT_COMPILED_HAMILTONIAN(name, dof,
+ * num_params, hamiltonian) or, for H = T(p) + V(q),
+ * DTE_EXPORT_COMPILED_SEPARABLE_HAMILTONIAN(name, dof, num_params, kinetic,
+ * potential) with generic functions
+ *
+ *     template <class S> S hamiltonian(const S* z, const double* params);
+ *     template <class S> S kinetic(const S* p, const double* params);
+ *     template <class S> S potential(const S* q, const double* params);
+ *
+ *     int32_t     dte_hamiltonian_abi_version();
+ *     const char* dte_hamiltonian_name();
+ *     int32_t     dte_hamiltonian_dof();
+ *     int32_t     dte_hamiltonian_num_params();
+ *     int32_t     dte_hamiltonian_separable();
+ *     double      dte_hamiltonian_energy(const double* z, const double* params);
+ *     double      dte_hamiltonian_gradient(const double* z, const double* params,
+ *                                          double* grad);     // returns H(z)
+ *     double      dte_hamiltonian_grad_kinetic(...);          // separable only
+ *     double      dte_hamiltonian_grad_potential(...);
+ *
+ * Losses over dim coefficients, DTE_EXPORT_COMPILED_LOSS(name, dim,
+ * num_params, loss) with
+ *
+ *     template <class S> S loss(const S* c, const double* params);
+ *
+ *     int32_t     dte_loss_abi_version();
+ *     const char* dte_loss_name();
+ *     int32_t     dte_loss_dim();
+ *     int32_t     dte_loss_num_params();
+ *     double      dte_loss_eval(const double* c, const double* params);
+ *     double      dte_loss_gradient(const double* c, const double* params,
+ *                                   double* grad);             // returns L(c)
+ *
+ * Gradients of Hamiltonians and losses are taken in the library with the
+ * reverse-mode tape of adjoint.hpp, so S is double or AdjointVar.
+ */
+
+#pragma once
+
+#include "adjoint.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#define DTE_COMPILED_OBJECTIVE_ABI_VERSION 1
+
+extern "C" {
+typedef std::int32_t (*dte_objective_abi_version_fn)();
+typedef const char* (*dte_objective_name_fn)();
+typedef std::int32_t (*dte_objective_count_fn)();
+typedef double (*dte_fitness_eval_fn)(const double*, std::int32_t, const double*);
+
+// Random source handed to compiled operators
+typedef struct dte_random {
+    void* state;
+    double (*uniform)(void* state);   // [0, 1)
+    double (*normal)(void* state);    // N(0, 1)
+} dte_random;
+
+typedef void (*dte_operators_crossover_fn)(const double*, const double*, std::int32_t, double*,
+                                           const double*, const dte_random*);
+typedef void (*dte_operators_mutate_fn)(double*, std::int32_t, const double*, const dte_random*);
+
+typedef double (*dte_objective_value_fn)(const double*, const double*);
+typedef double (*dte_objective_gradient_fn)(const double*, const double*, double*);
+}
+
+namespace taskflow_bridge {
+namespace compiled {
+
+// ∇f(x) by one recorded evaluation and one backward sweep; returns f(x)
+template <class F>
+double adjoint_gradient(const F& f, const double* x, int n, double* grad) {
+    thread_local AdjointTape tape;
+    thread_local std::vector<AdjointVar> inputs;
+    AdjointTapeScope scope(tape);
+    tape.clear();
+    inputs.resize(n);
+    for (int i = 0; i < n; ++i) inputs[i] = AdjointVar(x[i], tape.variable());
+    const AdjointVar out = f(inputs.data());
+    tape.backpropagate(out.id);
+    for (int i = 0; i < n; ++i) grad[i] = tape.adjoint(inputs[i].id);
+    return out.value;
+}
+
+} // namespace compiled
+} // namespace taskflow_bridge
+
+#define DTE_EXPORT_COMPILED_FITNESS(NAME, NUM_PARAMS, FITNESS)                     \
+    extern "C" {                                                                  \
+    __attribute__((visibility("default"))) std::int32_t dte_fitness_abi_version() { \
+        return DTE_COMPILED_OBJECTIVE_ABI_VERSION;                                \
+    }                                                                             \
+    __attribute__((visibility("default"))) const char* dte_fitness_name() {      \
+        return NAME;                                                              \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_fitness_num_params() { \
+        return NUM_PARAMS;                                                        \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_fitness_eval(               \
+            const double* genome, std::int32_t length, const double* p) {         \
+        return FITNESS(genome, length, p);                                        \
+    }                                                                             \
+    }
+
+#define DTE_EXPORT_COMPILED_OPERATORS(NAME, NUM_PARAMS, CROSSOVER, MUTATE)           \
+    extern "C" {                                                                  \
+    __attribute__((visibility("default"))) std::int32_t dte_operators_abi_version() { \
+        return DTE_COMPILED_OBJECTIVE_ABI_VERSION;                                \
+    }                                                                             \
+    __attribute__((visibility("default"))) const char* dte_operators_name() {    \
+        return NAME;                                                              \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_operators_num_params() { \
+        return NUM_PARAMS;                                                        \
+    }                                                                             \
+    __attribute__((visibility("default"))) void dte_operators_crossover(          \
+            const double* a, const double* b, std::int32_t length, double* child, \
+            const double* p, const dte_random* rng) {                             \
+        CROSSOVER(a, b, length, child, p, rng);                                   \
+    }                                                                             \
+    __attribute__((visibility("default"))) void dte_operators_mutate(             \
+            double* genome, std::int32_t length, const double* p,                 \
+            const dte_random* rng) {                                              \
+        MUTATE(genome, length, p, rng);                                           \
+    }                                                                             \
+    }
+
+#define DTE_COMPILED_HAMILTONIAN_HEADER(NAME, DOF, NUM_PARAMS, SEPARABLE)          \
+    __attribute__((visibility("default"))) std::int32_t dte_hamiltonian_abi_version() { \
+        return DTE_COMPILED_OBJECTIVE_ABI_VERSION;                                \
+    }                                                                             \
+    __attribute__((visibility("default"))) const char* dte_hamiltonian_name() {  \
+        return NAME;                                                              \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_hamiltonian_dof() {   \
+        return DOF;                                                               \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_hamiltonian_num_params() { \
+        return NUM_PARAMS;                                                        \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_hamiltonian_separable() { \
+        return SEPARABLE;                                                         \
+    }
+
+#define DTE_EXPORT_COMPILED_HAMILTONIAN(NAME, DOF, NUM_PARAMS, HAMILTONIAN)         \
+    extern "C" {                                                                  \
+    DTE_COMPILED_HAMILTONIAN_HEADER(NAME, DOF, NUM_PARAMS, 0)                     \
+    __attribute__((visibility("default"))) double dte_hamiltonian_energy(         \
+            const double* z, const double* params) {                              \
+        return HAMILTONIAN(z, params);                                            \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_hamiltonian_gradient(       \
+            const double* z, const double* params, double* grad) {                \
+        return ::taskflow_bridge::compiled::adjoint_gradient(                     \
+            [params](const auto* x) { return HAMILTONIAN(x, params); }, z, 2 * (DOF), grad); \
+    }                                                                             \
+    }
+
+#define DTE_EXPORT_COMPILED_SEPARABLE_HAMILTONIAN(NAME, DOF, NUM_PARAMS, KINETIC, POTENTIAL) \
+    extern "C" {                                                                  \
+    DTE_COMPILED_HAMILTONIAN_HEADER(NAME, DOF, NUM_PARAMS, 1)                     \
+    __attribute__((visibility("default"))) double dte_hamiltonian_energy(         \
+            const double* z, const double* params) {                              \
+        return KINETIC(z + (DOF), params) + POTENTIAL(z, params);                 \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_hamiltonian_grad_kinetic(   \
+            const double* p, const double* params, double* grad) {                \
+        return ::taskflow_bridge::compiled::adjoint_gradient(                     \
+            [params](const auto* x) { return KINETIC(x, params); }, p, DOF, grad); \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_hamiltonian_grad_potential( \
+            const double* q, const double* params, double* grad) {                \
+        return ::taskflow_bridge::compiled::adjoint_gradient(                     \
+            [params](const auto* x) { return POTENTIAL(x, params); }, q, DOF, grad); \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_hamiltonian_gradient(       \
+            const double* z, const double* params, double* grad) {                \
+        return dte_hamiltonian_grad_potential(z, params, grad) +                  \
+               dte_hamiltonian_grad_kinetic(z + (DOF), params, grad + (DOF));     \
+    }                                                                             \
+    }
+
+#define DTE_EXPORT_COMPILED_LOSS(NAME, DIM, NUM_PARAMS, LOSS)                      \
+    extern "C" {                                                                  \
+    __attribute__((visibility("default"))) std::int32_t dte_loss_abi_version() {  \
+        return DTE_COMPILED_OBJECTIVE_ABI_VERSION;                                \
+    }                                                                             \
+    __attribute__((visibility("default"))) const char* dte_loss_name() {         \
+        return NAME;                                                              \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_loss_dim() {          \
+        return DIM;                                                               \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_loss_num_params() {   \
+        return NUM_PARAMS;                                                        \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_loss_eval(                  \
+            const double* c, const double* params) {                              \
+        return LOSS(c, params);                                                   \
+    }                                                                             \
+    __attribute__((visibility("default"))) double dte_loss_gradient(              \
+            const double* c, const double* params, double* grad) {                \
+        return ::taskflow_bridge::compiled::adjoint_gradient(                     \
+            [params](const auto* x) { return LOSS(x, params); }, c, DIM, grad);   \
+    }                                                                             \
+    }
@@ -0,0 +1,58 @@
+// Objective fixture for the Taskflow bridge self-test: objectives and operators written
+// against compiled_objective_abi.hpp, the way a Julia caller would compile them
+// before handing the library to TaskflowBridge::load_compiled_*.
+
+#include "compiled_objective_abi.hpp"
+
+#include <cmath>
+
+namespace {
+
+// -p[0] · |g|², higher is better
+double fitness(const double* genome, int length, const double* p) {
+    double s = 0.0;
+    for (int k = 0; k < length; ++k) s += genome[k] * genome[k];
+    return -p[0] * s;
+}
+
+// Blend with a random weight per child
+void crossover(const double* a, const double* b, int length, double* child, const double*, const dte_random* rng) {
+    const double w = rng->uniform(rng->state);
+    for (int k = 0; k < length; ++k) child[k] = w * a[k] + (1.0 - w) * b[k];
+}
+
+// Additive Gaussian step of size p[0]
+void mutate(double* genome, int length, const double* p, const dte_random* rng) {
+    for (int k = 0; k < length; ++k) genome[k] += p[0] * rng->normal(rng->state);
+}
+
+// Pendulum H = p²/2 - p[0] cos q
+template <class S>
+S kinetic(const S* p, const double*) {
+    return 0.5 * p[0] * p[0];
+}
+
+template <class S>
+S potential(const S* q, const double* params) {
+    using std::cos;
+    return -params[0] * cos(q[0]);
+}
+
+// Rosenbrock Σ p[0] (c_{i+1} - c_i²)² + (1 - c_i)² over 4 coefficients
+template <class S>
+S loss(const S* c, const double* params) {
+    S acc(0.0);
+    for (int i = 0; i < 3; ++i) {
+        const S a = c[i + 1] - c[i] * c[i];
+        const S b = 1.0 - c[i];
+        acc += params[0] * a * a + b * b;
+    }
+    return acc;
+}
+
+} // namespace
+
+DTE_EXPORT_COMPILED_FITNESS("scaled_norm", 1, fitness)
+DTE_EXPORT_COMPILED_OPERATORS("blend_gaussian", 1, crossover, mutate)
+DTE_EXPORT_COMPILED_SEPARABLE_HAMILTONIAN("pendulum", 1, 1, kinetic, potential)
+DTE_EXPORT_COMPILED_LOSS("rosenbrock", 4, 1, loss)
@@ -0,0 +1,136 @@
+/**
+ * compiled_rhs_abi.hpp
+ *
+ * Stable C ABI for right-hand sides compiled ahead of time from
+ * ModelingToolkit systems (see NativeRHSExport.jl).
+ *
+ * A generated translation unit defines
+ *
+ *     template <class S>
+ *     void rhs(const S* y, const double* p, double t, S* dy);
+ *     void jacobian(const double* y, const double* p, double t, double* J);
+ *
+ * and invokes DTE_EXPORT_COMPILED_RHS, which emits the extern "C" entry
+ * points below. Hyper-dual arguments cross the ABI as plain double blocks:
+ * component s of y[i] with K directions lives at y[i · 2^K + s], exactly the
+ * memory layout of HyperDual<K>. The shared library therefore needs nothing
+ * from the host beyond this header and hyper_dual.hpp.
+ *
+ * The exporter only emits autonomous systems; t is reserved in the ABI and
+ * CompiledKernel always passes 0.
+ *
+ *     int32_t     dte_rhs_abi_version();
+ *     const char* dte_rhs_name();
+ *     int32_t     dte_rhs_dim();
+ *     int32_t     dte_rhs_num_params();
+ *     void        dte_rhs_eval(const double* y, const double* p, double t, double* dy);
+ *     int32_t     dte_rhs_eval_dual(int32_t K, const double* y, const double* p,
+ *                                   double t, double* dy);   // 0 if K unsupported
+ *     void        dte_rhs_jacobian(const double* y, const double* p, double t,
+ *                                  double* J);             // row-major n × n
+ */
+
+#pragma once
+
+#include "hyper_dual.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#define DTE_COMPILED_RHS_ABI_VERSION 1
+
+extern "C" {
+typedef std::int32_t (*dte_rhs_abi_version_fn)();
+typedef const char* (*dte_rhs_name_fn)();
+typedef std::int32_t (*dte_rhs_dim_fn)();
+typedef std::int32_t (*dte_rhs_num_params_fn)();
+typedef void (*dte_rhs_eval_fn)(const double*, const double*, double, double*);
+typedef std::int32_t (*dte_rhs_eval_dual_fn)(std::int32_t, const double*, const double*, double, double*);
+typedef void (*dte_rhs_jacobian_fn)(const double*, const double*, double, double*);
+}
+
+namespace taskflow_bridge {
+namespace compiled {
+
+// Helpers used by generated code; branching follows the real part
+
+inline double value(double x) { return x; }
+
+template <int K, class T>
+T value(const HyperDual<K, T>& x) { return x.value(); }
+
+inline double abs(double x) { return std::abs(x); }
+
+template <int K, class T>
+HyperDual<K, T> abs(const HyperDual<K, T>& x) { return x.value() < T(0) ? -x : x; }
+
+template <class S>
+S ipow(S x, int n) {
+    S r(1.0);
+    while (n > 0) {
+        if (n & 1) r = r * x;
+        x = x * x;
+        n >>= 1;
+    }
+    return r;
+}
+
+template <int K>
+HyperDual<K>* as_dual(double* x) {
+    static_assert(sizeof(HyperDual<K>) == sizeof(double) << K, "HyperDual must be a plain double block");
+    return reinterpret_cast<HyperDual<K>*>(x);
+}
+
+template <int K>
+const HyperDual<K>* as_dual(const double* x) {
+    return reinterpret_cast<const HyperDual<K>*>(x);
+}
+
+} // namespace compiled
+} // namespace taskflow_bridge
+
+#define DTE_COMPILED_RHS_DUAL_CASE(K, RHS)                                        \
+    case K:                                                                       \
+        RHS(::taskflow_bridge::compiled::as_dual<K>(y), p, t,                     \
+            ::taskflow_bridge::compiled::as_dual<K>(dy));                         \
+        return 1;
+
+#define DTE_EXPORT_COMPILED_RHS(NAME, DIM, NUM_PARAMS, RHS, JACOBIAN)              \
+    extern "C" {                                                                  \
+    __attribute__((visibility("default"))) std::int32_t dte_rhs_abi_version() {   \
+        return DTE_COMPILED_RHS_ABI_VERSION;                                      \
+    }                                                                             \
+    __attribute__((visibility("default"))) const char* dte_rhs_name() {          \
+        return NAME;                                                              \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_rhs_dim() {           \
+        return DIM;                                                               \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_rhs_num_params() {    \
+        return NUM_PARAMS;                                                        \
+    }                                                                             \
+    __attribute__((visibility("default"))) void dte_rhs_eval(                     \
+            const double* y, const double* p, double t, double* dy) {             \
+        RHS(y, p, t, dy);                                                         \
+    }                                                                             \
+    __attribute__((visibility("default"))) std::int32_t dte_rhs_eval_dual(        \
+            std::int32_t K, const double* y, const double* p, double t,           \
+            double* dy) {                                                         \
+        switch (K) {                                                              \
+            DTE_COMPILED_RHS_DUAL_CASE(1, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(2, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(3, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(4, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(5, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(6, RHS)                                    \
+            DTE_COMPILED_RHS_DUAL_CASE(7, RHS)                                    \
+        default:                                                                  \
+            return 0;                                                             \
+        }                                                                         \
+    }                                                                             \
+    __attribute__((visibility("default"))) void dte_rhs_jacobian(                 \
+            const double* y, const double* p, double t, double* J) {              \
+        JACOBIAN(y, p, t, J);                                                     \
+    }                                                                             \
+    }
@@ -0,0 +1,44 @@
+// Generated by DeepTreeEcho.NativeRHSExport from chua; do not edit.
+//
+//   y[0] = x(t)
+//   y[1] = y(t)
+//   y[2] = z(t)
+//   p[0] = alpha
+//   p[1] = beta
+//   p[2] = m0
+//   p[3] = m1
+
+#include "compiled_rhs_abi.hpp"
+
+namespace {
+
+using namespace taskflow_bridge;
+
+template <class S>
+void rhs(const S* y, const double* p, double t, S* dy) {
+    using std::sin; using std::cos; using std::exp; using std::log;
+    using std::sqrt; using std::tanh; using std::pow;
+    (void)y; (void)p; (void)t;
+    const S o0 = S(((compiled::value(y[0]) < compiled::value((-1.0))) ? S(((p[3] * (y[0] + 1.0)) + (-1.0 * p[2]))) : S(((compiled::value(y[0]) > compiled::value(1.0)) ? S(((p[3] * (y[0] + (-1.0))) + p[2])) : S((p[2] * y[0]))))));
+    dy[0] = S((p[0] * (y[1] + (-1.0 * y[0]) + (-1.0 * o0))));
+    dy[1] = S((y[0] + (-1.0 * y[1]) + y[2]));
+    dy[2] = S(((-1.0) * p[1] * y[1]));
+}
+
+void jacobian(const double* y, const double* p, double t, double* J) {
+    using S = double;
+    using std::sin; using std::cos; using std::exp; using std::log;
+    using std::sqrt; using std::tanh; using std::pow;
+    (void)y; (void)p; (void)t;
+    for (int k = 0; k < 9; ++k) J[k] = 0.0;
+    J[0] = (p[0] * ((-1.0) + (-1.0 * ((compiled::value(y[0]) < compiled::value((-1.0))) ? S(p[3]) : S(((compiled::value(y[0]) > compiled::value(1.0)) ? S(p[3]) : S(p[2])))))));
+    J[1] = p[0];
+    J[3] = 1.0;
+    J[4] = (-1.0);
+    J[5] = 1.0;
+    J[7] = ((-1.0) * p[1]);
+}
+
+} // namespace
+
+DTE_EXPORT_COMPILED_RHS("chua", 3, 4, rhs, jacobian)
@@ -0,0 +1,521 @@
+/**
+ * delta_checkpoint.hpp
+ *
+ * Incremental checkpoints: one full base plus a chain of deltas.
+ *
+ * A delta stores only the blocks (block_bytes each) of every section that
+ * changed since the previous checkpoint in the chain. Change detection
+ * compares per-block hashes of the live columns with the hashes remembered
+ * from the last write, so the objects need no write tracking. Hashing is
+ * one parallel pass over memory; only dirty blocks reach the disk. A
+ * section that is new, changes type, or is more than half dirty is stored
+ * whole.
+ *
+ * Files (every one written to a temporary name and renamed into place):
+ *
+ *     path            base, or the latest compaction; "chain.meta" holds
+ *                     [tag, last delta folded in, block bytes]
+ *     path.delta.N    delta N, with the same container layout:
+ *                       chain.meta    [tag, N, block bytes]
+ *                       delta.names   NUL-separated section names, in order
+ *                       delta.shape   (type, count, mode) per name
+ *                       d<k>          section k whole            (mode 1)
+ *                       d<k>.blocks   dirty block indices        (mode 2)
+ *                       d<k>.data     those blocks, concatenated (mode 2)
+ *                     mode 0 keeps section k unchanged.
+ *
+ * replay() starts at the base and applies deltas from the one after the
+ * last folded in, stopping at the first one that is missing or belongs to
+ * another chain. Without deltas it returns the base mapping itself.
+ * Otherwise it returns an in-memory image. Compaction is a replay whose
+ * image is written over the base. It runs on a background thread while new
+ * deltas keep arriving, then deletes the deltas it folded in. A replay that
+ * overlaps a compaction notices the base change and starts again.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace taskflow_bridge {
+
+/**
+ * DeltaCheckpointer
+ */
+class DeltaCheckpointer {
+public:
+    static constexpr std::size_t kDefaultBlockBytes = std::size_t{1} << 16;
+
+    // max_deltas > 0 starts a background compaction once that many deltas follow the base
+    explicit DeltaCheckpointer(std::string path, std::size_t block_bytes = kDefaultBlockBytes, int max_deltas = 0)
+        : path_(std::move(path)), block_bytes_(block_bytes), max_deltas_(max_deltas) {
+        if (block_bytes < 64 || block_bytes % 8 != 0) {
+            throw std::runtime_error("Delta block size must be a multiple of 8 bytes, at least 64");
+        }
+    }
+
+    ~DeltaCheckpointer() {
+        try {
+            wait();
+        } catch (...) {
+        }
+    }
+
+    DeltaCheckpointer(const DeltaCheckpointer&) = delete;
+    DeltaCheckpointer& operator=(const DeltaCheckpointer&) = delete;
+
+    /**
+     * Full snapshot of writer's sections. Starts a new chain: deltas of the
+     * old one are deleted. Returns the bytes written.
+     */
+    std::size_t write_base(tf::Executor& executor, CheckpointWriter& writer) {
+        wait();
+        // Deltas of the old chain start after the last one folded into its base
+        std::uint64_t first_stale = compacted_through_.load() + 1;
+        if (tag_ == 0) first_stale = folded_through(path_) + 1;
+        std::uint64_t tag = 0;
+        while (tag == 0) {
+            tag = std::random_device{}() ^ (static_cast<std::uint64_t>(std::random_device{}()) << 32) ^
+                  static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        }
+        writer.add_values<std::int64_t>("chain.meta", {static_cast<std::int64_t>(tag), 0,
+                                                       static_cast<std::int64_t>(block_bytes_)});
+        const std::size_t bytes = writer.write(executor, path_);
+        for (std::uint64_t n = first_stale; n <= sequence_; ++n) ::unlink(delta_path(path_, n).c_str());
+        for (std::uint64_t n = std::max(first_stale, sequence_ + 1); ::unlink(delta_path(path_, n).c_str()) == 0; ++n) {
+        }
+
+        std::vector<std::vector<std::uint64_t>> hashes;
+        hash_blocks(executor, writer.columns(), hashes);
+        remember(writer.columns(), hashes);
+        tag_ = tag;
+        sequence_ = 0;
+        compacted_through_ = 0;
+        ++bases_;
+        return bytes;
+    }
+
+    /**
+     * Delta from the last checkpoint of the chain to writer's sections.
+     * Returns the bytes written.
+     */
+    std::size_t write_delta(tf::Executor& executor, const CheckpointWriter& writer) {
+        using namespace checkpoint_detail;
+        if (tag_ == 0) {
+            throw std::runtime_error("Delta checkpoint needs a base: " + path_);
+        }
+        const auto& columns = writer.columns();
+        std::vector<std::vector<std::uint64_t>> hashes;
+        hash_blocks(executor, columns, hashes);
+
+        const std::uint64_t sequence = sequence_ + 1;
+        CheckpointWriter delta;
+        delta.add_values<std::int64_t>("chain.meta", {static_cast<std::int64_t>(tag_), static_cast<std::int64_t>(sequence),
+                                                      static_cast<std::int64_t>(block_bytes_)});
+        std::vector<char> names;
+        std::vector<std::int64_t> shape;
+        struct Copy {
+            std::size_t column;
+            std::size_t block;
+            char* out;
+        };
+        std::vector<Copy> copies;
+        std::vector<std::vector<char>> block_data(columns.size());
+        std::size_t dirty_blocks = 0;
+
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            const CheckpointWriter::Column& c = columns[k];
+            names.insert(names.end(), c.name.begin(), c.name.end());
+            names.push_back('\0');
+            const std::string key = "d" + std::to_string(k);
+            const std::size_t bytes = c.bytes();
+
+            std::vector<std::uint64_t> dirty;
+            auto prev = state_.find(c.name);
+            const bool comparable = prev != state_.end() && prev->second.type == c.type;
+            if (comparable) {
+                const std::size_t prev_bytes = prev->second.bytes;
+                for (std::size_t b = 0; b < hashes[k].size(); ++b) {
+                    const std::size_t begin = b * block_bytes_;
+                    const bool same_length = begin < prev_bytes &&
+                        std::min(block_bytes_, prev_bytes - begin) == std::min(block_bytes_, bytes - begin);
+                    if (!same_length || b >= prev->second.hashes.size() || prev->second.hashes[b] != hashes[k][b]) {
+                        dirty.push_back(b);
+                    }
+                }
+            }
+
+            int mode;
+            if (comparable && dirty.empty() && bytes == prev->second.bytes) {
+                mode = 0;
+            } else if (!comparable || 2 * dirty.size() * block_bytes_ > bytes) {
+                mode = 1;
+                delta.add(key, c.type, c.data, c.count);
+                dirty_blocks += hashes[k].size();
+            } else {
+                mode = 2;
+                std::vector<char>& data = block_data[k];
+                std::size_t size = 0;
+                for (std::uint64_t b : dirty) size += std::min(block_bytes_, bytes - b * block_bytes_);
+                data.resize(size);
+                std::size_t offset = 0;
+                for (std::uint64_t b : dirty) {
+                    copies.push_back({k, b, data.data() + offset});
+                    offset += std::min(block_bytes_, bytes - b * block_bytes_);
+                }
+                delta.add_values<std::uint64_t>(key + ".blocks", dirty);
+                dirty_blocks += dirty.size();
+            }
+            shape.insert(shape.end(), {static_cast<std::int64_t>(c.type), static_cast<std::int64_t>(c.count), mode});
+        }
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t{0}, copies.size(), std::size_t{1}, [&](std::size_t i) {
+            const Copy& copy = copies[i];
+            const CheckpointWriter::Column& c = columns[copy.column];
+            const std::size_t begin = copy.block * block_bytes_;
+            std::memcpy(copy.out, c.data + begin, std::min(block_bytes_, c.bytes() - begin));
+        });
+        executor.run(taskflow).wait();
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            if (shape[3 * k + 2] == 2) {
+                delta.add_bytes("d" + std::to_string(k) + ".data", CheckpointType::UInt8, std::move(block_data[k]));
+            }
+        }
+        delta.add_bytes("delta.names", CheckpointType::UInt8, std::move(names));
+        delta.add_values<std::int64_t>("delta.shape", std::move(shape));
+
+        const std::size_t bytes = delta.write(executor, delta_path(path_, sequence));
+        remember(columns, hashes);
+        sequence_ = sequence;
+        ++deltas_;
+        delta_bytes_ += bytes;
+        last_dirty_blocks_ = dirty_blocks;
+
+        if (max_deltas_ > 0 && !compacting() && sequence - compacted_through_.load() >= static_cast<std::uint64_t>(max_deltas_)) {
+            compact_async();
+        }
+        return bytes;
+    }
+
+    // Fold the current deltas into the base on a background thread; no-op while one runs
+    void compact_async() {
+        if (compacting()) return;
+        if (compactor_.joinable()) compactor_.join();
+        compacting_ = true;
+        const std::string path = path_;
+        compactor_ = std::thread([this, path] {
+            try {
+                tf::Executor executor(1);
+                std::unique_ptr<CheckpointReader> image = replay(executor, path, false);
+                const std::uint64_t through = static_cast<std::uint64_t>(image->column<std::int64_t>("chain.meta", 3)[1]);
+                const std::uint64_t from = compacted_through_.load();
+                if (through > from) {
+                    write_file(path, image->data(), image->bytes());
+                    for (std::uint64_t n = from + 1; n <= through; ++n) ::unlink(delta_path(path, n).c_str());
+                    compacted_through_ = through;
+                    ++compactions_;
+                }
+            } catch (...) {
+                error_ = std::current_exception();
+            }
+            compacting_ = false;
+        });
+    }
+
+    // Waits for a running compaction and rethrows its error
+    void wait() {
+        if (compactor_.joinable()) compactor_.join();
+        if (error_) {
+            std::exception_ptr error = error_;
+            error_ = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * Base plus every delta of its chain. With verify, each file's
+     * checksums are checked before it is applied.
+     *
+     * A compaction (in this process or another) may rename a new base into
+     * place and delete the deltas it folded in while the chain is read. It
+     * renames before it deletes, so a replay that saw a delta vanish also
+     * sees the base change; it is then started again on the new base.
+     */
+    static std::unique_ptr<CheckpointReader> replay(tf::Executor& executor, const std::string& path, bool verify) {
+        constexpr int kMaxAttempts = 8;
+        for (int attempt = 1;; ++attempt) {
+            const FileIdentity before = identity(path);
+            try {
+                std::unique_ptr<CheckpointReader> image = replay_chain(executor, path, verify);
+                if (identity(path) == before) return image;
+            } catch (const std::runtime_error&) {
+                if (identity(path) == before || attempt == kMaxAttempts) throw;
+            }
+            if (attempt == kMaxAttempts) {
+                throw std::runtime_error("Checkpoint chain kept changing during replay: " + path);
+            }
+        }
+    }
+
+    static std::string delta_path(const std::string& path, std::uint64_t sequence) {
+        return path + ".delta." + std::to_string(sequence);
+    }
+
+    // Accessors
+
+    const std::string& path() const { return path_; }
+    std::size_t block_bytes() const { return block_bytes_; }
+    std::uint64_t sequence() const { return sequence_; }
+    std::uint64_t bases() const { return bases_; }
+    std::uint64_t deltas() const { return deltas_; }
+    std::uint64_t delta_bytes() const { return delta_bytes_; }
+    std::size_t last_dirty_blocks() const { return last_dirty_blocks_; }
+    std::uint64_t compactions() const { return compactions_.load(); }
+    bool compacting() const { return compacting_.load(); }
+
+private:
+    struct Section {
+        std::string name;
+        CheckpointType type;
+        std::size_t count;
+        std::vector<char> bytes;
+    };
+
+    struct SectionState {
+        CheckpointType type;
+        std::size_t bytes;
+        std::vector<std::uint64_t> hashes;
+    };
+
+    // Which file a path names; a renamed-in base has another inode and mtime
+    struct FileIdentity {
+        dev_t device = 0;
+        ino_t inode = 0;
+        std::int64_t modified_ns = -1;
+
+        bool operator==(const FileIdentity& o) const {
+            return device == o.device && inode == o.inode && modified_ns == o.modified_ns;
+        }
+    };
+
+    static FileIdentity identity(const std::string& path) {
+        struct stat st;
+        if (::stat(path.c_str(), &st) != 0) return {};
+        return {st.st_dev, st.st_ino, static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec};
+    }
+
+    // One pass over the chain as it is on disk
+    static std::unique_ptr<CheckpointReader> replay_chain(tf::Executor& executor, const std::string& path, bool verify) {
+        auto base = std::make_unique<CheckpointReader>(path);
+        check(executor, *base, verify);
+        if (!base->has("chain.meta")) return base;
+        const auto meta = base->column<std::int64_t>("chain.meta", 3);
+        const std::int64_t tag = meta[0];
+        const std::size_t block_bytes = static_cast<std::size_t>(meta[2]);
+        std::uint64_t sequence = static_cast<std::uint64_t>(meta[1]) + 1;
+        if (!exists(delta_path(path, sequence))) return base;
+
+        // Working state in section order, starting from the base
+        std::vector<Section> sections;
+        for (const CheckpointSection& s : base->sections()) {
+            if (std::strcmp(s.name, "chain.meta") == 0) continue;
+            const auto bytes = base->raw(s.name);
+            sections.push_back({s.name, static_cast<CheckpointType>(s.type), s.count,
+                                std::vector<char>(bytes.begin(), bytes.end())});
+        }
+        base.reset();
+
+        for (; exists(delta_path(path, sequence)); ++sequence) {
+            CheckpointReader delta(delta_path(path, sequence));
+            const auto delta_meta = delta.column<std::int64_t>("chain.meta", 3);
+            if (delta_meta[0] != tag || static_cast<std::uint64_t>(delta_meta[1]) != sequence) break;
+            if (static_cast<std::size_t>(delta_meta[2]) != block_bytes) {
+                throw std::runtime_error("Delta block size differs from its base: " + delta.path());
+            }
+            check(executor, delta, verify);
+            apply(delta, block_bytes, sections);
+        }
+
+        CheckpointWriter writer;
+        for (const Section& s : sections) writer.add(s.name, s.type, s.bytes.data(), s.count);
+        writer.add_values<std::int64_t>("chain.meta", {tag, static_cast<std::int64_t>(sequence - 1),
+                                                       static_cast<std::int64_t>(block_bytes)});
+        return std::make_unique<CheckpointReader>(writer.image(executor), path);
+    }
+
+    // Last delta folded into the base at path, or 0 without a readable chain base
+    static std::uint64_t folded_through(const std::string& path) {
+        if (!exists(path)) return 0;
+        try {
+            CheckpointReader base(path);
+            if (!base.has("chain.meta")) return 0;
+            return static_cast<std::uint64_t>(base.column<std::int64_t>("chain.meta", 3)[1]);
+        } catch (const std::runtime_error&) {
+            return 0;
+        }
+    }
+
+    static bool exists(const std::string& path) {
+        struct stat st;
+        return ::stat(path.c_str(), &st) == 0;
+    }
+
+    static void check(tf::Executor& executor, const CheckpointReader& reader, bool verify) {
+        if (!verify) return;
+        const auto corrupt = reader.verify(executor);
+        if (!corrupt.empty()) {
+            throw std::runtime_error("Corrupt checkpoint section " + corrupt.front() + " in " + reader.path());
+        }
+    }
+
+    // Rebuild the section list as delta describes it
+    static void apply(const CheckpointReader& delta, std::size_t block_bytes, std::vector<Section>& sections) {
+        const auto names = delta.raw("delta.names");
+        const auto shape = delta.column<std::int64_t>("delta.shape");
+        std::unordered_map<std::string, std::size_t> previous;
+        for (std::size_t i = 0; i < sections.size(); ++i) previous.emplace(sections[i].name, i);
+
+        std::vector<Section> next;
+        const char* name = names.begin();
+        for (std::size_t k = 0; name < names.end(); ++k) {
+            const char* end = std::find(name, names.end(), '\0');
+            if (end == names.end() || 3 * k + 2 >= shape.size) {
+                throw std::runtime_error("Corrupt delta manifest: " + delta.path());
+            }
+            Section s{std::string(name, end), static_cast<CheckpointType>(shape[3 * k]),
+                      static_cast<std::size_t>(shape[3 * k + 1]), {}};
+            name = end + 1;
+            const std::int64_t mode = shape[3 * k + 2];
+            const std::string key = "d" + std::to_string(k);
+            const std::size_t bytes = s.count * checkpoint_detail::element_bytes(s.type);
+
+            if (mode == 1) {
+                const auto data = delta.raw(key);
+                s.bytes.assign(data.begin(), data.end());
+            } else {
+                auto it = previous.find(s.name);
+                if (it == previous.end() || sections[it->second].type != s.type) {
+                    throw std::runtime_error("Delta refers to a section its predecessor lacks: " + s.name);
+                }
+                s.bytes = std::move(sections[it->second].bytes);
+                if (mode == 0 && s.bytes.size() != bytes) {
+                    throw std::runtime_error("Delta changes an unchanged section: " + s.name);
+                }
+                s.bytes.resize(bytes);
+                if (mode == 2) {
+                    const auto blocks = delta.column<std::uint64_t>(key + ".blocks");
+                    const auto data = delta.raw(key + ".data");
+                    std::size_t offset = 0;
+                    for (std::uint64_t b : blocks) {
+                        const std::size_t begin = b * block_bytes;
+                        if (begin >= bytes) {
+                            throw std::runtime_error("Delta block out of range: " + s.name);
+                        }
+                        const std::size_t length = std::min(block_bytes, bytes - begin);
+                        if (offset + length > data.size) {
+                            throw std::runtime_error("Truncated delta block data: " + s.name);
+                        }
+                        std::memcpy(s.bytes.data() + begin, data.begin() + offset, length);
+                        offset += length;
+                    }
+                } else if (mode != 0) {
+                    throw std::runtime_error("Unknown delta mode for section " + s.name);
+                }
+            }
+            next.push_back(std::move(s));
+        }
+        sections = std::move(next);
+    }
+
+    // Hash of every block_bytes_ block of every column, blocks in parallel
+    void hash_blocks(tf::Executor& executor, const std::vector<CheckpointWriter::Column>& columns,
+                     std::vector<std::vector<std::uint64_t>>& hashes) const {
+        std::vector<std::pair<std::size_t, std::size_t>> blocks;
+        hashes.resize(columns.size());
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            const std::size_t n = (columns[k].bytes() + block_bytes_ - 1) / block_bytes_;
+            hashes[k].resize(n);
+            for (std::size_t b = 0; b < n; ++b) blocks.emplace_back(k, b);
+        }
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t{0}, blocks.size(), std::size_t{1}, [&](std::size_t i) {
+            const auto [k, b] = blocks[i];
+            const std::size_t begin = b * block_bytes_;
+            hashes[k][b] = checkpoint_detail::hash_bytes(columns[k].data + begin,
+                                                         std::min(block_bytes_, columns[k].bytes() - begin), b);
+        });
+        executor.run(taskflow).wait();
+    }
+
+    void remember(const std::vector<CheckpointWriter::Column>& columns, std::vector<std::vector<std::uint64_t>>& hashes) {
+        state_.clear();
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            state_[columns[k].name] = {columns[k].type, columns[k].bytes(), std::move(hashes[k])};
+        }
+    }
+
+    static void write_file(const std::string& path, const char* data, std::size_t bytes) {
+        const std::string tmp = path + ".tmp";
+        const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open checkpoint file: " + tmp);
+        }
+        for (std::size_t done = 0; done < bytes;) {
+            const ssize_t n = ::write(fd, data + done, bytes - done);
+            if (n <= 0) {
+                ::close(fd);
+                throw std::runtime_error("Cannot write checkpoint file: " + tmp);
+            }
+            done += static_cast<std::size_t>(n);
+        }
+        const bool synced = ::fsync(fd) == 0;
+        ::close(fd);
+        if (!synced || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            throw std::runtime_error("Cannot commit checkpoint file: " + path);
+        }
+    }
+
+    std::string path_;
+    std::size_t block_bytes_;
+    int max_deltas_;
+
+    std::uint64_t tag_ = 0;
+    std::uint64_t sequence_ = 0;
+    std::unordered_map<std::string, SectionState> state_;
+
+    std::uint64_t bases_ = 0;
+    std::uint64_t deltas_ = 0;
+    std::uint64_t delta_bytes_ = 0;
+    std::size_t last_dirty_blocks_ = 0;
+
+    std::thread compactor_;
+    std::atomic<bool> compacting_{false};
+    std::atomic<std::uint64_t> compacted_through_{0};
+    std::atomic<std::uint64_t> compactions_{0};
+    std::exception_ptr error_;
+};
+
+} // namespace taskflow_bridge
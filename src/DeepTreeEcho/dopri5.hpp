@@ -0,0 +1,288 @@
+/**
+ * dopri5.hpp
+ *
+ * Adaptive Dormand–Prince 5(4) integrator with FSAL, PI step-size control and
+ * Hermite dense output.
+ *
+ * - FSAL: the last stage f(y_{n+1}) is reused as the first stage of the next
+ *   step, so an accepted step costs six RHS evaluations.
+ * - PI control (Hairer & Wanner, DOPRI5): h_new = h · safety · err^(-α) ·
+ *   err_prev^β with α = 0.2 - 0.75β, clamped to [min_factor, max_factor].
+ * - Dense output: cubic Hermite interpolation between y_n, y_{n+1} using
+ *   f(y_n) and f(y_{n+1}), both available for free thanks to FSAL.
+ *
+ * Output rows go to an OutputSink, either on a fixed dense grid or at every
+ * accepted step; all stage buffers are allocated once per integrator.
+ */
+
+#pragma once
+
+#include "output_sinks.hpp"
+#include "rhs_kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace taskflow_bridge {
+
+struct Dopri5Options {
+    double rtol = 1e-6;
+    double atol = 1e-8;
+    double h_init = 0.0;        // 0 = automatic initial step
+    double h_max = 0.0;         // 0 = |t1 - t0|
+    double safety = 0.9;
+    double min_factor = 0.2;
+    double max_factor = 10.0;
+    double beta = 0.04;         // PI stabilization, 0 = classic I controller
+    double dense_dt = 0.0;      // > 0: emit on the grid t0 + k·dense_dt
+    std::uint64_t max_steps = 100000;
+};
+
+struct Dopri5Stats {
+    std::uint64_t accepted = 0;
+    std::uint64_t rejected = 0;
+    std::uint64_t rhs_evaluations = 0;
+    std::uint64_t rows_written = 0;
+    double final_h = 0.0;
+};
+
+/**
+ * Dopri5Integrator
+ */
+class Dopri5Integrator {
+public:
+    Dopri5Integrator(std::shared_ptr<const RhsKernel> kernel, Dopri5Options options = {})
+        : kernel_(std::move(kernel)), options_(options) {
+        if (!kernel_) {
+            throw std::runtime_error("Dopri5Integrator requires a kernel");
+        }
+        const std::size_t n = kernel_->dim();
+        for (auto& k : k_) k.assign(n, 0.0);
+        y_stage_.assign(n, 0.0);
+        y_new_.assign(n, 0.0);
+        y_dense_.assign(n, 0.0);
+    }
+
+    Dopri5Options& options() { return options_; }
+    const Dopri5Stats& stats() const { return stats_; }
+    int dim() const { return kernel_->dim(); }
+
+    /**
+     * Integrate y from t0 to t1 in place, streaming rows to `sink`
+     * (which may be null). Returns the final time reached.
+     */
+    double integrate(double* y, double t0, double t1, OutputSink* sink) {
+        const double direction = t1 >= t0 ? 1.0 : -1.0;
+        const double span = std::abs(t1 - t0);
+        const double h_max = options_.h_max > 0.0 ? options_.h_max : span;
+
+        stats_ = Dopri5Stats{};
+        double t = t0;
+
+        rhs(y, k_[0].data());
+        double h = options_.h_init > 0.0 ? options_.h_init : initial_step(y, t0, t1);
+        h = std::min(h, h_max);
+
+        double err_prev = 1e-4;
+        const double alpha = 0.2 - 0.75 * options_.beta;
+        std::uint64_t next_dense = 0;
+
+        emit_initial(t, y, sink, next_dense);
+
+        while (direction * (t1 - t) > 0.0) {
+            if (stats_.accepted + stats_.rejected >= options_.max_steps) {
+                throw std::runtime_error("Dopri5: maximum number of steps reached");
+            }
+
+            const bool last = h >= std::abs(t1 - t);
+            const double dt = last ? (t1 - t) : direction * h;
+
+            stages(y, dt);
+            const double err = error_norm(y);
+
+            if (err <= 1.0) {
+                const double t_new = last ? t1 : t + dt;
+                ++stats_.accepted;
+
+                emit_step(t, t_new, dt, y, sink, next_dense, t0);
+
+                std::copy(y_new_.begin(), y_new_.end(), y);
+                std::swap(k_[0], k_[6]);  // FSAL
+                t = t_new;
+
+                double factor = err == 0.0
+                    ? options_.max_factor
+                    : options_.safety * std::pow(err, -alpha) * std::pow(err_prev, options_.beta);
+                factor = std::clamp(factor, options_.min_factor, options_.max_factor);
+                h = std::min(std::abs(dt) * factor, h_max);
+                err_prev = std::max(err, 1e-4);
+            } else {
+                ++stats_.rejected;
+                const double factor = std::max(options_.min_factor,
+                                               options_.safety * std::pow(err, -alpha));
+                h = std::abs(dt) * factor;
+            }
+
+            // Only a step still to be taken can underflow; a short final remainder is fine
+            if (t != t1 && h < 1e-14 * std::max(1.0, std::abs(t))) {
+                throw std::runtime_error("Dopri5: step size underflow");
+            }
+        }
+
+        stats_.final_h = h;
+        if (sink) sink->flush();
+        return t;
+    }
+
+private:
+    // Dormand–Prince tableau (kernels are autonomous, so the nodes c_i are unused)
+    static constexpr double a21 = 1.0 / 5;
+    static constexpr double a31 = 3.0 / 40, a32 = 9.0 / 40;
+    static constexpr double a41 = 44.0 / 45, a42 = -56.0 / 15, a43 = 32.0 / 9;
+    static constexpr double a51 = 19372.0 / 6561, a52 = -25360.0 / 2187,
+                            a53 = 64448.0 / 6561, a54 = -212.0 / 729;
+    static constexpr double a61 = 9017.0 / 3168, a62 = -355.0 / 33, a63 = 46732.0 / 5247,
+                            a64 = 49.0 / 176, a65 = -5103.0 / 18656;
+    static constexpr double b1 = 35.0 / 384, b3 = 500.0 / 1113, b4 = 125.0 / 192,
+                            b5 = -2187.0 / 6784, b6 = 11.0 / 84;
+    // b - b̂ (5th minus embedded 4th order weights)
+    static constexpr double e1 = 71.0 / 57600, e3 = -71.0 / 16695, e4 = 71.0 / 1920,
+                            e5 = -17253.0 / 339200, e6 = 22.0 / 525, e7 = -1.0 / 40;
+
+    void rhs(const double* y, double* dy) {
+        kernel_->eval(y, dy);
+        ++stats_.rhs_evaluations;
+    }
+
+    // Stages 2..7 from k1 = f(y); leaves y_{n+1} in y_new_ and f(y_{n+1}) in k7
+    void stages(const double* y, double h) {
+        const int n = dim();
+        double* ys = y_stage_.data();
+        const double *k1 = k_[0].data();
+        double *k2 = k_[1].data(), *k3 = k_[2].data(), *k4 = k_[3].data(),
+               *k5 = k_[4].data(), *k6 = k_[5].data(), *k7 = k_[6].data();
+
+        for (int i = 0; i < n; ++i) ys[i] = y[i] + h * a21 * k1[i];
+        rhs(ys, k2);
+        for (int i = 0; i < n; ++i) ys[i] = y[i] + h * (a31 * k1[i] + a32 * k2[i]);
+        rhs(ys, k3);
+        for (int i = 0; i < n; ++i) ys[i] = y[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+        rhs(ys, k4);
+        for (int i = 0; i < n; ++i) {
+            ys[i] = y[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] + a54 * k4[i]);
+        }
+        rhs(ys, k5);
+        for (int i = 0; i < n; ++i) {
+            ys[i] = y[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] + a64 * k4[i] + a65 * k5[i]);
+        }
+        rhs(ys, k6);
+        for (int i = 0; i < n; ++i) {
+            y_new_[i] = y[i] + h * (b1 * k1[i] + b3 * k3[i] + b4 * k4[i] + b5 * k5[i] + b6 * k6[i]);
+        }
+        rhs(y_new_.data(), k7);
+
+        // Stash the error estimate in the stage buffer
+        for (int i = 0; i < n; ++i) {
+            ys[i] = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+        }
+    }
+
+    double error_norm(const double* y) const {
+        const int n = dim();
+        double acc = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double scale = options_.atol +
+                options_.rtol * std::max(std::abs(y[i]), std::abs(y_new_[i]));
+            const double r = y_stage_[i] / scale;
+            acc += r * r;
+        }
+        return std::sqrt(acc / n);
+    }
+
+    // Hairer's starting step heuristic (one extra RHS evaluation)
+    double initial_step(const double* y, double t0, double t1) {
+        const int n = dim();
+        double d0 = 0.0, d1 = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double scale = options_.atol + options_.rtol * std::abs(y[i]);
+            d0 += (y[i] / scale) * (y[i] / scale);
+            d1 += (k_[0][i] / scale) * (k_[0][i] / scale);
+        }
+        d0 = std::sqrt(d0 / n);
+        d1 = std::sqrt(d1 / n);
+        double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+        h0 = std::min(h0, std::abs(t1 - t0));
+
+        const double direction = t1 >= t0 ? 1.0 : -1.0;
+        for (int i = 0; i < n; ++i) y_stage_[i] = y[i] + direction * h0 * k_[0][i];
+        rhs(y_stage_.data(), k_[1].data());
+        double d2 = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double scale = options_.atol + options_.rtol * std::abs(y[i]);
+            const double r = (k_[1][i] - k_[0][i]) / scale;
+            d2 += r * r;
+        }
+        d2 = std::sqrt(d2 / n) / h0;
+
+        const double dmax = std::max(d1, d2);
+        const double h1 = dmax <= 1e-15 ? std::max(1e-6, h0 * 1e-3) : std::pow(0.01 / dmax, 0.2);
+        return std::min(100.0 * h0, h1);
+    }
+
+    void emit_initial(double t, const double* y, OutputSink* sink, std::uint64_t& next_dense) {
+        if (!sink) return;
+        sink->write(t, y, dim());
+        ++stats_.rows_written;
+        next_dense = 1;
+    }
+
+    // Rows inside (t, t + dt]: dense grid points via Hermite, or the step end
+    void emit_step(double t, double t_new, double dt, const double* y, OutputSink* sink,
+                   std::uint64_t& next_dense, double t0) {
+        if (!sink) return;
+        const int n = dim();
+
+        if (options_.dense_dt <= 0.0) {
+            sink->write(t_new, y_new_.data(), n);
+            ++stats_.rows_written;
+            return;
+        }
+
+        const double direction = dt >= 0.0 ? 1.0 : -1.0;
+        const double* f0 = k_[0].data();
+        const double* f1 = k_[6].data();
+        for (;;) {
+            const double t_out = t0 + direction * options_.dense_dt * static_cast<double>(next_dense);
+            if (direction * (t_out - t_new) > 1e-12 * std::max(1.0, std::abs(t_new))) break;
+
+            const double theta = (t_out - t) / dt;
+            const double theta2 = theta * theta;
+            const double theta3 = theta2 * theta;
+            const double h00 = 2 * theta3 - 3 * theta2 + 1;
+            const double h10 = theta3 - 2 * theta2 + theta;
+            const double h01 = -2 * theta3 + 3 * theta2;
+            const double h11 = theta3 - theta2;
+            for (int i = 0; i < n; ++i) {
+                y_dense_[i] = h00 * y[i] + h10 * dt * f0[i] + h01 * y_new_[i] + h11 * dt * f1[i];
+            }
+            sink->write(t_out, y_dense_.data(), n);
+            ++stats_.rows_written;
+            ++next_dense;
+        }
+    }
+
+    std::shared_ptr<const RhsKernel> kernel_;
+    Dopri5Options options_;
+    Dopri5Stats stats_;
+
+    std::vector<double> k_[7];
+    std::vector<double> y_stage_;
+    std::vector<double> y_new_;
+    std::vector<double> y_dense_;
+};
+
+} // namespace taskflow_bridge
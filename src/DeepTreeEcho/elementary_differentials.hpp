@@ -0,0 +1,227 @@
+/**
+ * elementary_differentials.hpp
+ *
+ * Exact elementary differentials F(τ) for all rooted trees up to order p,
+ * evaluated as a DAG of shared subtrees.
+ *
+ * For τ = [τ₁, ..., τ_m],
+ *
+ *     F(•)(y) = f(y)
+ *     F(τ)(y) = f^(m)(y)[F(τ₁)(y), ..., F(τ_m)(y)]
+ *
+ * Each interned subtree is one DAG node. Nodes are evaluated in order of
+ * increasing |τ|, so the children of a node are already available when it is
+ * reached; the m-th derivative is taken exactly by one kernel call on
+ * HyperDual<m> numbers seeded with the children's values. Per step every
+ * distinct subtree costs exactly one kernel evaluation, regardless of how
+ * many trees contain it.
+ *
+ * The plan is generic over the scalar type: double for a single trajectory,
+ * SimdLanes for kSimdLanes trajectories evaluated together.
+ */
+
+#pragma once
+
+#include "hyper_dual.hpp"
+#include "rhs_kernel.hpp"
+#include "tree_arena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+namespace detail {
+
+template <class T, class Seq>
+struct DualVectors;
+
+template <class T, int... I>
+struct DualVectors<T, std::integer_sequence<int, I...>> {
+    using type = std::tuple<std::vector<HyperDual<I + 1, T>>...>;
+};
+
+template <class T>
+using DualScratch =
+    typename DualVectors<T, std::make_integer_sequence<int, kMaxDualDirections>>::type;
+
+} // namespace detail
+
+/**
+ * BasicElementaryDifferentialDAG
+ *
+ * Compiled evaluation plan for {F(τ) : |τ| <= max_order}. All scratch is
+ * allocated at construction; evaluate() does no heap allocation.
+ */
+template <class T>
+class BasicElementaryDifferentialDAG {
+public:
+    BasicElementaryDifferentialDAG(std::shared_ptr<const RhsKernel> kernel,
+                                   TreeArena& arena, int max_order)
+        : kernel_(std::move(kernel)), arena_(&arena), max_order_(max_order) {
+        if (!kernel_) {
+            throw std::runtime_error("ElementaryDifferentialDAG requires a kernel");
+        }
+        dim_ = kernel_->dim();
+
+        trees_ = arena.enumerate_up_to(max_order);
+        slot_of_.assign(arena.size(), -1);
+        for (std::size_t s = 0; s < trees_.size(); ++s) {
+            slot_of_[trees_[s]] = static_cast<int>(s);
+        }
+
+        int max_children = 0;
+        child_offset_.reserve(trees_.size() + 1);
+        for (TreeId t : trees_) {
+            child_offset_.push_back(static_cast<std::uint32_t>(child_slots_.size()));
+            for (const TreeId* c = arena.children_begin(t); c != arena.children_end(t); ++c) {
+                child_slots_.push_back(slot_of_[*c]);
+            }
+            max_children = std::max(max_children, static_cast<int>(arena.num_children(t)));
+        }
+        child_offset_.push_back(static_cast<std::uint32_t>(child_slots_.size()));
+
+        if (max_children > kMaxDualDirections) {
+            throw std::runtime_error(
+                "Trees of order " + std::to_string(max_order) + " need " +
+                std::to_string(max_children) + " derivative directions (max " +
+                std::to_string(kMaxDualDirections) + ")");
+        }
+
+        active_.assign(trees_.size(), 1);
+        num_active_ = trees_.size();
+        values_.assign(trees_.size() * dim_, T(0.0));
+        allocate_scratch(max_children, std::make_integer_sequence<int, kMaxDualDirections>());
+    }
+
+    /**
+     * Restrict evaluation to the given slots and the subtrees they depend
+     * on. Inactive nodes are skipped by evaluate() and keep stale values.
+     */
+    void restrict_to(const std::vector<char>& required) {
+        if (required.size() != trees_.size()) {
+            throw std::runtime_error("Slot mask size mismatch");
+        }
+        for (std::size_t s = 0; s < required.size(); ++s) {
+            active_[s] = required[s] ? 1 : 0;
+        }
+        // Parents come after children, so one reverse sweep closes the set
+        for (std::size_t s = trees_.size(); s-- > 0; ) {
+            if (!active_[s]) continue;
+            for (std::uint32_t k = child_offset_[s]; k < child_offset_[s + 1]; ++k) {
+                active_[child_slots_[k]] = 1;
+            }
+        }
+        num_active_ = static_cast<std::size_t>(std::count(active_.begin(), active_.end(), 1));
+    }
+
+    bool is_active(int s) const { return active_[s] != 0; }
+
+    /**
+     * Evaluate F(τ)(y) for every active tree in the plan.
+     */
+    void evaluate(const T* y) {
+        for (std::size_t s = 0; s < trees_.size(); ++s) {
+            if (!active_[s]) continue;
+            const int m = static_cast<int>(child_offset_[s + 1] - child_offset_[s]);
+            if (m == 0) {
+                kernel_->eval(y, values_.data() + s * dim_);
+            } else {
+                dispatch(m, static_cast<int>(s), y,
+                         std::make_integer_sequence<int, kMaxDualDirections>());
+            }
+        }
+        kernel_evaluations_ += num_active_;
+    }
+
+    // Accessors
+
+    const T* differential(TreeId tree) const {
+        return values_.data() + static_cast<std::size_t>(slot(tree)) * dim_;
+    }
+
+    int slot(TreeId tree) const {
+        if (tree < 0 || static_cast<std::size_t>(tree) >= slot_of_.size() || slot_of_[tree] < 0) {
+            throw std::runtime_error("Tree not in differential DAG: " + std::to_string(tree));
+        }
+        return slot_of_[tree];
+    }
+
+    // Node-major [num_nodes × dim] block of all differentials
+    const std::vector<T>& values() const { return values_; }
+
+    const std::vector<TreeId>& trees() const { return trees_; }
+    const TreeArena& arena() const { return *arena_; }
+    const RhsKernel& kernel() const { return *kernel_; }
+
+    std::size_t num_nodes() const { return trees_.size(); }
+    std::size_t num_active() const { return num_active_; }
+    int dim() const { return dim_; }
+    int max_order() const { return max_order_; }
+    std::uint64_t kernel_evaluations() const { return kernel_evaluations_; }
+
+private:
+    template <int... I>
+    void allocate_scratch(int max_children, std::integer_sequence<int, I...>) {
+        ((I + 1 <= max_children
+              ? (std::get<I>(dual_in_).resize(dim_), std::get<I>(dual_out_).resize(dim_), 0)
+              : 0), ...);
+    }
+
+    template <int... I>
+    void dispatch(int m, int s, const T* y, std::integer_sequence<int, I...>) {
+        ((m == I + 1 ? (eval_node<I + 1>(s, y), true) : false) || ...);
+    }
+
+    template <int K>
+    void eval_node(int s, const T* y) {
+        auto& in = std::get<K - 1>(dual_in_);
+        auto& out = std::get<K - 1>(dual_out_);
+        const int* children = child_slots_.data() + child_offset_[s];
+
+        for (int i = 0; i < dim_; ++i) {
+            auto& x = in[i];
+            x.c.fill(T(0.0));
+            x.c[0] = y[i];
+            for (int j = 0; j < K; ++j) {
+                x.seed(j, values_[static_cast<std::size_t>(children[j]) * dim_ + i]);
+            }
+        }
+
+        kernel_->eval(in.data(), out.data());
+
+        T* dst = values_.data() + static_cast<std::size_t>(s) * dim_;
+        for (int i = 0; i < dim_; ++i) {
+            dst[i] = out[i].top();
+        }
+    }
+
+    std::shared_ptr<const RhsKernel> kernel_;
+    const TreeArena* arena_;
+    int max_order_;
+    int dim_ = 0;
+
+    std::vector<TreeId> trees_;
+    std::vector<int> slot_of_;
+    std::vector<std::uint32_t> child_offset_;
+    std::vector<int> child_slots_;
+
+    std::vector<char> active_;
+    std::size_t num_active_ = 0;
+
+    std::vector<T> values_;
+    detail::DualScratch<T> dual_in_;
+    detail::DualScratch<T> dual_out_;
+
+    std::uint64_t kernel_evaluations_ = 0;
+};
+
+using ElementaryDifferentialDAG = BasicElementaryDifferentialDAG<double>;
+
+} // namespace taskflow_bridge
@@ -0,0 +1,199 @@
+/**
+ * ensemble_integrator.hpp
+ *
+ * B-series integration of N independent trajectories of the same method.
+ *
+ * States are stored structure-of-arrays: component i of trajectory j lives at
+ * states[i * stride + j], with stride padded to a multiple of kSimdLanes.
+ * Trajectories are processed in blocks of kSimdLanes lanes, so one kernel
+ * call (and one elementary differential DAG sweep) advances a whole block,
+ * and blocks are spread over the bridge executor's workers. Each worker owns
+ * its own DAG replica, so the hot loop shares no mutable state.
+ */
+
+#pragma once
+
+#include "bseries_stepper.hpp"
+#include "elementary_differentials.hpp"
+#include "rhs_kernel.hpp"
+#include "simd_lanes.hpp"
+#include "tree_arena.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * EnsembleIntegrator
+ *
+ * Coefficients follow BSeriesStepper (DAG slot order).
+ */
+class EnsembleIntegrator {
+public:
+    EnsembleIntegrator(std::shared_ptr<const RhsKernel> kernel, TreeArena& arena,
+                       int max_order, int num_trajectories, int num_workers)
+        : num_trajectories_(num_trajectories),
+          num_blocks_((num_trajectories + kSimdLanes - 1) / kSimdLanes),
+          stride_(num_blocks_ * kSimdLanes) {
+        if (!kernel) {
+            throw std::runtime_error("EnsembleIntegrator requires a kernel");
+        }
+        if (num_trajectories < 1) {
+            throw std::runtime_error("Ensemble needs at least one trajectory");
+        }
+        dim_ = kernel->dim();
+
+        // One replica per worker plus one for calls from outside the pool
+        const int replicas = std::max(num_workers, 1) + 1;
+        for (int r = 0; r < replicas; ++r) {
+            workers_.push_back(std::make_unique<Worker>(kernel, arena, max_order));
+        }
+        weights_ = std::make_unique<BSeriesWeights>(arena, workers_[0]->dag.trees(), max_order);
+        set_exact_coefficients(max_order);
+
+        states_.assign(static_cast<std::size_t>(dim_) * stride_, 0.0);
+    }
+
+    // Coefficients
+
+    void set_coefficients(const std::vector<double>& b) {
+        weights_->set_coefficients(b);
+        coefficients_changed();
+    }
+
+    void set_exact_coefficients(int order) {
+        weights_->set_exact(order);
+        coefficients_changed();
+    }
+
+    // States
+
+    // Trajectory-major input: y[j * dim + i]
+    void set_states(const std::vector<double>& y) {
+        if (y.size() != static_cast<std::size_t>(num_trajectories_) * dim_) {
+            throw std::runtime_error("Ensemble state size mismatch");
+        }
+        for (int j = 0; j < num_trajectories_; ++j) {
+            for (int i = 0; i < dim_; ++i) {
+                states_[static_cast<std::size_t>(i) * stride_ + j] = y[static_cast<std::size_t>(j) * dim_ + i];
+            }
+        }
+    }
+
+    std::vector<double> get_states() const {
+        std::vector<double> y(static_cast<std::size_t>(num_trajectories_) * dim_);
+        for (int j = 0; j < num_trajectories_; ++j) {
+            for (int i = 0; i < dim_; ++i) {
+                y[static_cast<std::size_t>(j) * dim_ + i] = states_[static_cast<std::size_t>(i) * stride_ + j];
+            }
+        }
+        return y;
+    }
+
+    // SoA row of component i (length stride, first num_trajectories valid)
+    double* component(int i) { return states_.data() + static_cast<std::size_t>(i) * stride_; }
+
+    // Integration
+
+    /**
+     * Advance every trajectory by num_steps steps of size h. Each block runs
+     * all its steps inside one task, so states stay in registers/L1 for the
+     * whole sweep.
+     */
+    void integrate(tf::Executor& executor, double h, int num_steps) {
+        if (executor.num_workers() + 1 > workers_.size()) {
+            throw std::runtime_error("Ensemble was built for fewer workers than the executor has");
+        }
+        const std::vector<double>& weights = weights_->at(h);
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, num_blocks_, 1, [&](int block) {
+            // Worker ids are 0..num_workers-1; -1 means the calling thread
+            Worker& worker = *workers_[executor.this_worker_id() + 1];
+            advance_block(worker, weights, block, num_steps);
+        });
+        executor.run(taskflow).wait();
+        steps_ += num_steps;
+    }
+
+    // Accessors
+
+    int num_trajectories() const { return num_trajectories_; }
+    int dim() const { return dim_; }
+    int stride() const { return stride_; }
+    std::uint64_t steps() const { return steps_; }
+    const std::vector<double>& coefficients() const { return weights_->coefficients(); }
+
+private:
+    struct Worker {
+        Worker(std::shared_ptr<const RhsKernel> kernel, TreeArena& arena, int max_order)
+            : dag(std::move(kernel), arena, max_order),
+              y(dag.dim()),
+              increment(dag.dim()) {}
+
+        BasicElementaryDifferentialDAG<SimdLanes> dag;
+        std::vector<SimdLanes> y;
+        std::vector<SimdLanes> increment;
+    };
+
+    void coefficients_changed() {
+        const std::vector<char> required = weights_->required();
+        for (auto& worker : workers_) worker->dag.restrict_to(required);
+    }
+
+    void advance_block(Worker& worker, const std::vector<double>& weights,
+                       int block, int num_steps) {
+        const int first = block * kSimdLanes;
+        const int valid = std::min(kSimdLanes, num_trajectories_ - first);
+
+        // Padding lanes replay lane 0 so the kernel never sees garbage
+        for (int i = 0; i < dim_; ++i) {
+            const double* row = states_.data() + static_cast<std::size_t>(i) * stride_ + first;
+            for (int l = 0; l < kSimdLanes; ++l) {
+                worker.y[i].v[l] = row[l < valid ? l : 0];
+            }
+        }
+
+        const std::size_t nodes = weights.size();
+        for (int k = 0; k < num_steps; ++k) {
+            worker.dag.evaluate(worker.y.data());
+            const SimdLanes* F = worker.dag.values().data();
+
+            for (int i = 0; i < dim_; ++i) worker.increment[i] = SimdLanes(0.0);
+            for (std::size_t s = 0; s < nodes; ++s) {
+                const double w = weights[s];
+                if (w == 0.0) continue;
+                const SimdLanes ws(w);
+                const SimdLanes* Fs = F + s * dim_;
+                for (int i = 0; i < dim_; ++i) {
+                    worker.increment[i] = fma(ws, Fs[i], worker.increment[i]);
+                }
+            }
+            for (int i = 0; i < dim_; ++i) worker.y[i] += worker.increment[i];
+        }
+
+        for (int i = 0; i < dim_; ++i) {
+            double* row = states_.data() + static_cast<std::size_t>(i) * stride_ + first;
+            for (int l = 0; l < valid; ++l) row[l] = worker.y[i].v[l];
+        }
+    }
+
+    int num_trajectories_;
+    int num_blocks_;
+    int stride_;
+    int dim_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<BSeriesWeights> weights_;
+    std::vector<double> states_;
+    std::uint64_t steps_ = 0;
+};
+
+} // namespace taskflow_bridge
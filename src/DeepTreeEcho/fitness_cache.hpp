@@ -0,0 +1,217 @@
+/**
+ * fitness_cache.hpp
+ *
+ * Memoized fitness keyed by genome content.
+ *
+ * Elites and clones reach the evaluator unchanged generation after
+ * generation. FitnessCache maps a 128-bit hash of the genome (MurmurHash3
+ * x64_128 over its canonicalized doubles) to its last fitness. The hash is
+ * seeded with the evaluation-data version, so bumping the version makes every
+ * older entry unreachable, and those entries age out through LRU eviction.
+ *
+ * The cache is split into independently locked shards (chosen by hash bits)
+ * so parallel evaluation tasks rarely contend. Each shard is an LRU list of
+ * at most capacity / num_shards entries.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+struct GenomeHash {
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    bool operator==(const GenomeHash& o) const { return lo == o.lo && hi == o.hi; }
+};
+
+namespace detail {
+
+inline std::uint64_t rotl64(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t fmix64(std::uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+// -0.0 → +0.0 and every NaN → one quiet NaN, so equal genomes hash equally
+inline std::uint64_t canonical_bits(double x) {
+    if (x == 0.0) x = 0.0;
+    if (x != x) return 0x7ff8000000000000ULL;
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+} // namespace detail
+
+/**
+ * MurmurHash3 x64_128 of the canonical 64-bit words of genome[0..length),
+ * seeded with the data version (both halves) and finalized with the byte
+ * length.
+ */
+inline GenomeHash hash_genome(const double* genome, int length, std::uint64_t version) {
+    constexpr std::uint64_t c1 = 0x87c37b91114253d5ULL;
+    constexpr std::uint64_t c2 = 0x4cf5ad432745937fULL;
+    std::uint64_t h1 = version;
+    std::uint64_t h2 = version;
+
+    int i = 0;
+    for (; i + 2 <= length; i += 2) {
+        std::uint64_t k1 = detail::canonical_bits(genome[i]);
+        std::uint64_t k2 = detail::canonical_bits(genome[i + 1]);
+
+        k1 *= c1; k1 = detail::rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+        h1 = detail::rotl64(h1, 27); h1 += h2; h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2; k2 = detail::rotl64(k2, 33); k2 *= c1; h2 ^= k2;
+        h2 = detail::rotl64(h2, 31); h2 += h1; h2 = h2 * 5 + 0x38495ab5;
+    }
+    if (i < length) {
+        std::uint64_t k1 = detail::canonical_bits(genome[i]);
+        k1 *= c1; k1 = detail::rotl64(k1, 31); k1 *= c2; h1 ^= k1;
+    }
+
+    const std::uint64_t bytes = static_cast<std::uint64_t>(length) * sizeof(double);
+    h1 ^= bytes;
+    h2 ^= bytes;
+    h1 += h2;
+    h2 += h1;
+    h1 = detail::fmix64(h1);
+    h2 = detail::fmix64(h2);
+    h1 += h2;
+    h2 += h1;
+    return {h1, h2};
+}
+
+/**
+ * FitnessCache
+ */
+class FitnessCache {
+public:
+    explicit FitnessCache(std::size_t capacity, int num_shards = 16) {
+        if (capacity < 1 || num_shards < 1) {
+            throw std::runtime_error("Fitness cache needs a positive capacity and shard count");
+        }
+        const std::size_t shards = std::min<std::size_t>(num_shards, capacity);
+        for (std::size_t s = 0; s < shards; ++s) {
+            auto shard = std::make_unique<Shard>();
+            // Spread the remainder so total capacity is exact
+            shard->capacity = capacity / shards + (s < capacity % shards ? 1 : 0);
+            shards_.push_back(std::move(shard));
+        }
+        capacity_ = capacity;
+    }
+
+    GenomeHash key(const double* genome, int length) const {
+        return hash_genome(genome, length, data_version());
+    }
+
+    bool lookup(const GenomeHash& key, double& fitness) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        fitness = it->second->second;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void insert(const GenomeHash& key, double fitness) {
+        Shard& shard = shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            it->second->second = fitness;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+        if (shard.lru.size() == shard.capacity) {
+            shard.index.erase(shard.lru.back().first);
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.lru.emplace_front(key, fitness);
+        shard.index.emplace(key, shard.lru.begin());
+        insertions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->lru.clear();
+            shard->index.clear();
+        }
+    }
+
+    // New evaluation data (test problems, domain data) invalidates old entries
+    void set_data_version(std::uint64_t version) { version_.store(version, std::memory_order_relaxed); }
+    std::uint64_t data_version() const { return version_.load(std::memory_order_relaxed); }
+
+    std::size_t size() const {
+        std::size_t n = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            n += shard->lru.size();
+        }
+        return n;
+    }
+
+    std::size_t capacity() const { return capacity_; }
+    std::uint64_t hits() const { return hits_.load(); }
+    std::uint64_t misses() const { return misses_.load(); }
+    std::uint64_t insertions() const { return insertions_.load(); }
+    std::uint64_t evictions() const { return evictions_.load(); }
+
+    double hit_rate() const {
+        const double lookups = static_cast<double>(hits()) + static_cast<double>(misses());
+        return lookups > 0.0 ? hits() / lookups : 0.0;
+    }
+
+private:
+    struct KeyHash {
+        std::size_t operator()(const GenomeHash& h) const { return static_cast<std::size_t>(h.lo); }
+    };
+
+    using Entry = std::pair<GenomeHash, double>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> lru;
+        std::unordered_map<GenomeHash, std::list<Entry>::iterator, KeyHash> index;
+        std::size_t capacity = 0;
+    };
+
+    // High bits pick the shard; the low word already drives the bucket
+    Shard& shard_for(const GenomeHash& key) { return *shards_[key.hi % shards_.size()]; }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t capacity_ = 0;
+    std::atomic<std::uint64_t> version_{0};
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::uint64_t> insertions_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,185 @@
+/**
+ * fitness_service.hpp
+ *
+ * Batched fitness evaluation on the bridge executor.
+ *
+ * Evaluation cost varies strongly between individuals (tree order, genome
+ * length), so a static split of the population over workers leaves most of
+ * them idle behind the slowest chunk. EvaluationService submits one task per
+ * individual and lets the executor's work-stealing scheduler balance them;
+ * a batch then takes about as long as its slowest individual instead of
+ * the sum over a fixed partition.
+ *
+ * Genomes are ragged: individual i occupies genomes[offsets[i]] ..
+ * genomes[offsets[i+1]-1]. Timeouts are cooperative. A kernel can poll its
+ * EvaluationBudget and return early, and any result that arrives after the
+ * deadline (or an exception) is replaced by the service's penalty fitness.
+ *
+ * With a FitnessCache attached, each task looks its genome up first and a
+ * hit never reaches the kernel. Only Ok results are stored, so penalties
+ * from timeouts and failures are retried on the next batch.
+ */
+
+#pragma once
+
+#include "fitness_cache.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+struct EvaluationBudget {
+    std::chrono::steady_clock::time_point deadline;
+
+    bool expired() const { return std::chrono::steady_clock::now() >= deadline; }
+};
+
+/**
+ * FitnessKernel
+ *
+ * Type-erased fitness of a variable-length genome; higher is better.
+ * evaluate must be safe to call concurrently.
+ */
+class FitnessKernel {
+public:
+    explicit FitnessKernel(std::string name = "fitness") : name_(std::move(name)) {}
+
+    virtual ~FitnessKernel() = default;
+
+    const std::string& name() const { return name_; }
+
+    virtual double evaluate(const double* genome, int length, const EvaluationBudget& budget) const = 0;
+
+private:
+    std::string name_;
+};
+
+template <class F>
+class FunctorFitness final : public FitnessKernel {
+public:
+    FunctorFitness(F f, std::string name) : FitnessKernel(std::move(name)), f_(std::move(f)) {}
+
+    double evaluate(const double* genome, int length, const EvaluationBudget& budget) const override {
+        return f_(genome, length, budget);
+    }
+
+private:
+    F f_;
+};
+
+template <class F>
+std::shared_ptr<FitnessKernel> make_fitness_kernel(F f, std::string name = "fitness") {
+    return std::make_shared<FunctorFitness<F>>(std::move(f), std::move(name));
+}
+
+enum class EvaluationStatus : std::uint8_t {
+    Ok = 0,
+    TimedOut = 1,
+    Failed = 2,
+    Cached = 3,
+};
+
+/**
+ * EvaluationService
+ *
+ * timeout_seconds <= 0 disables the per-individual deadline.
+ */
+class EvaluationService {
+public:
+    EvaluationService(std::shared_ptr<const FitnessKernel> kernel, double timeout_seconds, double penalty)
+        : kernel_(std::move(kernel)), timeout_seconds_(timeout_seconds), penalty_(penalty) {}
+
+    void evaluate(tf::Executor& executor, const double* genomes, const int* offsets, int num_individuals,
+                  double* fitness) {
+        using clock = std::chrono::steady_clock;
+        status_.assign(num_individuals, EvaluationStatus::Ok);
+        std::atomic<std::int64_t> slowest_ns{0};
+        const auto timeout = timeout_seconds_ > 0.0
+            ? std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(timeout_seconds_))
+            : clock::duration::max();
+
+        const auto batch_start = clock::now();
+        tf::Taskflow taskflow;
+        for (int i = 0; i < num_individuals; ++i) {
+            taskflow.emplace([&, i] {
+                const double* genome = genomes + offsets[i];
+                const int length = offsets[i + 1] - offsets[i];
+                GenomeHash key;
+                if (cache_) {
+                    key = cache_->key(genome, length);
+                    if (cache_->lookup(key, fitness[i])) {
+                        status_[i] = EvaluationStatus::Cached;
+                        return;
+                    }
+                }
+                const auto start = clock::now();
+                EvaluationBudget budget{timeout == clock::duration::max() ? clock::time_point::max() : start + timeout};
+                try {
+                    fitness[i] = kernel_->evaluate(genome, length, budget);
+                    if (budget.expired()) {
+                        fitness[i] = penalty_;
+                        status_[i] = EvaluationStatus::TimedOut;
+                    } else if (cache_) {
+                        cache_->insert(key, fitness[i]);
+                    }
+                } catch (const std::exception&) {
+                    fitness[i] = penalty_;
+                    status_[i] = EvaluationStatus::Failed;
+                }
+                const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+                std::int64_t prev = slowest_ns.load(std::memory_order_relaxed);
+                while (ns > prev && !slowest_ns.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+                }
+            });
+        }
+        executor.run(taskflow).wait();
+
+        last_batch_seconds_ = std::chrono::duration<double>(clock::now() - batch_start).count();
+        last_slowest_seconds_ = slowest_ns.load() * 1e-9;
+        evaluated_ += num_individuals;
+        timed_out_ += std::count(status_.begin(), status_.end(), EvaluationStatus::TimedOut);
+        failed_ += std::count(status_.begin(), status_.end(), EvaluationStatus::Failed);
+        cached_ += std::count(status_.begin(), status_.end(), EvaluationStatus::Cached);
+    }
+
+    // nullptr detaches
+    void set_cache(std::shared_ptr<FitnessCache> cache) { cache_ = std::move(cache); }
+    const std::shared_ptr<FitnessCache>& cache() const { return cache_; }
+
+    // Status of each individual in the last batch
+    const std::vector<EvaluationStatus>& status() const { return status_; }
+
+    double timeout_seconds() const { return timeout_seconds_; }
+    double penalty() const { return penalty_; }
+    std::uint64_t evaluated() const { return evaluated_; }
+    std::uint64_t timed_out() const { return timed_out_; }
+    std::uint64_t failed() const { return failed_; }
+    std::uint64_t cached() const { return cached_; }
+    double last_batch_seconds() const { return last_batch_seconds_; }
+    double last_slowest_seconds() const { return last_slowest_seconds_; }
+
+private:
+    std::shared_ptr<const FitnessKernel> kernel_;
+    double timeout_seconds_;
+    double penalty_;
+    std::shared_ptr<FitnessCache> cache_;
+    std::vector<EvaluationStatus> status_;
+    std::uint64_t evaluated_ = 0;
+    std::uint64_t timed_out_ = 0;
+    std::uint64_t failed_ = 0;
+    std::uint64_t cached_ = 0;
+    double last_batch_seconds_ = 0.0;
+    double last_slowest_seconds_ = 0.0;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,452 @@
+/**
+ * garden_table.hpp
+ *
+ * Structure-of-arrays membrane garden (MembraneGardenCore.jl).
+ *
+ * One row per planted tree, with columns tree id, membrane id, fitness, age,
+ * mutations, energy contribution, reservoir performance and the two parent
+ * trees. Each membrane keeps an ascending list of its rows. Growth uses an
+ * O(n) quantile (two nth_element passes, Julia's default definition) and
+ * never sorts. Pruning compacts the columns stably in place. A row only
+ * moves down by the number of removed rows before it, so each membrane list
+ * is patched from its first row at or after the first removal, instead of
+ * being rebuilt from scratch.
+ *
+ * Fitness follows compute_tree_fitness. Offspring are bred with
+ * TreeOperators on the shared arena, so they stay canonical TreeIds.
+ *
+ * grow follows grow_garden! with one global quantile. grow_membranes treats
+ * each membrane as its own population: scoring, selection and breeding
+ * decisions run as one task per membrane, and exchange is the separate,
+ * deterministic cross-pollination phase between membranes.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+#include "philox.hpp"
+#include "tree_arena.hpp"
+#include "tree_operators.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+constexpr TreeId kNoTree = -1;
+
+// GrowthDynamics plus the feedback dictionaries of grow_garden!
+struct GardenGrowth {
+    double mutation_rate = 0.05;
+    double crossover_rate = 0.3;
+    double selection_pressure = 0.5;
+    int max_order = 20;
+    double reservoir_activity = 0.0;
+    double reservoir_stability = 0.0;
+    double energy = 0.0;
+    double gradient_norm = 0.0;
+};
+
+/**
+ * GardenTable
+ */
+class GardenTable {
+public:
+    explicit GardenTable(TreeArena& arena) : arena_(arena), operators_(arena) {}
+
+    int plant(TreeId tree, int membrane, TreeId parent_a = kNoTree, TreeId parent_b = kNoTree, int mutations = 0) {
+        if (tree < 0 || tree >= static_cast<TreeId>(arena_.size())) {
+            throw std::runtime_error("Invalid tree id: " + std::to_string(tree));
+        }
+        const int r = size();
+        tree_.push_back(tree);
+        membrane_.push_back(membrane);
+        fitness_.push_back(0.0);
+        age_.push_back(0);
+        mutations_.push_back(mutations);
+        energy_.push_back(0.0);
+        reservoir_.push_back(0.0);
+        parent_a_.push_back(parent_a);
+        parent_b_.push_back(parent_b);
+        membrane_rows_[membrane].push_back(r);
+        return r;
+    }
+
+    // compute_tree_fitness for every row, then age += 1
+    void score(tf::Executor& executor, const GardenGrowth& g) {
+        const double reservoir_fitness = 0.5 * (g.reservoir_activity + g.reservoir_stability);
+        const double jsurface_fitness = 1.0 / (1.0 + std::abs(g.energy) + g.gradient_norm);
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, size(), 1, [&](int r) { score_row(r, reservoir_fitness, jsurface_fitness); });
+        executor.run(taskflow).wait();
+    }
+
+    // Statistics.quantile(fitness, q) (linear interpolation between order statistics), in O(n)
+    double quantile(double q) {
+        const int n = size();
+        if (n == 0) {
+            throw std::runtime_error("Quantile of an empty garden");
+        }
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::runtime_error("Quantile must lie in [0, 1]");
+        }
+        scratch_.assign(fitness_.begin(), fitness_.end());
+        return select_quantile(scratch_, q);
+    }
+
+    /**
+     * One grow_garden! generation: score, keep rows at or above the
+     * selection quantile, mutate each with probability mutation_rate, and
+     * with probability crossover_rate add one crossover child. Row r draws
+     * from (seed, generation, r, Mutation); the crossover from
+     * (seed, generation, 0, Crossover). Returns the number of trees planted.
+     */
+    int grow(tf::Executor& executor, const GardenGrowth& g, std::uint64_t seed) {
+        const std::uint32_t generation = static_cast<std::uint32_t>(generation_++);
+        if (size() == 0) return 0;
+        score(executor, g);
+        const double threshold = quantile(g.selection_pressure);
+
+        selected_.clear();
+        for (int r = 0; r < size(); ++r) {
+            if (fitness_[r] >= threshold) selected_.push_back(r);
+        }
+
+        const int before = size();
+        for (int r : selected_) {
+            PhiloxStream rng(seed, generation, static_cast<std::uint32_t>(r), RandomOperator::Mutation);
+            if (rng.uniform() < g.mutation_rate) {
+                const TreeId mutated = operators_.mutate(tree_[r], 1.0, g.max_order, rng);
+                plant(mutated, membrane_[r], tree_[r], kNoTree, mutations_[r] + 1);
+            }
+        }
+        PhiloxStream rng(seed, generation, 0, RandomOperator::Crossover);
+        if (selected_.size() >= 2 && rng.uniform() < g.crossover_rate) {
+            const int a = selected_[rng.below(static_cast<std::uint32_t>(selected_.size()))];
+            const int b = selected_[rng.below(static_cast<std::uint32_t>(selected_.size()))];
+            const TreeId child = operators_.crossover(tree_[a], tree_[b], g.max_order, rng);
+            plant(child, membrane_[a], tree_[a], tree_[b]);
+        }
+        return size() - before;
+    }
+
+    /**
+     * One generation with every membrane as its own population. Each
+     * membrane is scored, cut at its own selection_pressure quantile and
+     * planned in one executor task: which selected rows mutate and which
+     * pair crosses, together with the stream each operator continues from.
+     * The arena cannot grow concurrently, so offspring are then interned and
+     * planted membrane by membrane in ascending id. Row r draws from
+     * (seed, generation, r, Mutation) and membrane m's crossover from
+     * (seed, generation, m, Crossover), so the result does not depend on the
+     * number of workers. Returns the number of trees planted.
+     */
+    int grow_membranes(tf::Executor& executor, const GardenGrowth& g, std::uint64_t seed) {
+        const std::uint32_t generation = static_cast<std::uint32_t>(generation_++);
+        if (!(g.selection_pressure >= 0.0 && g.selection_pressure <= 1.0)) {
+            throw std::runtime_error("Quantile must lie in [0, 1]");
+        }
+        const std::vector<int> ids = membrane_ids();
+        if (plans_.size() < ids.size()) plans_.resize(ids.size());
+        for (std::size_t k = 0; k < ids.size(); ++k) {
+            plans_[k].rows = &membrane_rows_.at(ids[k]);
+        }
+
+        const double reservoir_fitness = 0.5 * (g.reservoir_activity + g.reservoir_stability);
+        const double jsurface_fitness = 1.0 / (1.0 + std::abs(g.energy) + g.gradient_norm);
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, static_cast<int>(ids.size()), 1, [&](int k) {
+            MembranePlan& plan = plans_[k];
+            const std::vector<int>& rows = *plan.rows;
+            plan.values.clear();
+            for (int r : rows) {
+                score_row(r, reservoir_fitness, jsurface_fitness);
+                plan.values.push_back(fitness_[r]);
+            }
+            const double threshold = select_quantile(plan.values, g.selection_pressure);
+
+            plan.selected.clear();
+            plan.breeding.clear();
+            for (int r : rows) {
+                if (fitness_[r] >= threshold) plan.selected.push_back(r);
+            }
+            for (int r : plan.selected) {
+                PhiloxStream rng(seed, generation, static_cast<std::uint32_t>(r), RandomOperator::Mutation);
+                if (rng.uniform() < g.mutation_rate) plan.breeding.push_back({r, -1, rng});
+            }
+            PhiloxStream rng(seed, generation, static_cast<std::uint32_t>(ids[k]), RandomOperator::Crossover);
+            const std::uint32_t n = static_cast<std::uint32_t>(plan.selected.size());
+            if (n >= 2 && rng.uniform() < g.crossover_rate) {
+                const int a = plan.selected[rng.below(n)];
+                const int b = plan.selected[rng.below(n)];
+                plan.breeding.push_back({a, b, rng});
+            }
+        });
+        executor.run(taskflow).wait();
+
+        const int before = size();
+        for (std::size_t k = 0; k < ids.size(); ++k) {
+            for (Breeding& child : plans_[k].breeding) {
+                const int a = child.a;
+                if (child.b < 0) {
+                    const TreeId mutated = operators_.mutate(tree_[a], 1.0, g.max_order, child.rng);
+                    plant(mutated, ids[k], tree_[a], kNoTree, mutations_[a] + 1);
+                } else {
+                    const TreeId hybrid = operators_.crossover(tree_[a], tree_[child.b], g.max_order, child.rng);
+                    plant(hybrid, ids[k], tree_[a], tree_[child.b]);
+                }
+            }
+        }
+        return size() - before;
+    }
+
+    /**
+     * cross_pollinate! as its own phase. For each (m1, m2) pair in order,
+     * crosses hybrids are bred from a random row of each membrane and
+     * planted in one of the two at random. Parents come only from rows that
+     * existed when the phase began, and pair p draws from (seed, generation,
+     * p, Hybrid), so the exchange is deterministic. Pairs with an empty side
+     * are skipped. Returns the number of hybrids planted.
+     */
+    int exchange(const std::vector<std::pair<int, int>>& pairs, int crosses, int max_order, std::uint64_t seed) {
+        const std::uint32_t generation = static_cast<std::uint32_t>(generation_);
+        const int before = size();
+        for (std::size_t p = 0; p < pairs.size(); ++p) {
+            const int m1 = pairs[p].first, m2 = pairs[p].second;
+            const std::uint32_t n1 = rows_before(m1, before);
+            const std::uint32_t n2 = rows_before(m2, before);
+            if (n1 == 0 || n2 == 0) continue;
+            PhiloxStream rng(seed, generation, static_cast<std::uint32_t>(p), RandomOperator::Hybrid);
+            for (int c = 0; c < crosses; ++c) {
+                // plant may reallocate the lists, so index them afresh
+                const int a = membrane_rows_[m1][rng.below(n1)];
+                const int b = membrane_rows_[m2][rng.below(n2)];
+                const TreeId hybrid = operators_.crossover(tree_[a], tree_[b], max_order, rng);
+                plant(hybrid, rng.below(2) == 0 ? m1 : m2, tree_[a], tree_[b]);
+            }
+        }
+        return size() - before;
+    }
+
+    // Consecutive pairs of the sorted membrane ids, closed into a ring
+    std::vector<std::pair<int, int>> ring_pairs() const {
+        const std::vector<int> ids = membrane_ids();
+        std::vector<std::pair<int, int>> pairs;
+        if (ids.size() < 2) return pairs;
+        for (std::size_t k = 0; k < ids.size(); ++k) pairs.emplace_back(ids[k], ids[(k + 1) % ids.size()]);
+        if (ids.size() == 2) pairs.pop_back();
+        return pairs;
+    }
+
+    // prune_garden!: drop rows with fitness < threshold; returns how many
+    int prune(double threshold) {
+        return compact([&](int r) { return fitness_[r] >= threshold; });
+    }
+
+    /**
+     * Stable in-place removal of rows where keep(r) is false. Returns the
+     * number removed.
+     */
+    template <class Keep>
+    int compact(Keep keep) {
+        const int n = size();
+        remap_.resize(n);
+        int w = 0, first_removed = n;
+        for (int r = 0; r < n; ++r) {
+            if (!keep(r)) {
+                remap_[r] = -1;
+                first_removed = std::min(first_removed, r);
+                continue;
+            }
+            remap_[r] = w;
+            if (w != r) {
+                tree_[w] = tree_[r];
+                membrane_[w] = membrane_[r];
+                fitness_[w] = fitness_[r];
+                age_[w] = age_[r];
+                mutations_[w] = mutations_[r];
+                energy_[w] = energy_[r];
+                reservoir_[w] = reservoir_[r];
+                parent_a_[w] = parent_a_[r];
+                parent_b_[w] = parent_b_[r];
+            }
+            ++w;
+        }
+        if (w == n) return 0;
+        resize(w);
+
+        for (auto it = membrane_rows_.begin(); it != membrane_rows_.end();) {
+            std::vector<int>& rows = it->second;
+            auto from = std::lower_bound(rows.begin(), rows.end(), first_removed);
+            auto out = from;
+            for (auto in = from; in != rows.end(); ++in) {
+                if (remap_[*in] >= 0) *out++ = remap_[*in];
+            }
+            rows.erase(out, rows.end());
+            it = rows.empty() ? membrane_rows_.erase(it) : std::next(it);
+        }
+        return n - w;
+    }
+
+    // Accessors
+
+    int size() const { return static_cast<int>(tree_.size()); }
+    int generation() const { return generation_; }
+    TreeArena& arena() { return arena_; }
+
+    const std::vector<TreeId>& trees() const { return tree_; }
+    const std::vector<int>& membranes() const { return membrane_; }
+    const std::vector<double>& fitness() const { return fitness_; }
+    const std::vector<int>& ages() const { return age_; }
+    const std::vector<int>& mutations() const { return mutations_; }
+    const std::vector<double>& energy() const { return energy_; }
+    const std::vector<double>& reservoir_performance() const { return reservoir_; }
+    const std::vector<TreeId>& parent_a() const { return parent_a_; }
+    const std::vector<TreeId>& parent_b() const { return parent_b_; }
+
+    // Rows of a membrane, ascending (empty if it has none)
+    const std::vector<int>& membrane_rows(int membrane) const {
+        static const std::vector<int> none;
+        auto it = membrane_rows_.find(membrane);
+        return it == membrane_rows_.end() ? none : it->second;
+    }
+
+    const std::unordered_map<int, std::vector<int>>& membrane_index() const { return membrane_rows_; }
+
+    std::vector<int> membrane_ids() const {
+        std::vector<int> ids;
+        ids.reserve(membrane_rows_.size());
+        for (const auto& entry : membrane_rows_) ids.push_back(entry.first);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    // Checkpoints (the arena is saved separately)
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<std::int64_t>(prefix + "meta", {generation_});
+        writer.add(prefix + "tree", tree_);
+        writer.add(prefix + "membrane", membrane_);
+        writer.add(prefix + "fitness", fitness_);
+        writer.add(prefix + "age", age_);
+        writer.add(prefix + "mutations", mutations_);
+        writer.add(prefix + "energy", energy_);
+        writer.add(prefix + "reservoir", reservoir_);
+        writer.add(prefix + "parent_a", parent_a_);
+        writer.add(prefix + "parent_b", parent_b_);
+    }
+
+    // Replaces every row; membrane lists are rebuilt in one pass
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto tree = reader.column<TreeId>(prefix + "tree");
+        const std::size_t n = tree.size;
+        for (TreeId t : tree) {
+            if (t < 0 || t >= static_cast<TreeId>(arena_.size())) {
+                throw std::runtime_error("Invalid tree id: " + std::to_string(t));
+            }
+        }
+        tree_ = tree.to_vector();
+        membrane_ = reader.column<int>(prefix + "membrane", n).to_vector();
+        fitness_ = reader.column<double>(prefix + "fitness", n).to_vector();
+        age_ = reader.column<int>(prefix + "age", n).to_vector();
+        mutations_ = reader.column<int>(prefix + "mutations", n).to_vector();
+        energy_ = reader.column<double>(prefix + "energy", n).to_vector();
+        reservoir_ = reader.column<double>(prefix + "reservoir", n).to_vector();
+        parent_a_ = reader.column<TreeId>(prefix + "parent_a", n).to_vector();
+        parent_b_ = reader.column<TreeId>(prefix + "parent_b", n).to_vector();
+        generation_ = static_cast<int>(reader.column<std::int64_t>(prefix + "meta", 1)[0]);
+        membrane_rows_.clear();
+        for (int r = 0; r < size(); ++r) membrane_rows_[membrane_[r]].push_back(r);
+    }
+
+    double mean_fitness() const {
+        if (fitness_.empty()) return 0.0;
+        double s = 0.0;
+        for (double f : fitness_) s += f;
+        return s / fitness_.size();
+    }
+
+private:
+    // One pending offspring of grow_membranes; b < 0 means a mutation of a
+    struct Breeding {
+        int a;
+        int b;
+        PhiloxStream rng;
+    };
+
+    struct MembranePlan {
+        const std::vector<int>* rows = nullptr;
+        std::vector<double> values;
+        std::vector<int> selected;
+        std::vector<Breeding> breeding;
+    };
+
+    void score_row(int r, double reservoir_fitness, double jsurface_fitness) {
+        const double structure_fitness = 1.0 / (1.0 + arena_.order(tree_[r]));
+        const double age_bonus = std::min(age_[r] * 0.01, 0.2);
+        fitness_[r] = 0.3 * structure_fitness + 0.4 * reservoir_fitness + 0.2 * jsurface_fitness + 0.1 * age_bonus;
+        reservoir_[r] = reservoir_fitness;
+        energy_[r] = jsurface_fitness;
+        ++age_[r];
+    }
+
+    // Type-7 quantile of a non-empty vector, reordering it
+    static double select_quantile(std::vector<double>& values, double q) {
+        const std::size_t n = values.size();
+        const double h = (n - 1) * q;
+        const std::size_t lo = static_cast<std::size_t>(std::floor(h));
+        std::nth_element(values.begin(), values.begin() + lo, values.end());
+        const double a = values[lo];
+        if (lo + 1 >= n) return a;
+        const double b = *std::min_element(values.begin() + lo + 1, values.end());
+        return a + (h - lo) * (b - a);
+    }
+
+    std::uint32_t rows_before(int membrane, int row) const {
+        const std::vector<int>& rows = membrane_rows(membrane);
+        return static_cast<std::uint32_t>(std::lower_bound(rows.begin(), rows.end(), row) - rows.begin());
+    }
+
+    void resize(int n) {
+        tree_.resize(n);
+        membrane_.resize(n);
+        fitness_.resize(n);
+        age_.resize(n);
+        mutations_.resize(n);
+        energy_.resize(n);
+        reservoir_.resize(n);
+        parent_a_.resize(n);
+        parent_b_.resize(n);
+    }
+
+    TreeArena& arena_;
+    TreeOperators operators_;
+    int generation_ = 0;
+
+    std::vector<TreeId> tree_;
+    std::vector<int> membrane_;
+    std::vector<double> fitness_;
+    std::vector<int> age_;
+    std::vector<int> mutations_;
+    std::vector<double> energy_;
+    std::vector<double> reservoir_;
+    std::vector<TreeId> parent_a_;
+    std::vector<TreeId> parent_b_;
+    std::unordered_map<int, std::vector<int>> membrane_rows_;
+
+    std::vector<double> scratch_;
+    std::vector<int> selected_;
+    std::vector<int> remap_;
+    std::vector<MembranePlan> plans_;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,173 @@
+/**
+ * gradient_service.hpp
+ *
+ * Gradients of scalar losses L(c) over B-series coefficient vectors.
+ *
+ * A loss is any functor with
+ *
+ *     template <class Scalar>
+ *     Scalar operator()(const Scalar* c) const;
+ *
+ * instantiated on double (values and finite differences) and on AdjointVar
+ * (reverse mode). GradientService offers
+ *
+ *   - forward / central finite differences, with the n (or 2n) probes
+ *     spread over the bridge executor. Each worker perturbs one coordinate
+ *     of its own copy of c and restores it, so probes allocate nothing;
+ *   - reverse-mode AD on a reusable tape, costing a small constant multiple
+ *     of one loss evaluation regardless of n.
+ */
+
+#pragma once
+
+#include "adjoint.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * LossKernel
+ *
+ * Type-erased scalar loss of fixed dimension.
+ */
+class LossKernel {
+public:
+    explicit LossKernel(int dim, std::string name = "loss")
+        : dim_(dim), name_(std::move(name)) {}
+
+    virtual ~LossKernel() = default;
+
+    int dim() const { return dim_; }
+    const std::string& name() const { return name_; }
+
+    virtual double eval(const double* c) const = 0;
+    virtual AdjointVar eval(const AdjointVar* c) const = 0;
+
+private:
+    int dim_;
+    std::string name_;
+};
+
+template <class F>
+class FunctorLoss final : public LossKernel {
+public:
+    FunctorLoss(F f, int dim, std::string name)
+        : LossKernel(dim, std::move(name)), f_(std::move(f)) {}
+
+    double eval(const double* c) const override { return f_(c); }
+    AdjointVar eval(const AdjointVar* c) const override { return f_(c); }
+
+private:
+    F f_;
+};
+
+template <class F>
+std::shared_ptr<LossKernel> make_loss_kernel(F f, int dim, std::string name = "loss") {
+    return std::make_shared<FunctorLoss<F>>(std::move(f), dim, std::move(name));
+}
+
+enum class GradientMethod {
+    ForwardDifference,
+    CentralDifference,
+    Reverse
+};
+
+inline GradientMethod parse_gradient_method(const std::string& name) {
+    if (name == "forward") return GradientMethod::ForwardDifference;
+    if (name == "central") return GradientMethod::CentralDifference;
+    if (name == "reverse") return GradientMethod::Reverse;
+    throw std::runtime_error("Unknown gradient method: " + name);
+}
+
+/**
+ * GradientService
+ */
+class GradientService {
+public:
+    GradientService(std::shared_ptr<const LossKernel> loss, int num_workers)
+        : loss_(std::move(loss)) {
+        if (!loss_) {
+            throw std::runtime_error("GradientService requires a loss");
+        }
+        const int n = loss_->dim();
+        // One probe buffer per worker plus one for the calling thread
+        probes_.assign(std::max(num_workers, 1) + 1, std::vector<double>(n));
+        inputs_.resize(n);
+    }
+
+    /**
+     * Writes ∇L(c) into grad and returns L(c). The relative step is
+     * h_i = step · max(1, |c_i|).
+     */
+    double gradient(tf::Executor& executor, const double* c, double* grad,
+                    GradientMethod method, double step = 0.0) {
+        if (method == GradientMethod::Reverse) return reverse(c, grad);
+        if (executor.num_workers() + 1 > probes_.size()) {
+            throw std::runtime_error("GradientService was built for fewer workers than the executor has");
+        }
+
+        const int n = dim();
+        const bool central = method == GradientMethod::CentralDifference;
+        if (step <= 0.0) step = central ? 6e-6 : 1.5e-8;
+
+        for (auto& probe : probes_) std::copy(c, c + n, probe.begin());
+        const double f0 = loss_->eval(c);
+        loss_evaluations_ += 1 + (central ? 2 : 1) * static_cast<std::uint64_t>(n);
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, n, 1, [&, central, step, f0](int i) {
+            std::vector<double>& x = probes_[executor.this_worker_id() + 1];
+            const double h = step * std::max(1.0, std::abs(c[i]));
+            x[i] = c[i] + h;
+            const double f_plus = loss_->eval(x.data());
+            if (central) {
+                x[i] = c[i] - h;
+                const double f_minus = loss_->eval(x.data());
+                grad[i] = (f_plus - f_minus) / (2.0 * h);
+            } else {
+                grad[i] = (f_plus - f0) / h;
+            }
+            x[i] = c[i];
+        });
+        executor.run(taskflow).wait();
+        return f0;
+    }
+
+    // Reverse-mode AD: one recorded evaluation and one backward sweep
+    double reverse(const double* c, double* grad) {
+        const int n = dim();
+        AdjointTapeScope scope(tape_);
+        tape_.clear();
+        for (int i = 0; i < n; ++i) inputs_[i] = AdjointVar(c[i], tape_.variable());
+
+        const AdjointVar out = loss_->eval(inputs_.data());
+        tape_.backpropagate(out.id);
+        for (int i = 0; i < n; ++i) grad[i] = tape_.adjoint(inputs_[i].id);
+
+        ++loss_evaluations_;
+        return out.value;
+    }
+
+    int dim() const { return loss_->dim(); }
+    std::uint64_t loss_evaluations() const { return loss_evaluations_; }
+    std::size_t tape_size() const { return tape_.size(); }
+
+private:
+    std::shared_ptr<const LossKernel> loss_;
+    std::vector<std::vector<double>> probes_;
+    AdjointTape tape_;
+    std::vector<AdjointVar> inputs_;
+    std::uint64_t loss_evaluations_ = 0;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,245 @@
+/**
+ * hyper_dual.hpp
+ *
+ * Forward-mode hyper-dual numbers with K independent nilpotent directions.
+ *
+ * A HyperDual<K> holds 2^K coefficients indexed by subsets of {ε₁, ..., ε_K}
+ * (bit j of the index set <=> ε_{j+1} present), with ε_j² = 0. Evaluating a
+ * vector field at y + Σ ε_j v_j and reading the coefficient of ε₁ε₂···ε_K
+ * yields the exact mixed derivative f^(K)(y)[v₁, ..., v_K], which is the
+ * building block of the elementary differentials F(τ).
+ */
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace taskflow_bridge {
+
+template <int K, class T = double>
+struct HyperDual {
+    static_assert(K >= 0 && K <= 12, "HyperDual supports up to 12 directions");
+
+    static constexpr std::size_t num_components = std::size_t(1) << K;
+
+    std::array<T, num_components> c{};
+
+    HyperDual() = default;
+
+    HyperDual(T value) {
+        c[0] = value;
+    }
+
+    T value() const { return c[0]; }
+
+    // Coefficient of the product of all K directions
+    T top() const { return c[num_components - 1]; }
+
+    void seed(int direction, T value) {
+        c[std::size_t(1) << direction] = value;
+    }
+
+    HyperDual& operator+=(const HyperDual& o) {
+        for (std::size_t s = 0; s < num_components; ++s) c[s] += o.c[s];
+        return *this;
+    }
+
+    HyperDual& operator-=(const HyperDual& o) {
+        for (std::size_t s = 0; s < num_components; ++s) c[s] -= o.c[s];
+        return *this;
+    }
+
+    HyperDual& operator*=(const HyperDual& o) {
+        *this = *this * o;
+        return *this;
+    }
+
+    HyperDual& operator/=(const HyperDual& o) {
+        *this = *this / o;
+        return *this;
+    }
+
+    HyperDual& operator+=(T v) { c[0] += v; return *this; }
+    HyperDual& operator-=(T v) { c[0] -= v; return *this; }
+
+    HyperDual& operator*=(T v) {
+        for (auto& x : c) x *= v;
+        return *this;
+    }
+
+    HyperDual& operator/=(T v) {
+        for (auto& x : c) x /= v;
+        return *this;
+    }
+
+    HyperDual operator-() const {
+        HyperDual r;
+        for (std::size_t s = 0; s < num_components; ++s) r.c[s] = -c[s];
+        return r;
+    }
+
+    // Subset convolution: (ab)[S] = Σ_{A ⊆ S} a[A] b[S \ A]
+    friend HyperDual operator*(const HyperDual& a, const HyperDual& b) {
+        HyperDual r;
+        for (std::size_t s = 0; s < num_components; ++s) {
+            T acc = a.c[0] * b.c[s];
+            for (std::size_t sub = s; sub != 0; sub = (sub - 1) & s) {
+                acc += a.c[sub] * b.c[s ^ sub];
+            }
+            r.c[s] = acc;
+        }
+        return r;
+    }
+
+    friend HyperDual operator/(const HyperDual& a, const HyperDual& b) {
+        return a * reciprocal(b);
+    }
+
+    friend HyperDual operator+(HyperDual a, const HyperDual& b) { return a += b; }
+    friend HyperDual operator-(HyperDual a, const HyperDual& b) { return a -= b; }
+    friend HyperDual operator+(HyperDual a, T v) { return a += v; }
+    friend HyperDual operator+(T v, HyperDual a) { return a += v; }
+    friend HyperDual operator-(HyperDual a, T v) { return a -= v; }
+    friend HyperDual operator-(T v, const HyperDual& a) { return (-a) += v; }
+    friend HyperDual operator*(HyperDual a, T v) { return a *= v; }
+    friend HyperDual operator*(T v, HyperDual a) { return a *= v; }
+    friend HyperDual operator/(HyperDual a, T v) { return a /= v; }
+    friend HyperDual operator/(T v, const HyperDual& a) { return reciprocal(a) *= v; }
+
+    // Branching in kernels follows the real part
+    friend bool operator<(const HyperDual& a, const HyperDual& b) { return a.c[0] < b.c[0]; }
+    friend bool operator>(const HyperDual& a, const HyperDual& b) { return a.c[0] > b.c[0]; }
+    friend bool operator<=(const HyperDual& a, const HyperDual& b) { return a.c[0] <= b.c[0]; }
+    friend bool operator>=(const HyperDual& a, const HyperDual& b) { return a.c[0] >= b.c[0]; }
+    friend bool operator<(const HyperDual& a, T v) { return a.c[0] < v; }
+    friend bool operator>(const HyperDual& a, T v) { return a.c[0] > v; }
+};
+
+/**
+ * Apply a scalar function g through its Taylor coefficients
+ * taylor[k] = g^(k)(x₀) / k!, k = 0..K. Since the nilpotent part
+ * δ = x - x₀ satisfies δ^(K+1) = 0, the series is exact.
+ */
+template <int K, class T>
+HyperDual<K, T> compose(const HyperDual<K, T>& x, const std::array<T, K + 1>& taylor) {
+    HyperDual<K, T> delta = x;
+    delta.c[0] = T(0);
+
+    HyperDual<K, T> result(taylor[0]);
+    HyperDual<K, T> power = delta;
+    for (int k = 1; k <= K; ++k) {
+        for (std::size_t s = 0; s < HyperDual<K, T>::num_components; ++s) {
+            result.c[s] += taylor[k] * power.c[s];
+        }
+        if (k < K) power = power * delta;
+    }
+    return result;
+}
+
+template <int K, class T>
+HyperDual<K, T> reciprocal(const HyperDual<K, T>& x) {
+    std::array<T, K + 1> taylor;
+    T inv = T(1) / x.c[0];
+    T term = inv;
+    for (int k = 0; k <= K; ++k) {
+        taylor[k] = term;
+        term *= -inv;
+    }
+    return compose(x, taylor);
+}
+
+template <int K, class T>
+HyperDual<K, T> exp(const HyperDual<K, T>& x) {
+    using std::exp;
+    std::array<T, K + 1> taylor;
+    T e = exp(x.c[0]);
+    T factorial = T(1);
+    for (int k = 0; k <= K; ++k) {
+        if (k > 0) factorial *= T(k);
+        taylor[k] = e / factorial;
+    }
+    return compose(x, taylor);
+}
+
+template <int K, class T>
+HyperDual<K, T> log(const HyperDual<K, T>& x) {
+    using std::log;
+    std::array<T, K + 1> taylor;
+    taylor[0] = log(x.c[0]);
+    T inv = T(1) / x.c[0];
+    T power = T(1);
+    for (int k = 1; k <= K; ++k) {
+        power *= inv;
+        taylor[k] = ((k % 2) ? power : -power) / T(k);
+    }
+    return compose(x, taylor);
+}
+
+template <int K, class T>
+HyperDual<K, T> sin(const HyperDual<K, T>& x) {
+    using std::sin;
+    using std::cos;
+    std::array<T, K + 1> taylor;
+    const T s = sin(x.c[0]);
+    const T co = cos(x.c[0]);
+    const T cycle[4] = {s, co, -s, -co};
+    T factorial = T(1);
+    for (int k = 0; k <= K; ++k) {
+        if (k > 0) factorial *= T(k);
+        taylor[k] = cycle[k % 4] / factorial;
+    }
+    return compose(x, taylor);
+}
+
+template <int K, class T>
+HyperDual<K, T> cos(const HyperDual<K, T>& x) {
+    using std::sin;
+    using std::cos;
+    std::array<T, K + 1> taylor;
+    const T s = sin(x.c[0]);
+    const T co = cos(x.c[0]);
+    const T cycle[4] = {co, -s, -co, s};
+    T factorial = T(1);
+    for (int k = 0; k <= K; ++k) {
+        if (k > 0) factorial *= T(k);
+        taylor[k] = cycle[k % 4] / factorial;
+    }
+    return compose(x, taylor);
+}
+
+// x^r for real r via the generalized binomial series
+template <int K, class T>
+HyperDual<K, T> pow(const HyperDual<K, T>& x, double r) {
+    using std::pow;
+    std::array<T, K + 1> taylor;
+    T binom = T(1);
+    for (int k = 0; k <= K; ++k) {
+        if (k > 0) binom *= (T(r) - T(k - 1)) / T(k);
+        taylor[k] = binom * pow(x.c[0], T(r) - T(k));
+    }
+    return compose(x, taylor);
+}
+
+template <int K, class T>
+HyperDual<K, T> sqrt(const HyperDual<K, T>& x) {
+    return pow(x, 0.5);
+}
+
+// Taylor coefficients from y' = 1 - y²: (k+1) a_{k+1} = [k = 0] - Σ a_i a_{k-i},
+// starting at a_0 = tanh(x₀), so saturated arguments stay finite
+template <int K, class T>
+HyperDual<K, T> tanh(const HyperDual<K, T>& x) {
+    using std::tanh;
+    std::array<T, K + 1> taylor;
+    taylor[0] = tanh(x.c[0]);
+    for (int k = 0; k < K; ++k) {
+        T square = T(0);
+        for (int i = 0; i <= k; ++i) square += taylor[i] * taylor[k - i];
+        taylor[k + 1] = ((k == 0 ? T(1) : T(0)) - square) / T(k + 1);
+    }
+    return compose(x, taylor);
+}
+
+} // namespace taskflow_bridge
@@ -0,0 +1,465 @@
+/**
+ * island_model.hpp
+ *
+ * Island-model evolution across local processes.
+ *
+ * An IslandSegment is one POSIX shared-memory object. It holds a header, a
+ * status slot per island, and one single-producer / single-consumer ring per
+ * directed migration edge of the topology. Each island runs in its own
+ * process (its own heap and GC) and attaches to the segment by name. Only
+ * island `from` pushes into ring (from → to) and only island `to` pops from
+ * it, so the rings need nothing beyond acquire/release head and tail
+ * counters. A full ring drops the migrant and counts the drop.
+ *
+ * Migrants use the compact genome encoding: fixed-length coefficient rows
+ * (the PopulationStore row layout) plus id, fitness, source island and
+ * generation, copied as raw doubles. No serializer is involved.
+ *
+ * IslandCoordinator creates the segment and launches K worker processes.
+ * Each worker receives the segment name and its island index in the
+ * environment (DTE_ISLAND_SEGMENT, DTE_ISLAND_INDEX).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace taskflow_bridge {
+
+enum class IslandTopology : std::uint32_t {
+    Ring = 0,               // i → i+1
+    BidirectionalRing = 1,  // i → i±1
+    FullyConnected = 2,     // i → j for all j ≠ i
+};
+
+struct Migrant {
+    std::int64_t id;
+    double fitness;
+    std::int32_t source;
+    std::int32_t generation;
+};
+
+namespace detail {
+
+constexpr std::uint64_t kIslandMagic = 0x444554494c534e31ULL;  // "DETISLN1"
+constexpr std::uint32_t kIslandVersion = 1;
+constexpr std::size_t kCacheLine = 64;
+
+constexpr std::size_t align_up(std::size_t n, std::size_t a) { return (n + a - 1) / a * a; }
+
+struct IslandHeader {
+    std::atomic<std::uint64_t> magic;  // published last, with release
+    std::uint32_t version;
+    std::uint32_t num_islands;
+    std::uint32_t genome_length;
+    std::uint32_t ring_capacity;
+    std::uint32_t topology;
+    std::uint32_t interval;
+    std::uint32_t num_edges;
+    std::uint32_t record_size;
+    std::uint64_t total_size;
+};
+
+struct alignas(kCacheLine) IslandStatus {
+    std::atomic<std::int64_t> generation;
+    std::atomic<double> best_fitness;
+    std::atomic<std::uint64_t> sent;
+    std::atomic<std::uint64_t> received;
+    std::atomic<std::uint64_t> dropped;
+};
+
+struct IslandEdge {
+    std::uint32_t from;
+    std::uint32_t to;
+};
+
+struct RingHeader {
+    alignas(kCacheLine) std::atomic<std::uint64_t> head;  // next slot to pop
+    alignas(kCacheLine) std::atomic<std::uint64_t> tail;  // next slot to push
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared-memory rings need lock-free 64-bit atomics");
+static_assert(std::atomic<double>::is_always_lock_free, "shared-memory status needs lock-free double atomics");
+
+inline std::vector<IslandEdge> topology_edges(IslandTopology topology, int k) {
+    std::vector<IslandEdge> edges;
+    if (k < 2) return edges;
+    for (int i = 0; i < k; ++i) {
+        switch (topology) {
+            case IslandTopology::Ring:
+                edges.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>((i + 1) % k)});
+                break;
+            case IslandTopology::BidirectionalRing:
+                edges.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>((i + 1) % k)});
+                if (k > 2) edges.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>((i + k - 1) % k)});
+                break;
+            case IslandTopology::FullyConnected:
+                for (int j = 0; j < k; ++j) {
+                    if (j != i) edges.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j)});
+                }
+                break;
+        }
+    }
+    return edges;
+}
+
+} // namespace detail
+
+/**
+ * IslandSegment
+ *
+ * The creator unlinks the shared-memory name on destruction; attached
+ * mappings stay valid until they are unmapped.
+ */
+class IslandSegment {
+public:
+    static std::shared_ptr<IslandSegment> create(const std::string& name, int num_islands, int genome_length,
+                                                 int ring_capacity, IslandTopology topology, int interval) {
+        if (num_islands < 1 || genome_length < 1 || ring_capacity < 1 || interval < 1) {
+            throw std::runtime_error("Island model needs positive islands, genome length, ring capacity and interval");
+        }
+        if (static_cast<std::uint32_t>(topology) > static_cast<std::uint32_t>(IslandTopology::FullyConnected)) {
+            throw std::runtime_error("Unknown island topology");
+        }
+        const auto edges = detail::topology_edges(topology, num_islands);
+        const Layout layout(num_islands, genome_length, ring_capacity, static_cast<int>(edges.size()));
+
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) fail("Cannot create island segment " + name);
+        if (::ftruncate(fd, static_cast<off_t>(layout.total)) != 0) {
+            const int err = errno;
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            errno = err;
+            fail("Cannot size island segment " + name);
+        }
+        auto segment = std::shared_ptr<IslandSegment>(new IslandSegment(name, fd, layout.total, true));
+
+        auto* h = new (segment->base_) detail::IslandHeader{};
+        h->version = detail::kIslandVersion;
+        h->num_islands = static_cast<std::uint32_t>(num_islands);
+        h->genome_length = static_cast<std::uint32_t>(genome_length);
+        h->ring_capacity = static_cast<std::uint32_t>(ring_capacity);
+        h->topology = static_cast<std::uint32_t>(topology);
+        h->interval = static_cast<std::uint32_t>(interval);
+        h->num_edges = static_cast<std::uint32_t>(edges.size());
+        h->record_size = static_cast<std::uint32_t>(layout.record);
+        h->total_size = layout.total;
+        segment->bind();
+        for (int i = 0; i < num_islands; ++i) {
+            auto* s = new (&segment->status_[i]) detail::IslandStatus;
+            s->generation.store(0);
+            s->best_fitness.store(-std::numeric_limits<double>::infinity());
+            s->sent.store(0);
+            s->received.store(0);
+            s->dropped.store(0);
+        }
+        std::memcpy(segment->edges_, edges.data(), edges.size() * sizeof(detail::IslandEdge));
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            auto* r = new (segment->ring(static_cast<int>(e))) detail::RingHeader;
+            r->head.store(0);
+            r->tail.store(0, std::memory_order_relaxed);
+        }
+        // Attachers acquire the magic, so everything above is visible once they see it
+        h->magic.store(detail::kIslandMagic, std::memory_order_release);
+        return segment;
+    }
+
+    static std::shared_ptr<IslandSegment> attach(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+        if (fd < 0) fail("Cannot open island segment " + name);
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(detail::IslandHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Island segment is truncated: " + name);
+        }
+        auto segment = std::shared_ptr<IslandSegment>(
+            new IslandSegment(name, fd, static_cast<std::size_t>(st.st_size), false));
+        const auto* h = segment->header();
+        if (h->magic.load(std::memory_order_acquire) != detail::kIslandMagic || h->version != detail::kIslandVersion ||
+            h->total_size != static_cast<std::uint64_t>(st.st_size)) {
+            throw std::runtime_error("Not an island segment (or version mismatch): " + name);
+        }
+        segment->bind();
+        return segment;
+    }
+
+    ~IslandSegment() {
+        ::munmap(base_, size_);
+        if (owner_) ::shm_unlink(name_.c_str());
+    }
+
+    IslandSegment(const IslandSegment&) = delete;
+    IslandSegment& operator=(const IslandSegment&) = delete;
+
+    const std::string& name() const { return name_; }
+    int num_islands() const { return static_cast<int>(header()->num_islands); }
+    int genome_length() const { return static_cast<int>(header()->genome_length); }
+    int ring_capacity() const { return static_cast<int>(header()->ring_capacity); }
+    int interval() const { return static_cast<int>(header()->interval); }
+    IslandTopology topology() const { return static_cast<IslandTopology>(header()->topology); }
+    int num_edges() const { return static_cast<int>(header()->num_edges); }
+    const detail::IslandEdge& edge(int e) const { return edges_[e]; }
+
+    detail::IslandStatus& status(int island) {
+        check_island(island);
+        return status_[island];
+    }
+
+    void check_island(int island) const {
+        if (island < 0 || island >= num_islands()) {
+            throw std::runtime_error("Island index out of range: " + std::to_string(island));
+        }
+    }
+
+    // Ring e; records follow the header
+    detail::RingHeader* ring(int e) { return reinterpret_cast<detail::RingHeader*>(rings_ + e * ring_stride_); }
+
+    unsigned char* record(int e, std::uint64_t slot) {
+        return rings_ + e * ring_stride_ + sizeof(detail::RingHeader) +
+               (slot % header()->ring_capacity) * header()->record_size;
+    }
+
+private:
+    struct Layout {
+        Layout(int k, int length, int capacity, int num_edges) {
+            record = detail::align_up(sizeof(Migrant) + length * sizeof(double), 8);
+            status = detail::align_up(sizeof(detail::IslandHeader), detail::kCacheLine);
+            edges = status + k * sizeof(detail::IslandStatus);
+            rings = detail::align_up(edges + num_edges * sizeof(detail::IslandEdge), detail::kCacheLine);
+            stride = detail::align_up(sizeof(detail::RingHeader) + capacity * record, detail::kCacheLine);
+            total = rings + num_edges * stride;
+        }
+        std::size_t record, status, edges, rings, stride, total;
+    };
+
+    IslandSegment(std::string name, int fd, std::size_t size, bool owner)
+        : name_(std::move(name)), size_(size), owner_(owner) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            if (owner) ::shm_unlink(name_.c_str());
+            errno = err;
+            fail("Cannot map island segment " + name_);
+        }
+        base_ = static_cast<unsigned char*>(p);
+    }
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    const detail::IslandHeader* header() const { return reinterpret_cast<const detail::IslandHeader*>(base_); }
+
+    void bind() {
+        const auto* h = header();
+        const Layout layout(h->num_islands, h->genome_length, h->ring_capacity, h->num_edges);
+        status_ = reinterpret_cast<detail::IslandStatus*>(base_ + layout.status);
+        edges_ = reinterpret_cast<detail::IslandEdge*>(base_ + layout.edges);
+        rings_ = base_ + layout.rings;
+        ring_stride_ = layout.stride;
+    }
+
+    std::string name_;
+    unsigned char* base_ = nullptr;
+    std::size_t size_;
+    bool owner_;
+    detail::IslandStatus* status_ = nullptr;
+    detail::IslandEdge* edges_ = nullptr;
+    unsigned char* rings_ = nullptr;
+    std::size_t ring_stride_ = 0;
+};
+
+/**
+ * IslandEndpoint
+ *
+ * One island's view of the segment: its outgoing rings (producer side) and
+ * incoming rings (consumer side). Use one endpoint per island.
+ */
+class IslandEndpoint {
+public:
+    IslandEndpoint(std::shared_ptr<IslandSegment> segment, int island)
+        : segment_(std::move(segment)), island_(island) {
+        segment_->check_island(island);
+        for (int e = 0; e < segment_->num_edges(); ++e) {
+            if (static_cast<int>(segment_->edge(e).from) == island) outgoing_.push_back(e);
+            if (static_cast<int>(segment_->edge(e).to) == island) incoming_.push_back(e);
+        }
+    }
+
+    int island() const { return island_; }
+    IslandSegment& segment() { return *segment_; }
+
+    // Migration happens on generations that are positive multiples of the interval
+    bool should_migrate(std::int64_t generation) const {
+        return generation > 0 && generation % segment_->interval() == 0;
+    }
+
+    /**
+     * Push one migrant to every neighbour. Returns the number of rings that
+     * accepted it.
+     */
+    int emigrate(const double* genome, double fitness, std::int64_t id, int generation) {
+        const Migrant m{id, fitness, island_, generation};
+        const std::size_t bytes = segment_->genome_length() * sizeof(double);
+        const std::uint64_t capacity = segment_->ring_capacity();
+        int sent = 0;
+        for (int e : outgoing_) {
+            auto* r = segment_->ring(e);
+            const std::uint64_t tail = r->tail.load(std::memory_order_relaxed);
+            if (tail - r->head.load(std::memory_order_acquire) == capacity) {
+                segment_->status(island_).dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            unsigned char* rec = segment_->record(e, tail);
+            std::memcpy(rec, &m, sizeof m);
+            std::memcpy(rec + sizeof m, genome, bytes);
+            r->tail.store(tail + 1, std::memory_order_release);
+            ++sent;
+        }
+        segment_->status(island_).sent.fetch_add(sent, std::memory_order_relaxed);
+        return sent;
+    }
+
+    /**
+     * Drain every incoming ring. Migrant headers go to `migrants` and their
+     * genomes are appended row-major to `genomes`. Returns the count.
+     */
+    int immigrate(std::vector<Migrant>& migrants, std::vector<double>& genomes) {
+        const int length = segment_->genome_length();
+        int received = 0;
+        for (int e : incoming_) {
+            auto* r = segment_->ring(e);
+            std::uint64_t head = r->head.load(std::memory_order_relaxed);
+            const std::uint64_t tail = r->tail.load(std::memory_order_acquire);
+            for (; head != tail; ++head) {
+                const unsigned char* rec = segment_->record(e, head);
+                Migrant m;
+                std::memcpy(&m, rec, sizeof m);
+                migrants.push_back(m);
+                const std::size_t at = genomes.size();
+                genomes.resize(at + length);
+                std::memcpy(genomes.data() + at, rec + sizeof m, length * sizeof(double));
+                ++received;
+            }
+            r->head.store(head, std::memory_order_release);
+        }
+        segment_->status(island_).received.fetch_add(received, std::memory_order_relaxed);
+        return received;
+    }
+
+    // Progress visible to the coordinator
+    void report(std::int64_t generation, double best_fitness) {
+        auto& s = segment_->status(island_);
+        s.generation.store(generation, std::memory_order_relaxed);
+        s.best_fitness.store(best_fitness, std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_ptr<IslandSegment> segment_;
+    int island_;
+    std::vector<int> outgoing_;
+    std::vector<int> incoming_;
+};
+
+/**
+ * IslandCoordinator
+ *
+ * Owns the segment and the worker processes. The destructor terminates and
+ * reaps workers that are still running.
+ */
+class IslandCoordinator {
+public:
+    IslandCoordinator(const std::string& name, int num_islands, int genome_length, int ring_capacity,
+                      IslandTopology topology, int interval)
+        : segment_(IslandSegment::create(name, num_islands, genome_length, ring_capacity, topology, interval)) {}
+
+    ~IslandCoordinator() {
+        terminate();
+        wait();
+    }
+
+    IslandCoordinator(const IslandCoordinator&) = delete;
+    IslandCoordinator& operator=(const IslandCoordinator&) = delete;
+
+    const std::shared_ptr<IslandSegment>& segment() const { return segment_; }
+
+    // Spawn argv once per island (argv[0] is looked up in PATH)
+    void launch(const std::vector<std::string>& argv) {
+        if (argv.empty()) {
+            throw std::runtime_error("Island launch needs a command");
+        }
+        if (!pids_.empty()) {
+            throw std::runtime_error("Islands already launched");
+        }
+        std::vector<char*> args;
+        for (const auto& a : argv) args.push_back(const_cast<char*>(a.c_str()));
+        args.push_back(nullptr);
+
+        for (int i = 0; i < segment_->num_islands(); ++i) {
+            std::vector<std::string> env_strings = {"DTE_ISLAND_SEGMENT=" + segment_->name(),
+                                                    "DTE_ISLAND_INDEX=" + std::to_string(i)};
+            std::vector<char*> env;
+            for (char** e = environ; *e; ++e) {
+                if (std::strncmp(*e, "DTE_ISLAND_", 11) != 0) env.push_back(*e);
+            }
+            for (auto& s : env_strings) env.push_back(const_cast<char*>(s.c_str()));
+            env.push_back(nullptr);
+
+            pid_t pid = 0;
+            const int rc = ::posix_spawnp(&pid, args[0], nullptr, nullptr, args.data(), env.data());
+            if (rc != 0) {
+                terminate();
+                wait();
+                throw std::runtime_error("Cannot launch island " + std::to_string(i) + ": " + std::strerror(rc));
+            }
+            pids_.push_back(pid);
+        }
+    }
+
+    // Blocks until every worker exits; exit status per island (-signal if killed)
+    std::vector<int> wait() {
+        std::vector<int> codes;
+        for (pid_t pid : pids_) {
+            int status = 0;
+            while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            codes.push_back(WIFEXITED(status) ? WEXITSTATUS(status) : -WTERMSIG(status));
+        }
+        pids_.clear();
+        return codes;
+    }
+
+    void terminate() {
+        for (pid_t pid : pids_) ::kill(pid, SIGTERM);
+    }
+
+    int num_running() const { return static_cast<int>(pids_.size()); }
+
+private:
+    std::shared_ptr<IslandSegment> segment_;
+    std::vector<pid_t> pids_;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,286 @@
+/**
+ * lineage_log.hpp
+ *
+ * Append-only genealogy of individuals.
+ *
+ * PlantedTree.parent_trees copies both parents' level sequences into every
+ * child, and tree_lineage / BSeriesGenome.parents keep one dictionary entry
+ * or uuid string per parent. LineageLog instead records one fixed-size entry
+ * per birth: (child id, parent a, parent b, operator, generation), in
+ * parallel columns. Recording costs the same at any depth and no genome is
+ * ever copied.
+ *
+ * Parent links are stored once. Children are found through intrusive lists:
+ * first_child_[r] heads a chain of (child row, parent slot) links threaded
+ * through next_child_. Ancestor and descendant queries are then breadth-first
+ * walks over rows, with an epoch-stamped visited column instead of a set.
+ *
+ * prune() drops extinct branches. Only the living individuals (plus
+ * optionally the last few generations) and everything they descend from
+ * are kept. Every kept entry therefore still has its recorded parents.
+ *
+ * Ids are IndividualIds as issued by PopulationStore / SteadyStateEngine.
+ * Parents that were never recorded (kNoParent, or founders logged
+ * elsewhere) end a walk. The log has a single writer and is not
+ * synchronised.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+#include "population_store.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace taskflow_bridge {
+
+enum class LineageOperator : std::uint8_t {
+    Seed = 0,
+    Mutation = 1,
+    Crossover = 2,
+    Hybrid = 3,
+    Migration = 4,
+};
+
+/**
+ * LineageLog
+ */
+class LineageLog {
+public:
+    // Returns the entry's row; ids may be recorded once only
+    int record(IndividualId child, IndividualId parent_a, IndividualId parent_b, LineageOperator op, int generation) {
+        if (child < 0) {
+            throw std::runtime_error("Invalid individual id: " + std::to_string(child));
+        }
+        if (op > LineageOperator::Migration) {
+            throw std::runtime_error("Unknown lineage operator: " + std::to_string(static_cast<int>(op)));
+        }
+        const int r = size();
+        if (!row_.emplace(child, r).second) {
+            throw std::runtime_error("Individual already recorded: " + std::to_string(child));
+        }
+        child_.push_back(child);
+        parent_a_.push_back(parent_a);
+        parent_b_.push_back(parent_b);
+        op_.push_back(op);
+        generation_.push_back(generation);
+        first_child_.push_back(-1);
+        next_child_.push_back(-1);
+        next_child_.push_back(-1);
+        mark_.push_back(0);
+        link(r);
+        latest_generation_ = std::max(latest_generation_, generation);
+        ++recorded_;
+        return r;
+    }
+
+    // Recorded ancestors, nearest first; max_depth < 0 walks to the founders
+    std::vector<IndividualId> ancestors(IndividualId id, int max_depth = -1) {
+        std::vector<IndividualId> out;
+        walk(id, max_depth, out, [&](int r, auto&& visit) {
+            visit(parent_a_[r]);
+            visit(parent_b_[r]);
+        });
+        return out;
+    }
+
+    // Recorded descendants, nearest first
+    std::vector<IndividualId> descendants(IndividualId id, int max_depth = -1) {
+        std::vector<IndividualId> out;
+        walk(id, max_depth, out, [&](int r, auto&& visit) {
+            for (int e = first_child_[r]; e >= 0; e = next_child_[e]) visit(child_[e >> 1]);
+        });
+        return out;
+    }
+
+    /**
+     * Drop every entry that is not a living individual, not within the last
+     * keep_generations generations, and not an ancestor of either. Kept
+     * entries stay in recording order. Returns the number removed.
+     */
+    int prune(const IndividualId* living, int num_living, int keep_generations = 0) {
+        const int n = size();
+        const std::uint32_t epoch = next_epoch();
+        queue_.clear();
+        auto keep = [&](int r) {
+            if (r >= 0 && mark_[r] != epoch) {
+                mark_[r] = epoch;
+                queue_.push_back(r);
+            }
+        };
+        for (int k = 0; k < num_living; ++k) keep(find_row(living[k]));
+        if (keep_generations > 0) {
+            for (int r = 0; r < n; ++r) {
+                if (generation_[r] > latest_generation_ - keep_generations) keep(r);
+            }
+        }
+        for (std::size_t q = 0; q < queue_.size(); ++q) {
+            const int r = queue_[q];
+            keep(find_row(parent_a_[r]));
+            keep(find_row(parent_b_[r]));
+        }
+        if (static_cast<int>(queue_.size()) == n) return 0;
+
+        int w = 0;
+        for (int r = 0; r < n; ++r) {
+            if (mark_[r] != epoch) continue;
+            child_[w] = child_[r];
+            parent_a_[w] = parent_a_[r];
+            parent_b_[w] = parent_b_[r];
+            op_[w] = op_[r];
+            generation_[w] = generation_[r];
+            ++w;
+        }
+        child_.resize(w);
+        parent_a_.resize(w);
+        parent_b_.resize(w);
+        op_.resize(w);
+        generation_.resize(w);
+        first_child_.assign(w, -1);
+        next_child_.assign(2 * w, -1);
+        mark_.assign(w, 0);
+        epoch_ = 0;
+        row_.clear();
+        for (int r = 0; r < w; ++r) row_.emplace(child_[r], r);
+        for (int r = 0; r < w; ++r) link(r);
+
+        pruned_ += n - w;
+        return n - w;
+    }
+
+    // Row of a recorded id, or -1
+    int find_row(IndividualId id) const {
+        auto it = row_.find(id);
+        return it == row_.end() ? -1 : it->second;
+    }
+
+    bool contains(IndividualId id) const { return row_.count(id) != 0; }
+
+    void reserve(int n) {
+        child_.reserve(n);
+        parent_a_.reserve(n);
+        parent_b_.reserve(n);
+        op_.reserve(n);
+        generation_.reserve(n);
+        first_child_.reserve(n);
+        next_child_.reserve(2 * n);
+        mark_.reserve(n);
+        row_.reserve(n);
+    }
+
+    // Checkpoints; child links and the id index are rebuilt on restore
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<std::int64_t>(prefix + "meta", {latest_generation_, static_cast<std::int64_t>(recorded_),
+                                                          static_cast<std::int64_t>(pruned_)});
+        writer.add(prefix + "child", child_);
+        writer.add(prefix + "parent_a", parent_a_);
+        writer.add(prefix + "parent_b", parent_b_);
+        writer.add(prefix + "operator", reinterpret_cast<const std::uint8_t*>(op_.data()), op_.size());
+        writer.add(prefix + "generation", generation_);
+    }
+
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto child = reader.column<IndividualId>(prefix + "child");
+        const auto parent_a = reader.column<IndividualId>(prefix + "parent_a", child.size);
+        const auto parent_b = reader.column<IndividualId>(prefix + "parent_b", child.size);
+        const auto op = reader.column<std::uint8_t>(prefix + "operator", child.size);
+        const auto generation = reader.column<int>(prefix + "generation", child.size);
+        const auto meta = reader.column<std::int64_t>(prefix + "meta", 3);
+        *this = LineageLog();
+        reserve(static_cast<int>(child.size));
+        for (std::size_t k = 0; k < child.size; ++k) {
+            record(child[k], parent_a[k], parent_b[k], static_cast<LineageOperator>(op[k]), generation[k]);
+        }
+        latest_generation_ = static_cast<int>(meta[0]);
+        recorded_ = static_cast<std::uint64_t>(meta[1]);
+        pruned_ = static_cast<std::uint64_t>(meta[2]);
+    }
+
+    // Accessors
+
+    int size() const { return static_cast<int>(child_.size()); }
+    int latest_generation() const { return latest_generation_; }
+    std::uint64_t recorded() const { return recorded_; }
+    std::uint64_t pruned() const { return pruned_; }
+
+    const std::vector<IndividualId>& children() const { return child_; }
+    const std::vector<IndividualId>& parent_a() const { return parent_a_; }
+    const std::vector<IndividualId>& parent_b() const { return parent_b_; }
+    const std::vector<LineageOperator>& operators() const { return op_; }
+    const std::vector<int>& generations() const { return generation_; }
+
+private:
+    // Thread row r onto the child lists of its recorded parents
+    void link(int r) {
+        const int pa = find_row(parent_a_[r]);
+        const int pb = parent_b_[r] == parent_a_[r] ? -1 : find_row(parent_b_[r]);
+        if (pa >= 0) {
+            next_child_[2 * r] = first_child_[pa];
+            first_child_[pa] = 2 * r;
+        }
+        if (pb >= 0) {
+            next_child_[2 * r + 1] = first_child_[pb];
+            first_child_[pb] = 2 * r + 1;
+        }
+    }
+
+    std::uint32_t next_epoch() {
+        if (++epoch_ == 0) {
+            std::fill(mark_.begin(), mark_.end(), 0);
+            epoch_ = 1;
+        }
+        return epoch_;
+    }
+
+    // Breadth-first from id over neighbours(r, visit); appends visited ids
+    template <class Neighbours>
+    void walk(IndividualId id, int max_depth, std::vector<IndividualId>& out, Neighbours neighbours) {
+        const int start = find_row(id);
+        if (start < 0) {
+            throw std::runtime_error("Individual not recorded: " + std::to_string(id));
+        }
+        const std::uint32_t epoch = next_epoch();
+        mark_[start] = epoch;
+        queue_.assign(1, start);
+        std::size_t level_end = 1;
+        int depth = 0;
+        for (std::size_t q = 0; q < queue_.size() && (max_depth < 0 || depth < max_depth); ++q) {
+            neighbours(queue_[q], [&](IndividualId next) {
+                const int r = find_row(next);
+                if (r < 0 || mark_[r] == epoch) return;
+                mark_[r] = epoch;
+                queue_.push_back(r);
+                out.push_back(next);
+            });
+            if (q + 1 == level_end) {
+                level_end = queue_.size();
+                ++depth;
+            }
+        }
+    }
+
+    std::vector<IndividualId> child_;
+    std::vector<IndividualId> parent_a_;
+    std::vector<IndividualId> parent_b_;
+    std::vector<LineageOperator> op_;
+    std::vector<int> generation_;
+    std::vector<int> first_child_;   // link index 2·row + slot, -1 ends
+    std::vector<int> next_child_;
+    std::unordered_map<IndividualId, int> row_;
+
+    std::vector<std::uint32_t> mark_;
+    std::uint32_t epoch_ = 0;
+    std::vector<int> queue_;
+
+    int latest_generation_ = 0;
+    std::uint64_t recorded_ = 0;
+    std::uint64_t pruned_ = 0;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,371 @@
+/**
+ * membrane_network.hpp
+ *
+ * Native step for MembraneReservoirBridge networks.
+ *
+ * Membranes get a stable dense index (ascending label, as in
+ * extract_global_state) fixed at construction, and all reservoir states live
+ * in one contiguous membrane-ordered buffer. The communication matrix C and
+ * every reservoir W are stored in CSR. A step is two parallel phases:
+ *
+ *     m_j   = mean(x_j)                                  (cached once per step)
+ *     x_i  ← (1-α) x_i + α tanh(W_i x_i + u_i + Σ_j C_ij m_j)
+ *
+ * so the coupling is one SpMV row per membrane instead of a scan over all
+ * pairs, and every membrane sees the means from the start of the step.
+ * The buffer is updated in place, so the global state is a zero-copy view
+ * and recording history is one memcpy per step.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * CsrMatrix
+ *
+ * Compressed sparse rows with sorted, duplicate-free column indices.
+ */
+struct CsrMatrix {
+    int rows = 0;
+    int cols = 0;
+    std::vector<int> row_ptr;
+    std::vector<int> col;
+    std::vector<double> val;
+
+    CsrMatrix() = default;
+    CsrMatrix(int num_rows, int num_cols) : rows(num_rows), cols(num_cols), row_ptr(num_rows + 1, 0) {}
+
+    // Duplicates are summed; zero entries are dropped
+    static CsrMatrix from_triplets(int rows, int cols, const std::vector<int>& I,
+                                   const std::vector<int>& J, const std::vector<double>& V) {
+        if (I.size() != J.size() || I.size() != V.size()) {
+            throw std::runtime_error("Triplet arrays differ in length");
+        }
+        std::vector<std::size_t> order(I.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        for (std::size_t k = 0; k < I.size(); ++k) {
+            if (I[k] < 0 || I[k] >= rows || J[k] < 0 || J[k] >= cols) {
+                throw std::runtime_error("Sparse entry out of range");
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return I[a] != I[b] ? I[a] < I[b] : J[a] < J[b];
+        });
+
+        CsrMatrix A(rows, cols);
+        for (std::size_t k = 0; k < order.size();) {
+            const int i = I[order[k]];
+            const int j = J[order[k]];
+            double v = 0.0;
+            for (; k < order.size() && I[order[k]] == i && J[order[k]] == j; ++k) {
+                v += V[order[k]];
+            }
+            if (v != 0.0) {
+                A.col.push_back(j);
+                A.val.push_back(v);
+                ++A.row_ptr[i + 1];
+            }
+        }
+        std::partial_sum(A.row_ptr.begin(), A.row_ptr.end(), A.row_ptr.begin());
+        return A;
+    }
+
+    // Row-major rows × cols
+    static CsrMatrix from_dense(int rows, int cols, const double* dense) {
+        CsrMatrix A(rows, cols);
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < cols; ++j) {
+                const double v = dense[static_cast<std::size_t>(i) * cols + j];
+                if (v != 0.0) {
+                    A.col.push_back(j);
+                    A.val.push_back(v);
+                }
+            }
+            A.row_ptr[i + 1] = static_cast<int>(A.col.size());
+        }
+        return A;
+    }
+
+    double row_dot(int i, const double* x) const {
+        double s = 0.0;
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; ++k) {
+            s += val[k] * x[col[k]];
+        }
+        return s;
+    }
+
+    // y = A x
+    void multiply(const double* x, double* y) const {
+        for (int i = 0; i < rows; ++i) {
+            y[i] = row_dot(i, x);
+        }
+    }
+
+    int nnz() const { return static_cast<int>(col.size()); }
+};
+
+/**
+ * MembraneNetwork
+ *
+ * parents[m] < 0 marks a root (Julia `nothing`); other parents are labels.
+ * The default coupling is the bridge's hierarchy: weight 0.5 both ways
+ * between each membrane and its parent.
+ */
+class MembraneNetwork {
+public:
+    MembraneNetwork(const std::vector<int>& labels, const std::vector<int>& parents,
+                    const std::vector<int>& sizes, double leak_rate, int num_workers)
+        : leak_rate_(leak_rate) {
+        if (labels.empty() || labels.size() != parents.size() || labels.size() != sizes.size()) {
+            throw std::runtime_error("Membrane labels, parents and sizes must be non-empty and equal length");
+        }
+
+        // Dense index in ascending label order
+        std::vector<std::size_t> order(labels.size());
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return labels[a] < labels[b]; });
+
+        const int M = static_cast<int>(labels.size());
+        labels_.resize(M);
+        offsets_.assign(M + 1, 0);
+        for (int m = 0; m < M; ++m) {
+            const std::size_t k = order[m];
+            if (sizes[k] < 1) {
+                throw std::runtime_error("Reservoir size must be positive");
+            }
+            if (!index_.emplace(labels[k], m).second) {
+                throw std::runtime_error("Duplicate membrane label: " + std::to_string(labels[k]));
+            }
+            labels_[m] = labels[k];
+            offsets_[m + 1] = offsets_[m] + sizes[k];
+        }
+        max_size_ = *std::max_element(sizes.begin(), sizes.end());
+
+        std::vector<int> I, J;
+        std::vector<double> V;
+        for (int m = 0; m < M; ++m) {
+            const int parent = parents[order[m]];
+            if (parent < 0) continue;
+            auto it = index_.find(parent);
+            if (it == index_.end() || it->second == m) continue;
+            I.insert(I.end(), {m, it->second});
+            J.insert(J.end(), {it->second, m});
+            V.insert(V.end(), {0.5, 0.5});
+        }
+        // Repeated parent links keep weight 0.5, as with the bridge's assignment
+        communication_ = CsrMatrix::from_triplets(M, M, I, J, V);
+        for (double& w : communication_.val) w = 0.5;
+
+        reservoirs_.resize(M);
+        for (int m = 0; m < M; ++m) {
+            reservoirs_[m] = CsrMatrix(size(m), size(m));
+        }
+        state_.assign(offsets_[M], 0.0);
+        means_.assign(M, 0.0);
+        scratch_.resize(std::max(num_workers, 1) + 1);
+        for (auto& buffer : scratch_) buffer.assign(max_size_, 0.0);
+    }
+
+    /**
+     * Coupling C_ij from membrane index j into membrane index i.
+     * The diagonal and non-positive weights are dropped, as in the bridge.
+     */
+    void set_communication(const std::vector<int>& I, const std::vector<int>& J,
+                           const std::vector<double>& V) {
+        if (I.size() != J.size() || I.size() != V.size()) {
+            throw std::runtime_error("Triplet arrays differ in length");
+        }
+        std::vector<int> rows, cols;
+        std::vector<double> vals;
+        for (std::size_t k = 0; k < V.size(); ++k) {
+            if (I[k] == J[k] || !(V[k] > 0.0)) continue;
+            rows.push_back(I[k]);
+            cols.push_back(J[k]);
+            vals.push_back(V[k]);
+        }
+        communication_ = CsrMatrix::from_triplets(num_membranes(), num_membranes(), rows, cols, vals);
+    }
+
+    void set_reservoir(int m, CsrMatrix W) {
+        check_index(m);
+        if (W.rows != size(m) || W.cols != size(m)) {
+            throw std::runtime_error("Reservoir matrix does not match membrane " + std::to_string(labels_[m]));
+        }
+        reservoirs_[m] = std::move(W);
+    }
+
+    // inputs[m] drives membrane index m (the bridge uses input[1])
+    void step(tf::Executor& executor, const double* inputs) {
+        run(executor, inputs, 1, nullptr, 0);
+    }
+
+    /**
+     * num_steps steps with inputs[t · M + m]. If history is non-null, the
+     * global state after step t is copied to column t of a caller-owned
+     * column-major total_size × num_steps matrix with leading dimension ld.
+     * The step graph is built once and re-run for every step.
+     */
+    void run(tf::Executor& executor, const double* inputs, int num_steps, double* history, int ld) {
+        if (executor.num_workers() + 1 > scratch_.size()) {
+            throw std::runtime_error("MembraneNetwork was built for fewer workers than the executor has");
+        }
+        if (history && ld < total_size()) {
+            throw std::runtime_error("History leading dimension smaller than the global state");
+        }
+        const int M = num_membranes();
+        const double* u = inputs;
+
+        tf::Taskflow taskflow;
+        tf::Task means = taskflow.for_each_index(0, M, 1, [&](int m) {
+            const double* x = state(m);
+            double s = 0.0;
+            for (int k = 0; k < size(m); ++k) s += x[k];
+            means_[m] = s / size(m);
+        });
+        tf::Task update = taskflow.for_each_index(0, M, 1, [&](int m) {
+            update_membrane(m, u[m] + communication_.row_dot(m, means_.data()),
+                            scratch_[executor.this_worker_id() + 1].data());
+        });
+        means.precede(update);
+
+        for (int t = 0; t < num_steps; ++t, u += M) {
+            executor.run(taskflow).wait();
+            if (history) {
+                std::memcpy(history + static_cast<std::size_t>(t) * ld, state_.data(),
+                            state_.size() * sizeof(double));
+            }
+            ++steps_;
+        }
+    }
+
+    int index_of(int label) const {
+        auto it = index_.find(label);
+        if (it == index_.end()) {
+            throw std::runtime_error("Membrane not found: " + std::to_string(label));
+        }
+        return it->second;
+    }
+
+    double* state(int m) { return state_.data() + offsets_[m]; }
+    const double* state(int m) const { return state_.data() + offsets_[m]; }
+    const std::vector<double>& global_state() const { return state_; }
+
+    int num_membranes() const { return static_cast<int>(labels_.size()); }
+    int size(int m) const { return offsets_[m + 1] - offsets_[m]; }
+    int offset(int m) const { return offsets_[m]; }
+    int total_size() const { return offsets_.back(); }
+    int label(int m) const { return labels_[m]; }
+    const CsrMatrix& communication() const { return communication_; }
+    const std::vector<double>& means() const { return means_; }
+    double leak_rate() const { return leak_rate_; }
+    std::uint64_t steps() const { return steps_; }
+    const std::vector<int>& labels() const { return labels_; }
+    const std::vector<int>& offsets() const { return offsets_; }
+
+    // Checkpoints: shape, coupling, every reservoir W and the global state
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<double>(prefix + "leak_rate", {leak_rate_});
+        writer.add_values<std::int64_t>(prefix + "meta", {static_cast<std::int64_t>(steps_)});
+        writer.add(prefix + "labels", labels_);
+        writer.add(prefix + "offsets", offsets_);
+        save_csr(writer, prefix + "C.", communication_);
+        for (int m = 0; m < num_membranes(); ++m) {
+            save_csr(writer, prefix + "W" + std::to_string(m) + ".", reservoirs_[m]);
+        }
+        writer.add(prefix + "state", state_);
+        writer.add(prefix + "means", means_);
+    }
+
+    // Built with the saved labels and sizes (see labels / offsets)
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto labels = reader.column<int>(prefix + "labels", labels_.size());
+        const auto offsets = reader.column<int>(prefix + "offsets", offsets_.size());
+        if (!std::equal(labels.begin(), labels.end(), labels_.begin()) ||
+            !std::equal(offsets.begin(), offsets.end(), offsets_.begin())) {
+            throw std::runtime_error("Checkpoint membrane network has another shape");
+        }
+        CsrMatrix C = restore_csr(reader, prefix + "C.", num_membranes());
+        std::vector<CsrMatrix> reservoirs(num_membranes());
+        for (int m = 0; m < num_membranes(); ++m) {
+            reservoirs[m] = restore_csr(reader, prefix + "W" + std::to_string(m) + ".", size(m));
+        }
+        const auto state = reader.column<double>(prefix + "state", state_.size());
+        const auto means = reader.column<double>(prefix + "means", means_.size());
+        communication_ = std::move(C);
+        reservoirs_ = std::move(reservoirs);
+        std::copy(state.begin(), state.end(), state_.begin());
+        std::copy(means.begin(), means.end(), means_.begin());
+        leak_rate_ = reader.column<double>(prefix + "leak_rate", 1)[0];
+        steps_ = static_cast<std::uint64_t>(reader.column<std::int64_t>(prefix + "meta", 1)[0]);
+    }
+
+private:
+    static void save_csr(CheckpointWriter& writer, const std::string& prefix, const CsrMatrix& A) {
+        writer.add(prefix + "row_ptr", A.row_ptr);
+        writer.add(prefix + "col", A.col);
+        writer.add(prefix + "val", A.val);
+    }
+
+    // Square n × n; row pointers and column indices are validated
+    static CsrMatrix restore_csr(const CheckpointReader& reader, const std::string& prefix, int n) {
+        CsrMatrix A(n, n);
+        A.row_ptr = reader.column<int>(prefix + "row_ptr", n + 1).to_vector();
+        const std::size_t nnz = static_cast<std::size_t>(A.row_ptr[n]);
+        A.col = reader.column<int>(prefix + "col", nnz).to_vector();
+        A.val = reader.column<double>(prefix + "val", nnz).to_vector();
+        bool valid = A.row_ptr[0] == 0;
+        for (int i = 0; i < n && valid; ++i) valid = A.row_ptr[i] <= A.row_ptr[i + 1];
+        for (int j : A.col) valid = valid && j >= 0 && j < n;
+        if (!valid) {
+            throw std::runtime_error("Corrupt sparse matrix in checkpoint: " + prefix);
+        }
+        return A;
+    }
+
+    void check_index(int m) const {
+        if (m < 0 || m >= num_membranes()) {
+            throw std::runtime_error("Membrane index out of range: " + std::to_string(m));
+        }
+    }
+
+    // x ← (1-α)x + α tanh(W x + u); W x goes to scratch first, W reads the old x
+    void update_membrane(int m, double u, double* wx) {
+        double* x = state(m);
+        const int n = size(m);
+        reservoirs_[m].multiply(x, wx);
+        for (int k = 0; k < n; ++k) {
+            x[k] = (1.0 - leak_rate_) * x[k] + leak_rate_ * std::tanh(wx[k] + u);
+        }
+    }
+
+    double leak_rate_;
+    std::vector<int> labels_;
+    std::map<int, int> index_;
+    std::vector<int> offsets_;
+    int max_size_ = 0;
+    CsrMatrix communication_;
+    std::vector<CsrMatrix> reservoirs_;
+    std::vector<double> state_;
+    std::vector<double> means_;
+    std::vector<std::vector<double>> scratch_;
+    std::uint64_t steps_ = 0;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,335 @@
+/**
+ * order_conditions.hpp
+ *
+ * Runge–Kutta order-condition residuals and their Jacobian with respect to
+ * the Butcher tableau (A, b).
+ *
+ * For an s-stage tableau the elementary weight of τ = [τ₁, ..., τ_m] is
+ * Φ(τ) = bᵀ g(τ) with stage vectors
+ *
+ *     g(•) = 1,   g(τ) = ∏_k u(τ_k),   u(τ) = A g(τ)   (product lane-wise),
+ *
+ * and the order conditions up to p are r(τ) = Φ(τ) - 1/γ(τ) = 0 for all
+ * |τ| ≤ p. Each tree's g is stored as a sparse monomial over its distinct
+ * children, ∏ u(τ_c)^k_c, so subtrees shared across the forest are computed
+ * once. All trees of one order are independent and evaluated in parallel,
+ * with lanes over the s stages.
+ *
+ * The Jacobian row of τ is obtained by one reverse sweep over the closure of
+ * τ's subtrees, so every row costs O(|closure| · s²). Rows run in parallel with
+ * per-worker scratch. Columns are [∂/∂b₁..b_s, ∂/∂a₁₁..a_ss (row-major)];
+ * callers optimizing explicit methods simply ignore the entries with j ≥ i.
+ */
+
+#pragma once
+
+#include "tree_arena.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * ElementaryWeightForest
+ *
+ * Sparse monomial tables g(τ) = ∏ u(τ_c)^k_c for every tree up to max_order,
+ * in TreeArena::enumerate_up_to(max_order) slot order (children first).
+ * Stateless once built, so one forest serves any number of tableaux.
+ */
+class ElementaryWeightForest {
+public:
+    ElementaryWeightForest(TreeArena& arena, int max_order) : max_order_(max_order) {
+        trees_ = arena.enumerate_up_to(max_order);
+        const int n = num_trees();
+
+        std::vector<int> slot_of(arena.size(), -1);
+        for (int s = 0; s < n; ++s) slot_of[trees_[s]] = s;
+
+        factor_offset_.push_back(0);
+        for (int s = 0; s < n; ++s) {
+            const TreeId* begin = arena.children_begin(trees_[s]);
+            const TreeId* end = arena.children_end(trees_[s]);
+            for (const TreeId* c = begin; c != end; ) {
+                const TreeId* run = c;
+                while (run != end && *run == *c) ++run;
+                factor_slot_.push_back(slot_of[*c]);
+                factor_power_.push_back(static_cast<int>(run - c));
+                c = run;
+            }
+            factor_offset_.push_back(static_cast<std::uint32_t>(factor_slot_.size()));
+
+            inverse_density_.push_back(1.0 / arena.density(trees_[s]));
+            const int order = arena.order(trees_[s]);
+            if (static_cast<int>(order_begin_.size()) < order) order_begin_.resize(order, s);
+        }
+        order_begin_.push_back(n);
+    }
+
+    /**
+     * Stage vectors g, u (num_trees × S) of `slot` from those of its
+     * children; returns Φ(τ) = bᵀ g(τ). A is S × S row-major.
+     */
+    double forward(int slot, int S, const double* A, const double* b, double* g, double* u) const {
+        double* gs = g + static_cast<std::size_t>(slot) * S;
+        std::fill(gs, gs + S, 1.0);
+        for (std::uint32_t f = factor_offset_[slot]; f < factor_offset_[slot + 1]; ++f) {
+            const double* uc = u + static_cast<std::size_t>(factor_slot_[f]) * S;
+            for (int k = 0; k < factor_power_[f]; ++k) {
+                for (int i = 0; i < S; ++i) gs[i] *= uc[i];
+            }
+        }
+        double* us = u + static_cast<std::size_t>(slot) * S;
+        double phi = 0.0;
+        for (int i = 0; i < S; ++i) {
+            const double* row = A + static_cast<std::size_t>(i) * S;
+            double acc = 0.0;
+            for (int j = 0; j < S; ++j) acc += row[j] * gs[j];
+            us[i] = acc;
+            phi += b[i] * gs[i];
+        }
+        return phi;
+    }
+
+    // Φ(τ) of every slot, sequentially
+    void elementary_weights(int S, const double* A, const double* b,
+                            double* g, double* u, double* phi) const {
+        for (int s = 0; s < num_trees(); ++s) phi[s] = forward(s, S, A, b, g, u);
+    }
+
+    const std::vector<TreeId>& trees() const { return trees_; }
+    int num_trees() const { return static_cast<int>(trees_.size()); }
+    int max_order() const { return max_order_; }
+
+    // Slots [order_begin(k - 1), order_begin(k)) have order k
+    int order_begin(int k) const { return order_begin_[k]; }
+
+    std::uint32_t factor_begin(int slot) const { return factor_offset_[slot]; }
+    std::uint32_t factor_end(int slot) const { return factor_offset_[slot + 1]; }
+    int factor_slot(std::uint32_t f) const { return factor_slot_[f]; }
+    int factor_power(std::uint32_t f) const { return factor_power_[f]; }
+    double inverse_density(int slot) const { return inverse_density_[slot]; }
+
+private:
+    int max_order_;
+    std::vector<TreeId> trees_;
+    std::vector<std::uint32_t> factor_offset_;
+    std::vector<int> factor_slot_;
+    std::vector<int> factor_power_;
+    std::vector<double> inverse_density_;
+    std::vector<int> order_begin_;
+};
+
+/**
+ * OrderConditionEngine
+ *
+ * Trees follow TreeArena::enumerate_up_to(max_order) (slot order).
+ */
+class OrderConditionEngine {
+public:
+    OrderConditionEngine(TreeArena& arena, int max_order, int stages, int num_workers)
+        : forest_(arena, max_order), stages_(stages) {
+        if (stages < 1) {
+            throw std::runtime_error("Tableau needs at least one stage");
+        }
+        const int n = num_trees();
+
+        // Closure of every tree (itself and all distinct subtrees), descending slots
+        std::vector<char> mark(n, 0);
+        closure_offset_.push_back(0);
+        for (int s = 0; s < n; ++s) {
+            std::vector<int> stack = {s};
+            std::vector<int> members;
+            mark[s] = 1;
+            while (!stack.empty()) {
+                const int v = stack.back();
+                stack.pop_back();
+                members.push_back(v);
+                for (std::uint32_t f = forest_.factor_begin(v); f < forest_.factor_end(v); ++f) {
+                    const int c = forest_.factor_slot(f);
+                    if (!mark[c]) {
+                        mark[c] = 1;
+                        stack.push_back(c);
+                    }
+                }
+            }
+            std::sort(members.begin(), members.end(), std::greater<int>());
+            for (int v : members) mark[v] = 0;
+            closure_slots_.insert(closure_slots_.end(), members.begin(), members.end());
+            closure_offset_.push_back(static_cast<std::uint32_t>(closure_slots_.size()));
+        }
+
+        A_.assign(static_cast<std::size_t>(stages) * stages, 0.0);
+        b_.assign(stages, 0.0);
+        g_.assign(static_cast<std::size_t>(n) * stages, 0.0);
+        u_.assign(static_cast<std::size_t>(n) * stages, 0.0);
+        phi_.assign(n, 0.0);
+        scratch_.resize(std::max(num_workers, 1) + 1);
+        for (auto& w : scratch_) {
+            w.g_bar.assign(static_cast<std::size_t>(n) * stages, 0.0);
+            w.u_bar.assign(static_cast<std::size_t>(n) * stages, 0.0);
+            w.partial.assign(stages, 0.0);
+        }
+    }
+
+    /**
+     * Elementary weights Φ(τ) and residuals r(τ) = Φ(τ) - 1/γ(τ) for the
+     * tableau A (s × s row-major) and weights b.
+     */
+    void evaluate(tf::Executor& executor, const double* A, const double* b) {
+        std::copy(A, A + stages_ * stages_, A_.begin());
+        std::copy(b, b + stages_, b_.begin());
+        evaluated_ = true;
+        for (int order = 1; order <= max_order(); ++order) {
+            const int first = forest_.order_begin(order - 1);
+            const int last = forest_.order_begin(order);
+            if (last - first < 8) {
+                for (int s = first; s < last; ++s) forward(s);
+            } else {
+                tf::Taskflow taskflow;
+                taskflow.for_each_index(first, last, 1, [this](int s) { forward(s); });
+                executor.run(taskflow).wait();
+            }
+        }
+        ++evaluations_;
+    }
+
+    /**
+     * Jacobian of all residuals (num_trees × (s + s²), row-major) at the
+     * tableau of the last evaluate().
+     */
+    void jacobian(tf::Executor& executor, double* J) {
+        if (!evaluated_) {
+            throw std::runtime_error("OrderConditionEngine::jacobian before evaluate");
+        }
+        if (executor.num_workers() + 1 > scratch_.size()) {
+            throw std::runtime_error("OrderConditionEngine was built for fewer workers than the executor has");
+        }
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, num_trees(), 1, [&](int s) {
+            Scratch& w = scratch_[executor.this_worker_id() + 1];
+            reverse(s, w, J + static_cast<std::size_t>(s) * num_parameters());
+        });
+        executor.run(taskflow).wait();
+    }
+
+    double elementary_weight(int slot) const { return phi_[slot]; }
+    double residual(int slot) const { return phi_[slot] - forest_.inverse_density(slot); }
+
+    std::vector<double> residuals() const {
+        std::vector<double> r(num_trees());
+        for (int s = 0; s < num_trees(); ++s) r[s] = residual(s);
+        return r;
+    }
+
+    const std::vector<double>& elementary_weights() const { return phi_; }
+    const ElementaryWeightForest& forest() const { return forest_; }
+    const std::vector<TreeId>& trees() const { return forest_.trees(); }
+    int num_trees() const { return forest_.num_trees(); }
+    int stages() const { return stages_; }
+    int max_order() const { return forest_.max_order(); }
+    int num_parameters() const { return stages_ + stages_ * stages_; }
+    std::uint64_t evaluations() const { return evaluations_; }
+
+private:
+    struct Scratch {
+        std::vector<double> g_bar;
+        std::vector<double> u_bar;
+        std::vector<double> partial;
+    };
+
+    double* g(int slot) { return g_.data() + static_cast<std::size_t>(slot) * stages_; }
+    double* u(int slot) { return u_.data() + static_cast<std::size_t>(slot) * stages_; }
+
+    void forward(int slot) {
+        phi_[slot] = forest_.forward(slot, stages_, A_.data(), b_.data(), g_.data(), u_.data());
+    }
+
+    // One Jacobian row by reverse accumulation over the closure of `root`
+    void reverse(int root, Scratch& w, double* row) {
+        const int S = stages_;
+        double* db = row;
+        double* dA = row + S;
+        std::fill(row, row + num_parameters(), 0.0);
+
+        const std::uint32_t begin = closure_offset_[root];
+        const std::uint32_t end = closure_offset_[root + 1];
+
+        std::copy(g(root), g(root) + S, db);
+        std::copy(b_.begin(), b_.end(), w.g_bar.begin() + static_cast<std::size_t>(root) * S);
+
+        for (std::uint32_t k = begin; k < end; ++k) {
+            const int v = closure_slots_[k];
+            double* g_bar = w.g_bar.data() + static_cast<std::size_t>(v) * S;
+            const double* u_bar = w.u_bar.data() + static_cast<std::size_t>(v) * S;
+            const double* gv = g(v);
+
+            // u(v) = A g(v): Ā += ū gᵀ, ḡ += Aᵀ ū
+            if (v != root) {
+                for (int i = 0; i < S; ++i) {
+                    const double ui = u_bar[i];
+                    if (ui == 0.0) continue;
+                    const double* a_row = A_.data() + static_cast<std::size_t>(i) * S;
+                    double* dA_row = dA + static_cast<std::size_t>(i) * S;
+                    for (int j = 0; j < S; ++j) {
+                        dA_row[j] += ui * gv[j];
+                        g_bar[j] += a_row[j] * ui;
+                    }
+                }
+            }
+
+            // g(v) = ∏ u(c)^k: ū(c) += ḡ ⊙ k u(c)^(k-1) ∏_{c' ≠ c} u(c')^k'
+            const std::uint32_t f_begin = forest_.factor_begin(v);
+            const std::uint32_t f_end = forest_.factor_end(v);
+            for (std::uint32_t f = f_begin; f < f_end; ++f) {
+                const int c = forest_.factor_slot(f);
+                const int power = forest_.factor_power(f);
+                const double* uc = u(c);
+                for (int i = 0; i < S; ++i) {
+                    double p = power;
+                    for (int e = 1; e < power; ++e) p *= uc[i];
+                    w.partial[i] = p;
+                }
+                for (std::uint32_t o = f_begin; o < f_end; ++o) {
+                    if (o == f) continue;
+                    const double* uo = u(forest_.factor_slot(o));
+                    for (int e = 0; e < forest_.factor_power(o); ++e) {
+                        for (int i = 0; i < S; ++i) w.partial[i] *= uo[i];
+                    }
+                }
+                double* uc_bar = w.u_bar.data() + static_cast<std::size_t>(c) * S;
+                for (int i = 0; i < S; ++i) uc_bar[i] += g_bar[i] * w.partial[i];
+            }
+        }
+
+        // Leave the scratch zeroed for the next row
+        for (std::uint32_t k = begin; k < end; ++k) {
+            const std::size_t v = static_cast<std::size_t>(closure_slots_[k]) * S;
+            std::fill(w.g_bar.begin() + v, w.g_bar.begin() + v + S, 0.0);
+            std::fill(w.u_bar.begin() + v, w.u_bar.begin() + v + S, 0.0);
+        }
+    }
+
+    ElementaryWeightForest forest_;
+    int stages_;
+
+    std::vector<std::uint32_t> closure_offset_;
+    std::vector<int> closure_slots_;
+
+    std::vector<double> A_;
+    std::vector<double> b_;
+    bool evaluated_ = false;
+    std::vector<double> g_;
+    std::vector<double> u_;
+    std::vector<double> phi_;
+    std::vector<Scratch> scratch_;
+    std::uint64_t evaluations_ = 0;
+};
+
+} // namespace taskflow_bridge
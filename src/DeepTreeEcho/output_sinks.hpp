@@ -0,0 +1,260 @@
+/**
+ * output_sinks.hpp
+ *
+ * Streaming destinations for trajectory rows (t, y₁, ..., y_n).
+ *
+ * Native integrators hand every output row to an OutputSink instead of
+ * appending to a growing container, so memory use stays bounded no matter how
+ * long an integration runs:
+ *
+ *   - CallbackSink    forwards each row to a user function
+ *   - MatrixSink      writes into a caller-preallocated row-major matrix
+ *   - MmapFileSink    appends rows to a memory-mapped binary file
+ *   - RingBufferSink  batches rows in a fixed ring and flushes them downstream
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace taskflow_bridge {
+
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+
+    virtual void write(double t, const double* y, int dim) = 0;
+
+    // Called once at the end of an integration
+    virtual void flush() {}
+};
+
+/**
+ * CallbackSink
+ */
+class CallbackSink final : public OutputSink {
+public:
+    using Callback = std::function<void(double, const double*, int)>;
+
+    explicit CallbackSink(Callback callback) : callback_(std::move(callback)) {}
+
+    void write(double t, const double* y, int dim) override { callback_(t, y, dim); }
+
+private:
+    Callback callback_;
+};
+
+/**
+ * MatrixSink
+ *
+ * Rows of (t, y...) written into `data` (capacity × (dim + 1), row-major).
+ * Rows beyond capacity are counted as dropped rather than reallocating.
+ */
+class MatrixSink final : public OutputSink {
+public:
+    MatrixSink(double* data, std::size_t capacity, int dim)
+        : data_(data), capacity_(capacity), dim_(dim) {}
+
+    void write(double t, const double* y, int dim) override {
+        if (dim != dim_) {
+            throw std::runtime_error("MatrixSink dimension mismatch");
+        }
+        if (rows_ == capacity_) {
+            ++dropped_;
+            return;
+        }
+        double* row = data_ + rows_ * (dim_ + 1);
+        row[0] = t;
+        std::memcpy(row + 1, y, sizeof(double) * dim_);
+        ++rows_;
+    }
+
+    std::size_t rows() const { return rows_; }
+    std::size_t dropped() const { return dropped_; }
+
+private:
+    double* data_;
+    std::size_t capacity_;
+    int dim_;
+    std::size_t rows_ = 0;
+    std::size_t dropped_ = 0;
+};
+
+/**
+ * MmapFileSink
+ *
+ * Binary layout (little endian, readable with Julia's Mmap):
+ *
+ *     [ magic "DTETRAJ\0" | u32 version | u32 dim | u64 rows | u64 reserved ]
+ *     rows × (dim + 1) float64
+ *
+ * The file grows geometrically and is truncated to its exact size on flush.
+ */
+class MmapFileSink final : public OutputSink {
+public:
+    static constexpr std::size_t kHeaderBytes = 32;
+    static constexpr std::uint32_t kVersion = 1;
+
+    MmapFileSink(const std::string& path, int dim, std::size_t initial_rows = 4096)
+        : path_(path), dim_(dim), row_bytes_(sizeof(double) * (dim + 1)) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            throw std::runtime_error("Cannot open trajectory file: " + path);
+        }
+        map(kHeaderBytes + initial_rows * row_bytes_);
+
+        std::memcpy(base_, "DTETRAJ", 8);
+        std::uint32_t version = kVersion;
+        std::uint32_t dim32 = static_cast<std::uint32_t>(dim);
+        std::memcpy(base_ + 8, &version, 4);
+        std::memcpy(base_ + 12, &dim32, 4);
+        sync_row_count();
+    }
+
+    ~MmapFileSink() override {
+        try {
+            flush();
+        } catch (...) {
+        }
+        unmap();
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    MmapFileSink(const MmapFileSink&) = delete;
+    MmapFileSink& operator=(const MmapFileSink&) = delete;
+
+    void write(double t, const double* y, int dim) override {
+        write_rows(&t, y, dim, 1);
+    }
+
+    // Bulk append of `count` rows whose times and states are contiguous
+    void write_rows(const double* t, const double* y, int dim, std::size_t count) {
+        if (dim != dim_) {
+            throw std::runtime_error("MmapFileSink dimension mismatch");
+        }
+        const std::size_t needed = kHeaderBytes + (rows_ + count) * row_bytes_;
+        if (needed > mapped_bytes_) {
+            map(std::max(needed, mapped_bytes_ * 2));
+        }
+        for (std::size_t r = 0; r < count; ++r) {
+            char* row = base_ + kHeaderBytes + (rows_ + r) * row_bytes_;
+            std::memcpy(row, t + r, sizeof(double));
+            std::memcpy(row + sizeof(double), y + r * dim_, sizeof(double) * dim_);
+        }
+        rows_ += count;
+    }
+
+    void flush() override {
+        if (!base_) return;
+        sync_row_count();
+        const std::size_t used = kHeaderBytes + rows_ * row_bytes_;
+        ::msync(base_, used, MS_SYNC);
+        if (::ftruncate(fd_, static_cast<off_t>(used)) != 0) {
+            throw std::runtime_error("Cannot truncate trajectory file: " + path_);
+        }
+        unmap();
+        map_existing(used);
+    }
+
+    std::size_t rows() const { return rows_; }
+    const std::string& path() const { return path_; }
+
+private:
+    void map(std::size_t bytes) {
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error("Cannot grow trajectory file: " + path_);
+        }
+        unmap();
+        map_existing(bytes);
+    }
+
+    void map_existing(std::size_t bytes) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Cannot mmap trajectory file: " + path_);
+        }
+        base_ = static_cast<char*>(p);
+        mapped_bytes_ = bytes;
+    }
+
+    void unmap() {
+        if (base_) {
+            ::munmap(base_, mapped_bytes_);
+            base_ = nullptr;
+            mapped_bytes_ = 0;
+        }
+    }
+
+    void sync_row_count() {
+        std::uint64_t rows = rows_;
+        std::memcpy(base_ + 16, &rows, 8);
+    }
+
+    std::string path_;
+    int dim_;
+    std::size_t row_bytes_;
+    int fd_ = -1;
+    char* base_ = nullptr;
+    std::size_t mapped_bytes_ = 0;
+    std::size_t rows_ = 0;
+};
+
+/**
+ * RingBufferSink
+ *
+ * Collects rows in a fixed-size buffer and hands them to `downstream` in
+ * batches, either when the ring fills up or on flush().
+ */
+class RingBufferSink final : public OutputSink {
+public:
+    RingBufferSink(OutputSink& downstream, int dim, std::size_t capacity = 1024)
+        : downstream_(downstream), dim_(dim), capacity_(capacity),
+          times_(capacity), states_(capacity * dim) {}
+
+    void write(double t, const double* y, int dim) override {
+        if (dim != dim_) {
+            throw std::runtime_error("RingBufferSink dimension mismatch");
+        }
+        times_[count_] = t;
+        std::memcpy(states_.data() + count_ * dim_, y, sizeof(double) * dim_);
+        if (++count_ == capacity_) drain();
+    }
+
+    void flush() override {
+        drain();
+        downstream_.flush();
+    }
+
+private:
+    void drain() {
+        if (count_ == 0) return;
+        if (auto* file = dynamic_cast<MmapFileSink*>(&downstream_)) {
+            file->write_rows(times_.data(), states_.data(), dim_, count_);
+        } else {
+            for (std::size_t r = 0; r < count_; ++r) {
+                downstream_.write(times_[r], states_.data() + r * dim_, dim_);
+            }
+        }
+        count_ = 0;
+    }
+
+    OutputSink& downstream_;
+    int dim_;
+    std::size_t capacity_;
+    std::vector<double> times_;
+    std::vector<double> states_;
+    std::size_t count_ = 0;
+};
+
+} // namespace taskflow_bridge
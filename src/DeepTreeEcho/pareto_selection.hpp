@@ -0,0 +1,510 @@
+/**
+ * pareto_selection.hpp
+ *
+ * Multi-objective environmental selection: non-dominated sorting, crowding
+ * distance, NSGA-II and NSGA-III.
+ *
+ * Objectives are maximized (as in FitnessEvaluation.jl) and arrive as an
+ * objective-major SoA matrix: objective m of individual i is F[m * n + i].
+ *
+ * Sorting is ENS-BS (Zhang et al. 2015). Individuals are presorted
+ * lexicographically in O(M·N log N), so only earlier individuals can
+ * dominate later ones. Each individual then binary-searches the front list
+ * for the first front with no member dominating it. With two objectives,
+ * only the front's last member needs checking, so the sort is O(N log N)
+ * exactly. With more objectives, each front is packed row-major with
+ * per-block objective maxima. A front is scanned newest-first, skipping
+ * blocks that cannot hold a dominator. Members are placed in blocks of
+ * kBlock: their searches against the finished fronts run in parallel, and
+ * dominators inside the block are resolved sequentially afterwards.
+ *
+ * Crowding distance sorts once per objective by (rank, value) on the
+ * executor. NSGA-III follows Deb & Jain (2014): Das–Dennis reference
+ * points, ideal-point translation, ASF extreme points and hyperplane
+ * intercepts (nadir fallback), parallel association, and niche-count
+ * filling of the last front with Philox tie-breaks.
+ */
+
+#pragma once
+
+#include "philox.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * Das–Dennis simplex lattice: every w ≥ 0 with Σw = 1 and w·divisions
+ * integral. Row-major C(divisions + M - 1, M - 1) × M.
+ */
+inline std::vector<double> das_dennis_points(int num_objectives, int divisions) {
+    if (num_objectives < 1 || divisions < 1) {
+        throw std::runtime_error("Reference points need num_objectives >= 1 and divisions >= 1");
+    }
+    std::vector<double> points;
+    std::vector<int> w(num_objectives, 0);
+    // Enumerate compositions of `divisions` into M parts in lexicographic order
+    auto recurse = [&](auto&& self, int m, int left) -> void {
+        if (m == num_objectives - 1) {
+            w[m] = left;
+            for (int k = 0; k < num_objectives; ++k) points.push_back(static_cast<double>(w[k]) / divisions);
+            return;
+        }
+        for (int v = left; v >= 0; --v) {
+            w[m] = v;
+            self(self, m + 1, left - v);
+        }
+    };
+    recurse(recurse, 0, divisions);
+    return points;
+}
+
+/**
+ * ParetoSelector
+ *
+ * Keeps its scratch between calls, so repeated selection at a fixed
+ * population size does not allocate.
+ */
+class ParetoSelector {
+public:
+    static constexpr std::size_t kBoundRows = 32;
+    static constexpr int kBlock = 512;
+
+    /**
+     * Front index of every individual (0 = non-dominated). Returns the
+     * number of fronts; members of front f are front(f).
+     */
+    int sort(tf::Executor& executor, const double* F, int num_objectives, int n) {
+        check_shape(num_objectives, n);
+        M_ = num_objectives;
+        n_ = n;
+        rank_.assign(n, -1);
+
+        order_.resize(n);
+        std::iota(order_.begin(), order_.end(), 0);
+        std::sort(order_.begin(), order_.end(), [&](int a, int b) {
+            for (int m = 0; m < M_; ++m) {
+                const double fa = F[static_cast<std::size_t>(m) * n + a];
+                const double fb = F[static_cast<std::size_t>(m) * n + b];
+                if (fa != fb) return fa > fb;
+            }
+            return a < b;
+        });
+
+        // Rows in presorted order, so front scans stream contiguous memory
+        points_.resize(static_cast<std::size_t>(n) * M_);
+        for (int k = 0; k < n; ++k) {
+            for (int m = 0; m < M_; ++m) points_[static_cast<std::size_t>(k) * M_ + m] = F[static_cast<std::size_t>(m) * n + order_[k]];
+        }
+
+        // Fronts in insertion (lexicographic) order, with their packed rows
+        for (auto& f : fronts_) f.clear();
+        for (auto& f : front_points_) f.clear();
+        for (auto& f : front_bounds_) f.clear();
+        floor_.resize(n);
+        int num_fronts = 0;
+        auto search = [&](int k) {
+            const double* row = points_.data() + static_cast<std::size_t>(k) * M_;
+            int lo = 0, hi = num_fronts;
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                if (dominated_by_front(row, mid)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            floor_[k] = lo;
+        };
+        // Two objectives: O(log F) per member, no block phase needed
+        const int block = M_ == 2 ? 1 : kBlock;
+        for (int start = 0; start < n; start += block) {
+            const int end = std::min(n, start + block);
+            if (block == 1) {
+                search(start);
+            } else {
+                // Earlier blocks are final: each member binary-searches them independently
+                tf::Taskflow taskflow;
+                taskflow.for_each_index(start, end, 1, search);
+                executor.run(taskflow).wait();
+            }
+
+            // Dominators inside the block can only push a member further back
+            for (int k = start; k < end; ++k) {
+                const double* row = points_.data() + static_cast<std::size_t>(k) * M_;
+                int r = floor_[k];
+                for (int q = start; q < k; ++q) {
+                    if (floor_[q] >= r && dominates(points_.data() + static_cast<std::size_t>(q) * M_, row)) {
+                        r = floor_[q] + 1;
+                    }
+                }
+                floor_[k] = r;
+                if (r == num_fronts) {
+                    ++num_fronts;
+                    if (static_cast<int>(fronts_.size()) < num_fronts) {
+                        fronts_.emplace_back();
+                        front_points_.emplace_back();
+                        front_bounds_.emplace_back();
+                    }
+                }
+                append(r, order_[k], row);
+                rank_[order_[k]] = r;
+            }
+        }
+        num_fronts_ = num_fronts;
+        return num_fronts;
+    }
+
+    /**
+     * Crowding distance within each front of the last sort (boundary
+     * individuals of any objective get +inf).
+     */
+    void crowding(tf::Executor& executor, const double* F) {
+        const int n = n_, M = M_;
+        crowding_.assign(n, 0.0);
+        if (n == 0) return;
+        contribution_.assign(static_cast<std::size_t>(M) * n, 0.0);
+        by_objective_.resize(M);
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, M, 1, [&](int m) {
+            const double* f = F + static_cast<std::size_t>(m) * n;
+            double* c = contribution_.data() + static_cast<std::size_t>(m) * n;
+            std::vector<int>& idx = by_objective_[m];
+            idx.resize(n);
+            std::iota(idx.begin(), idx.end(), 0);
+            std::sort(idx.begin(), idx.end(), [&](int a, int b) {
+                if (rank_[a] != rank_[b]) return rank_[a] < rank_[b];
+                if (f[a] != f[b]) return f[a] < f[b];
+                return a < b;
+            });
+            for (int s = 0; s < n;) {
+                int e = s;
+                while (e < n && rank_[idx[e]] == rank_[idx[s]]) ++e;
+                const double range = f[idx[e - 1]] - f[idx[s]];
+                c[idx[s]] = std::numeric_limits<double>::infinity();
+                c[idx[e - 1]] = std::numeric_limits<double>::infinity();
+                if (range > 0.0) {
+                    for (int k = s + 1; k < e - 1; ++k) c[idx[k]] = (f[idx[k + 1]] - f[idx[k - 1]]) / range;
+                }
+                s = e;
+            }
+        });
+        executor.run(taskflow).wait();
+
+        for (int m = 0; m < M; ++m) {
+            const double* c = contribution_.data() + static_cast<std::size_t>(m) * n;
+            for (int i = 0; i < n; ++i) crowding_[i] += c[i];
+        }
+    }
+
+    /**
+     * NSGA-II: whole fronts while they fit, then the last front by
+     * descending crowding distance (ties by index). Selected indices are
+     * written to out[0 .. mu).
+     */
+    void select_nsga2(tf::Executor& executor, const double* F, int num_objectives, int n, int mu, int* out) {
+        check_mu(n, mu);
+        sort(executor, F, num_objectives, n);
+        crowding(executor, F);
+        int count = 0;
+        for (int f = 0; f < num_fronts_ && count < mu; ++f) {
+            std::vector<int>& front = fronts_[f];
+            if (count + static_cast<int>(front.size()) > mu) {
+                std::sort(front.begin(), front.end(), [&](int a, int b) {
+                    if (crowding_[a] != crowding_[b]) return crowding_[a] > crowding_[b];
+                    return a < b;
+                });
+            }
+            for (std::size_t k = 0; k < front.size() && count < mu; ++k) out[count++] = front[k];
+        }
+    }
+
+    /**
+     * NSGA-III with row-major num_refs × M reference points (normally
+     * das_dennis_points). Niche ties draw from the Philox stream
+     * (seed, generation, 0, Selection).
+     */
+    void select_nsga3(tf::Executor& executor, const double* F, int num_objectives, int n, int mu,
+                      const double* refs, int num_refs, std::uint64_t seed, std::uint32_t generation, int* out) {
+        check_mu(n, mu);
+        if (num_refs < 1) {
+            throw std::runtime_error("NSGA-III needs at least one reference point");
+        }
+        sort(executor, F, num_objectives, n);
+        if (mu == 0) return;
+        const int M = num_objectives;
+
+        // S_t: whole fronts until at least mu individuals; the last one is split
+        int count = 0, last = 0;
+        members_.clear();
+        for (; last < num_fronts_; ++last) {
+            if (count + static_cast<int>(fronts_[last].size()) >= mu) break;
+            count += static_cast<int>(fronts_[last].size());
+        }
+        for (int f = 0; f <= last; ++f) members_.insert(members_.end(), fronts_[f].begin(), fronts_[f].end());
+        std::copy(members_.begin(), members_.begin() + count, out);
+        if (count + static_cast<int>(fronts_[last].size()) == mu) {
+            std::copy(fronts_[last].begin(), fronts_[last].end(), out + count);
+            return;
+        }
+
+        normalize(F, M);
+        associate(executor, refs, num_refs, M);
+
+        // Niche counts of the accepted fronts; candidates of the last front per reference
+        niche_count_.assign(num_refs, 0);
+        for (int k = 0; k < count; ++k) ++niche_count_[niche_[k]];
+        candidates_.resize(num_refs);
+        for (auto& c : candidates_) c.clear();
+        for (std::size_t k = count; k < members_.size(); ++k) candidates_[niche_[k]].push_back(static_cast<int>(k));
+
+        PhiloxStream rng(seed, generation, 0, RandomOperator::Selection);
+        std::vector<int>& open = open_refs_;
+        open.clear();
+        for (int j = 0; j < num_refs; ++j) {
+            if (!candidates_[j].empty()) open.push_back(j);
+        }
+        while (count < mu) {
+            int min_count = std::numeric_limits<int>::max();
+            for (int j : open) min_count = std::min(min_count, niche_count_[j]);
+            tied_.clear();
+            for (int j : open) {
+                if (niche_count_[j] == min_count) tied_.push_back(j);
+            }
+            const int j = tied_[rng.below(static_cast<std::uint32_t>(tied_.size()))];
+            std::vector<int>& c = candidates_[j];
+            std::size_t pick = 0;
+            if (niche_count_[j] == 0) {
+                for (std::size_t k = 1; k < c.size(); ++k) {
+                    if (distance_[c[k]] < distance_[c[pick]]) pick = k;
+                }
+            } else {
+                pick = rng.below(static_cast<std::uint32_t>(c.size()));
+            }
+            out[count++] = members_[c[pick]];
+            c[pick] = c.back();
+            c.pop_back();
+            ++niche_count_[j];
+            if (c.empty()) open.erase(std::find(open.begin(), open.end(), j));
+        }
+    }
+
+    // Results of the last sort / crowding call
+
+    int num_fronts() const { return num_fronts_; }
+    const std::vector<int>& front(int f) const { return fronts_[f]; }
+    const std::vector<int>& rank() const { return rank_; }
+    const std::vector<double>& crowding() const { return crowding_; }
+
+private:
+    static void check_shape(int num_objectives, int n) {
+        if (num_objectives < 1 || n < 0) {
+            throw std::runtime_error("Pareto selection needs num_objectives >= 1 and n >= 0");
+        }
+    }
+
+    static void check_mu(int n, int mu) {
+        if (mu < 0 || mu > n) {
+            throw std::runtime_error("Cannot select " + std::to_string(mu) + " of " + std::to_string(n));
+        }
+    }
+
+    // q precedes p lexicographically, so q_0 >= p_0 already holds
+    bool dominates(const double* q, const double* p) const {
+        bool strict = q[0] > p[0];
+        for (int m = 1; m < M_; ++m) {
+            if (q[m] < p[m]) return false;
+            if (q[m] > p[m]) strict = true;
+        }
+        return strict;
+    }
+
+    void append(int f, int i, const double* row) {
+        const std::size_t M = M_;
+        std::vector<double>& rows = front_points_[f];
+        std::vector<double>& bounds = front_bounds_[f];
+        if (fronts_[f].size() % kBoundRows == 0) {
+            bounds.insert(bounds.end(), row, row + M);
+        } else {
+            double* b = bounds.data() + bounds.size() - M;
+            for (std::size_t m = 0; m < M; ++m) b[m] = std::max(b[m], row[m]);
+        }
+        fronts_[f].push_back(i);
+        rows.insert(rows.end(), row, row + M);
+    }
+
+    /**
+     * Newest rows first. With two objectives the last row decides; otherwise
+     * blocks of kBoundRows rows whose per-objective maxima fall below p in
+     * some objective cannot hold a dominator and are skipped.
+     */
+    bool dominated_by_front(const double* p, int f) const {
+        const std::size_t M = M_;
+        const std::vector<double>& rows = front_points_[f];
+        if (M == 2) return dominates(rows.data() + rows.size() - M, p);
+        const std::vector<double>& bounds = front_bounds_[f];
+        const std::size_t num_rows = rows.size() / M;
+        for (std::size_t block = bounds.size() / M; block-- > 0;) {
+            const double* b = bounds.data() + block * M;
+            bool reachable = true;
+            for (std::size_t m = 1; m < M && reachable; ++m) reachable = b[m] >= p[m];
+            if (!reachable) continue;
+            const std::size_t end = std::min(num_rows, (block + 1) * kBoundRows);
+            for (std::size_t r = end; r > block * kBoundRows; --r) {
+                if (dominates(rows.data() + (r - 1) * M, p)) return true;
+            }
+        }
+        return false;
+    }
+
+    // members_ → normalized_ (minimization, translated by the ideal point, scaled by intercepts)
+    void normalize(const double* F, int M) {
+        const std::size_t s = members_.size();
+        normalized_.resize(s * M);
+        std::vector<double> ideal(M, std::numeric_limits<double>::infinity());
+        for (std::size_t k = 0; k < s; ++k) {
+            for (int m = 0; m < M; ++m) {
+                const double v = -F[static_cast<std::size_t>(m) * n_ + members_[k]];
+                normalized_[k * M + m] = v;
+                ideal[m] = std::min(ideal[m], v);
+            }
+        }
+        for (std::size_t k = 0; k < s; ++k) {
+            for (int m = 0; m < M; ++m) normalized_[k * M + m] -= ideal[m];
+        }
+
+        // Extreme point per axis: minimal achievement scalarizing function
+        std::vector<double> extreme(static_cast<std::size_t>(M) * M, 0.0);
+        for (int axis = 0; axis < M; ++axis) {
+            double best = std::numeric_limits<double>::infinity();
+            std::size_t arg = 0;
+            for (std::size_t k = 0; k < s; ++k) {
+                double asf = 0.0;
+                for (int m = 0; m < M; ++m) {
+                    asf = std::max(asf, normalized_[k * M + m] / (m == axis ? 1.0 : 1e-6));
+                }
+                if (asf < best) {
+                    best = asf;
+                    arg = k;
+                }
+            }
+            std::copy(normalized_.begin() + arg * M, normalized_.begin() + (arg + 1) * M, extreme.begin() + axis * M);
+        }
+
+        std::vector<double> intercept(M);
+        if (!hyperplane_intercepts(extreme, M, intercept)) {
+            for (int m = 0; m < M; ++m) {
+                double worst = 0.0;
+                for (std::size_t k = 0; k < s; ++k) worst = std::max(worst, normalized_[k * M + m]);
+                intercept[m] = worst > 1e-10 ? worst : 1.0;
+            }
+        }
+        for (std::size_t k = 0; k < s; ++k) {
+            for (int m = 0; m < M; ++m) normalized_[k * M + m] /= intercept[m];
+        }
+    }
+
+    // Solve E·a = 1 by Gaussian elimination; intercept_m = 1 / a_m
+    static bool hyperplane_intercepts(std::vector<double> E, int M, std::vector<double>& intercept) {
+        std::vector<double> b(M, 1.0);
+        for (int c = 0; c < M; ++c) {
+            int pivot = c;
+            for (int r = c + 1; r < M; ++r) {
+                if (std::abs(E[r * M + c]) > std::abs(E[pivot * M + c])) pivot = r;
+            }
+            if (std::abs(E[pivot * M + c]) < 1e-12) return false;
+            if (pivot != c) {
+                for (int k = 0; k < M; ++k) std::swap(E[c * M + k], E[pivot * M + k]);
+                std::swap(b[c], b[pivot]);
+            }
+            for (int r = c + 1; r < M; ++r) {
+                const double factor = E[r * M + c] / E[c * M + c];
+                for (int k = c; k < M; ++k) E[r * M + k] -= factor * E[c * M + k];
+                b[r] -= factor * b[c];
+            }
+        }
+        for (int c = M - 1; c >= 0; --c) {
+            double v = b[c];
+            for (int k = c + 1; k < M; ++k) v -= E[c * M + k] * b[k];
+            b[c] = v / E[c * M + c];
+        }
+        for (int m = 0; m < M; ++m) {
+            if (!(b[m] > 1e-10)) return false;
+            intercept[m] = 1.0 / b[m];
+            if (!std::isfinite(intercept[m]) || intercept[m] < 1e-10) return false;
+        }
+        return true;
+    }
+
+    // Nearest reference line per member (perpendicular distance)
+    void associate(tf::Executor& executor, const double* refs, int num_refs, int M) {
+        const int s = static_cast<int>(members_.size());
+        niche_.resize(s);
+        distance_.resize(s);
+        ref_norm2_.resize(num_refs);
+        for (int j = 0; j < num_refs; ++j) {
+            double w2 = 0.0;
+            for (int m = 0; m < M; ++m) w2 += refs[j * M + m] * refs[j * M + m];
+            ref_norm2_[j] = w2;
+        }
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, s, 1, [&](int k) {
+            const double* x = normalized_.data() + static_cast<std::size_t>(k) * M;
+            double x2 = 0.0;
+            for (int m = 0; m < M; ++m) x2 += x[m] * x[m];
+            double best = std::numeric_limits<double>::infinity();
+            int arg = 0;
+            for (int j = 0; j < num_refs; ++j) {
+                const double* w = refs + static_cast<std::size_t>(j) * M;
+                double xw = 0.0;
+                for (int m = 0; m < M; ++m) xw += x[m] * w[m];
+                const double d2 = ref_norm2_[j] > 0.0 ? x2 - xw * xw / ref_norm2_[j] : x2;
+                if (d2 < best) {
+                    best = d2;
+                    arg = j;
+                }
+            }
+            niche_[k] = arg;
+            distance_[k] = std::sqrt(std::max(best, 0.0));
+        });
+        executor.run(taskflow).wait();
+    }
+
+    int M_ = 0;
+    int n_ = 0;
+    int num_fronts_ = 0;
+    std::vector<int> rank_;
+    std::vector<int> order_;
+    std::vector<int> floor_;  // front per presorted position
+    std::vector<std::vector<int>> fronts_;
+    std::vector<double> points_;
+    std::vector<std::vector<double>> front_points_;
+    std::vector<std::vector<double>> front_bounds_;  // per-objective maxima of each kBoundRows block
+
+    std::vector<double> crowding_;
+    std::vector<double> contribution_;
+    std::vector<std::vector<int>> by_objective_;
+
+    // NSGA-III scratch, indexed by position in members_
+    std::vector<int> members_;
+    std::vector<double> normalized_;
+    std::vector<double> ref_norm2_;
+    std::vector<int> niche_;
+    std::vector<double> distance_;
+    std::vector<int> niche_count_;
+    std::vector<std::vector<int>> candidates_;
+    std::vector<int> open_refs_;
+    std::vector<int> tied_;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,242 @@
+/**
+ * philox.hpp
+ *
+ * Counter-based random numbers (Philox4x32-10, Salmon et al. 2011).
+ *
+ * A draw is a pure function of (key, counter): the 64-bit seed is the key
+ * and the counter is (block, operator, individual, generation). Any
+ * stochastic operator can therefore run on any worker, in any order, and
+ * still reproduce the same stream bit for bit. Bulk fills process
+ * kPhiloxBatch independent blocks at a time as straight array loops, which
+ * compilers vectorize like Lanes<W>.
+ *
+ * Uniform doubles take the top 53 bits of a 64-bit word; normals use
+ * Box–Muller. No std:: distributions are involved, so the integer and
+ * uniform streams are identical across standard libraries.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace taskflow_bridge {
+
+// Operator tags keep streams of different operators on one individual apart
+enum class RandomOperator : std::uint32_t {
+    Generic = 0,
+    Mutation = 1,
+    Crossover = 2,
+    Selection = 3,
+    Hybrid = 4,
+    Sampling = 5,
+    Replacement = 6,
+};
+
+struct RandomKey {
+    std::uint64_t seed = 0;
+    std::uint32_t generation = 0;
+    std::uint32_t individual = 0;
+    RandomOperator op = RandomOperator::Generic;
+};
+
+using PhiloxBlock = std::array<std::uint32_t, 4>;
+
+namespace detail {
+
+constexpr std::uint32_t kPhiloxM0 = 0xD2511F53u;
+constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57u;
+constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9u;
+constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+inline void philox_round(std::uint32_t& c0, std::uint32_t& c1, std::uint32_t& c2, std::uint32_t& c3,
+                         std::uint32_t k0, std::uint32_t k1) {
+    const std::uint64_t p0 = static_cast<std::uint64_t>(kPhiloxM0) * c0;
+    const std::uint64_t p1 = static_cast<std::uint64_t>(kPhiloxM1) * c2;
+    const std::uint32_t hi0 = static_cast<std::uint32_t>(p0 >> 32), lo0 = static_cast<std::uint32_t>(p0);
+    const std::uint32_t hi1 = static_cast<std::uint32_t>(p1 >> 32), lo1 = static_cast<std::uint32_t>(p1);
+    c0 = hi1 ^ c1 ^ k0;
+    c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1;
+    c3 = lo0;
+}
+
+} // namespace detail
+
+inline PhiloxBlock philox4x32_10(PhiloxBlock counter, std::uint64_t key) {
+    std::uint32_t k0 = static_cast<std::uint32_t>(key);
+    std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+    for (int r = 0; r < 10; ++r) {
+        detail::philox_round(counter[0], counter[1], counter[2], counter[3], k0, k1);
+        k0 += detail::kPhiloxW0;
+        k1 += detail::kPhiloxW1;
+    }
+    return counter;
+}
+
+inline PhiloxBlock philox_counter(const RandomKey& key, std::uint32_t block) {
+    return {block, static_cast<std::uint32_t>(key.op), key.individual, key.generation};
+}
+
+inline double uniform_from_bits(std::uint64_t bits) {
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+constexpr int kPhiloxBatch = 8;
+
+/**
+ * Blocks first_block .. first_block + num_blocks - 1 of the stream, four
+ * words each, in counter order.
+ */
+inline void philox_fill(const RandomKey& key, std::uint32_t first_block, std::size_t num_blocks,
+                        std::uint32_t* out) {
+    const std::uint32_t op = static_cast<std::uint32_t>(key.op);
+    std::size_t b = 0;
+    for (; b + kPhiloxBatch <= num_blocks; b += kPhiloxBatch) {
+        std::uint32_t c0[kPhiloxBatch], c1[kPhiloxBatch], c2[kPhiloxBatch], c3[kPhiloxBatch];
+        for (int l = 0; l < kPhiloxBatch; ++l) {
+            c0[l] = first_block + static_cast<std::uint32_t>(b + l);
+            c1[l] = op;
+            c2[l] = key.individual;
+            c3[l] = key.generation;
+        }
+        std::uint32_t k0 = static_cast<std::uint32_t>(key.seed);
+        std::uint32_t k1 = static_cast<std::uint32_t>(key.seed >> 32);
+        for (int r = 0; r < 10; ++r) {
+            for (int l = 0; l < kPhiloxBatch; ++l) {
+                detail::philox_round(c0[l], c1[l], c2[l], c3[l], k0, k1);
+            }
+            k0 += detail::kPhiloxW0;
+            k1 += detail::kPhiloxW1;
+        }
+        for (int l = 0; l < kPhiloxBatch; ++l) {
+            std::uint32_t* o = out + 4 * (b + l);
+            o[0] = c0[l];
+            o[1] = c1[l];
+            o[2] = c2[l];
+            o[3] = c3[l];
+        }
+    }
+    for (; b < num_blocks; ++b) {
+        const PhiloxBlock r = philox4x32_10(philox_counter(key, first_block + static_cast<std::uint32_t>(b)), key.seed);
+        for (int w = 0; w < 4; ++w) out[4 * b + w] = r[w];
+    }
+}
+
+/**
+ * PhiloxStream
+ *
+ * Sequential view of one keyed stream; a UniformRandomBitGenerator. The
+ * n-th draw depends only on (key, n).
+ */
+class PhiloxStream {
+public:
+    using result_type = std::uint32_t;
+
+    explicit PhiloxStream(const RandomKey& key) : key_(key) {}
+
+    PhiloxStream(std::uint64_t seed, std::uint32_t generation, std::uint32_t individual, RandomOperator op)
+        : key_{seed, generation, individual, op} {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (word_ == 4) {
+            block_ = philox4x32_10(philox_counter(key_, next_block_++), key_.seed);
+            word_ = 0;
+        }
+        return block_[word_++];
+    }
+
+    std::uint64_t next_u64() {
+        const std::uint64_t hi = (*this)();
+        return (hi << 32) | (*this)();
+    }
+
+    // [0, 1)
+    double uniform() { return uniform_from_bits(next_u64()); }
+
+    // Unbiased integer in [0, bound) (Lemire's multiply-shift with rejection)
+    std::uint32_t below(std::uint32_t bound) {
+        std::uint64_t m = static_cast<std::uint64_t>((*this)()) * bound;
+        std::uint32_t low = static_cast<std::uint32_t>(m);
+        if (low < bound) {
+            const std::uint32_t threshold = static_cast<std::uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                m = static_cast<std::uint64_t>((*this)()) * bound;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32);
+    }
+
+    double normal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_;
+        }
+        const double u1 = 1.0 - uniform();  // (0, 1]
+        const double u2 = uniform();
+        const double radius = std::sqrt(-2.0 * std::log(u1));
+        const double angle = 6.283185307179586 * u2;
+        spare_ = radius * std::sin(angle);
+        has_spare_ = true;
+        return radius * std::cos(angle);
+    }
+
+    const RandomKey& key() const { return key_; }
+
+private:
+    RandomKey key_;
+    PhiloxBlock block_{};
+    std::uint32_t next_block_ = 0;
+    int word_ = 4;
+    double spare_ = 0.0;
+    bool has_spare_ = false;
+};
+
+// Uniform draws first .. first + n - 1 of PhiloxStream::uniform(), without the stream
+inline void philox_uniform_at(const RandomKey& key, std::size_t first, std::size_t n, double* out) {
+    constexpr std::size_t kChunkBlocks = 2 * kPhiloxBatch;
+    std::uint32_t words[4 * kChunkBlocks];
+    for (std::size_t i = 0; i < n;) {
+        // Uniform k uses words 2k and 2k + 1, i.e. half of block k / 2
+        const std::size_t k = first + i;
+        const std::size_t skip = k % 2;
+        const std::size_t count = std::min(2 * kChunkBlocks - skip, n - i);
+        philox_fill(key, static_cast<std::uint32_t>(k / 2), (skip + count + 1) / 2, words);
+        for (std::size_t j = 0; j < count; ++j) {
+            const std::size_t w = 2 * (skip + j);
+            out[i + j] = uniform_from_bits((static_cast<std::uint64_t>(words[w]) << 32) | words[w + 1]);
+        }
+        i += count;
+    }
+}
+
+inline void philox_uniform(const RandomKey& key, std::size_t n, double* out) {
+    philox_uniform_at(key, 0, n, out);
+}
+
+// n standard normals; out[i] equals the i-th PhiloxStream::normal() draw
+inline void philox_normal(const RandomKey& key, std::size_t n, double* out) {
+    constexpr std::size_t kPairs = 64;
+    double u[2 * kPairs];
+    for (std::size_t i = 0; i < n; i += 2 * kPairs) {
+        const std::size_t count = std::min<std::size_t>(2 * kPairs, n - i);
+        const std::size_t pairs = (count + 1) / 2;
+        philox_uniform_at(key, i, 2 * pairs, u);
+        for (std::size_t p = 0; p < pairs; ++p) {
+            const double radius = std::sqrt(-2.0 * std::log(1.0 - u[2 * p]));
+            const double angle = 6.283185307179586 * u[2 * p + 1];
+            out[i + 2 * p] = radius * std::cos(angle);
+            if (2 * p + 1 < count) out[i + 2 * p + 1] = radius * std::sin(angle);
+        }
+    }
+}
+
+} // namespace taskflow_bridge
@@ -0,0 +1,340 @@
+/**
+ * population_store.hpp
+ *
+ * Structure-of-arrays store for B-series genome populations.
+ *
+ * Every individual carries a coefficient for each tree of
+ * TreeArena::enumerate_up_to(max_order), so the population is one dense
+ * row-major (individual × tree) matrix. Ids are sequential 64-bit integers,
+ * and lineage is a compact array of two parent ids per row (-1 = none).
+ * Genetic operators and distances are then row kernels over contiguous
+ * memory, and per-tree statistics are column reductions. No tree is hashed
+ * and no dictionary is walked.
+ *
+ * Operators follow BSeriesGenome.jl: single-point crossover takes the first
+ * `point` coefficients from parent a; mutation adds 0.1·c·N(0, 1) to each
+ * coefficient with probability `rate`; distance is Euclidean.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+#include "philox.hpp"
+#include "tree_arena.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+using IndividualId = std::int64_t;
+
+constexpr IndividualId kNoParent = -1;
+
+/**
+ * PopulationStore
+ *
+ * Row pointers are invalidated by add and next_generation.
+ */
+class PopulationStore {
+public:
+    PopulationStore(TreeArena& arena, int max_order, int capacity = 0)
+        : trees_(arena.enumerate_up_to(max_order)), max_order_(max_order) {
+        if (trees_.empty()) {
+            throw std::runtime_error("Population needs max_order >= 1");
+        }
+        reserve(capacity);
+    }
+
+    void reserve(int capacity) {
+        const std::size_t n = std::max(capacity, 0);
+        coefficients_.reserve(n * num_trees());
+        ids_.reserve(n);
+        generations_.reserve(n);
+        parents_.reserve(2 * n);
+        fitness_.reserve(n);
+    }
+
+    // Rows
+
+    int add(const double* coefficients, int generation,
+            IndividualId parent_a = kNoParent, IndividualId parent_b = kNoParent) {
+        const int r = size();
+        coefficients_.insert(coefficients_.end(), coefficients, coefficients + num_trees());
+        ids_.push_back(next_id_++);
+        generations_.push_back(generation);
+        parents_.push_back(parent_a);
+        parents_.push_back(parent_b);
+        fitness_.push_back(0.0);
+        return r;
+    }
+
+    // Same coefficients, generation and parents under a new id (clone_genome)
+    int clone(int r) {
+        check_row(r);
+        std::vector<double> copy(row(r), row(r) + num_trees());
+        return add(copy.data(), generations_[r], parents_[2 * r], parents_[2 * r + 1]);
+    }
+
+    // point ∈ [1, num_trees]: the child takes row a's first `point` coefficients
+    int crossover(int a, int b, int point) {
+        check_row(a);
+        check_row(b);
+        check_point(point);
+        std::vector<double> child(num_trees());
+        write_crossover(row(a), row(b), point, child.data());
+        return add(child.data(), std::max(generations_[a], generations_[b]) + 1, ids_[a], ids_[b]);
+    }
+
+    void mutate(int r, double rate, PhiloxStream& rng) {
+        check_row(r);
+        mutate_row(row(r), rate, rng);
+    }
+
+    double distance(int a, int b) const {
+        check_row(a);
+        check_row(b);
+        return row_distance(row(a), row(b));
+    }
+
+    /**
+     * Replace the population by elites (copied with their ids) followed by
+     * one offspring per (parent_a[k], parent_b[k], points[k]). points[k] <= 0
+     * clones parent_a[k]. Offspring ids are assigned in k order before the
+     * parallel phase, and offspring k mutates with the Philox stream keyed
+     * (seed, epoch, k, Mutation), so the result is bit-identical whatever
+     * worker runs it. All arguments are checked before anything changes;
+     * the parallel phase cannot throw.
+     */
+    void next_generation(tf::Executor& executor, const int* elites, int num_elites,
+                         const int* parent_a, const int* parent_b, const int* points,
+                         int num_offspring, double mutation_rate, std::uint64_t seed) {
+        const int n = num_elites + num_offspring;
+        const std::size_t T = num_trees();
+        for (int k = 0; k < num_elites; ++k) check_row(elites[k]);
+        for (int k = 0; k < num_offspring; ++k) {
+            check_row(parent_a[k]);
+            if (points[k] > 0) {
+                check_row(parent_b[k]);
+                check_point(points[k]);
+            }
+        }
+
+        next_coefficients_.resize(n * T);
+        next_ids_.resize(n);
+        next_generations_.resize(n);
+        next_parents_.resize(2 * n);
+        next_fitness_.assign(n, 0.0);
+
+        for (int k = 0; k < num_elites; ++k) {
+            const int r = elites[k];
+            next_ids_[k] = ids_[r];
+            next_generations_[k] = generations_[r];
+            next_parents_[2 * k] = parents_[2 * r];
+            next_parents_[2 * k + 1] = parents_[2 * r + 1];
+            next_fitness_[k] = fitness_[r];
+        }
+        for (int k = 0; k < num_offspring; ++k) {
+            const int c = num_elites + k;
+            const int a = parent_a[k];
+            next_ids_[c] = next_id_++;
+            if (points[k] > 0) {
+                const int b = parent_b[k];
+                next_generations_[c] = std::max(generations_[a], generations_[b]) + 1;
+                next_parents_[2 * c] = ids_[a];
+                next_parents_[2 * c + 1] = ids_[b];
+            } else {
+                next_generations_[c] = generations_[a];
+                next_parents_[2 * c] = parents_[2 * a];
+                next_parents_[2 * c + 1] = parents_[2 * a + 1];
+            }
+        }
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, n, 1, [&](int c) {
+            double* out = next_coefficients_.data() + c * T;
+            if (c < num_elites) {
+                std::memcpy(out, row(elites[c]), T * sizeof(double));
+                return;
+            }
+            const int k = c - num_elites;
+            if (points[k] > 0) {
+                write_crossover(row(parent_a[k]), row(parent_b[k]), points[k], out);
+            } else {
+                std::memcpy(out, row(parent_a[k]), T * sizeof(double));
+            }
+            PhiloxStream rng(seed, epoch_, static_cast<std::uint32_t>(k), RandomOperator::Mutation);
+            mutate_row(out, mutation_rate, rng);
+        });
+        executor.run(taskflow).wait();
+
+        coefficients_.swap(next_coefficients_);
+        ids_.swap(next_ids_);
+        generations_.swap(next_generations_);
+        parents_.swap(next_parents_);
+        fitness_.swap(next_fitness_);
+        ++epoch_;
+    }
+
+    // Row-major size × size, D[i][j] = |c_i - c_j|
+    void distance_matrix(tf::Executor& executor, double* D) const {
+        const int n = size();
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, n, 1, [&](int i) {
+            D[static_cast<std::size_t>(i) * n + i] = 0.0;
+            for (int j = i + 1; j < n; ++j) {
+                const double d = row_distance(row(i), row(j));
+                D[static_cast<std::size_t>(i) * n + j] = d;
+                D[static_cast<std::size_t>(j) * n + i] = d;
+            }
+        });
+        executor.run(taskflow).wait();
+    }
+
+    // Mean pairwise distance (population_diversity) without materialising D
+    double diversity(tf::Executor& executor) const {
+        const int n = size();
+        if (n < 2) return 0.0;
+        std::vector<double> partial(n, 0.0);
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, n, 1, [&](int i) {
+            double s = 0.0;
+            for (int j = i + 1; j < n; ++j) s += row_distance(row(i), row(j));
+            partial[i] = s;
+        });
+        executor.run(taskflow).wait();
+        double total = 0.0;
+        for (double s : partial) total += s;
+        return total / (0.5 * n * (n - 1.0));
+    }
+
+    // Per-tree mean and (population) variance; streams rows once
+    void column_moments(double* mean, double* variance) const {
+        const int T = num_trees();
+        std::fill(mean, mean + T, 0.0);
+        std::fill(variance, variance + T, 0.0);
+        const int n = size();
+        if (n == 0) return;
+        for (int r = 0; r < n; ++r) {
+            const double* c = row(r);
+            for (int t = 0; t < T; ++t) mean[t] += c[t];
+        }
+        for (int t = 0; t < T; ++t) mean[t] /= n;
+        for (int r = 0; r < n; ++r) {
+            const double* c = row(r);
+            for (int t = 0; t < T; ++t) variance[t] += (c[t] - mean[t]) * (c[t] - mean[t]);
+        }
+        for (int t = 0; t < T; ++t) variance[t] /= n;
+    }
+
+    // Accessors
+
+    int size() const { return static_cast<int>(ids_.size()); }
+    int num_trees() const { return static_cast<int>(trees_.size()); }
+    int max_order() const { return max_order_; }
+    // Number of next_generation calls so far; the generation word of mutation keys
+    std::uint32_t epoch() const { return epoch_; }
+    const std::vector<TreeId>& trees() const { return trees_; }
+
+    double* row(int r) { return coefficients_.data() + static_cast<std::size_t>(r) * trees_.size(); }
+    const double* row(int r) const { return coefficients_.data() + static_cast<std::size_t>(r) * trees_.size(); }
+    const std::vector<double>& coefficients() const { return coefficients_; }
+
+    IndividualId id(int r) const { return ids_[r]; }
+    int generation(int r) const { return generations_[r]; }
+    const IndividualId* parents(int r) const { return parents_.data() + 2 * r; }
+    const std::vector<IndividualId>& ids() const { return ids_; }
+    const std::vector<IndividualId>& parent_ids() const { return parents_; }
+
+    double fitness(int r) const { return fitness_[r]; }
+    std::vector<double>& fitness() { return fitness_; }
+    const std::vector<double>& fitness() const { return fitness_; }
+
+    // Checkpoints (the arena is saved separately)
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<std::int64_t>(prefix + "meta", {max_order_, next_id_, epoch_});
+        writer.add(prefix + "trees", trees_);
+        writer.add(prefix + "coefficients", coefficients_);
+        writer.add(prefix + "ids", ids_);
+        writer.add(prefix + "generations", generations_);
+        writer.add(prefix + "parents", parents_);
+        writer.add(prefix + "fitness", fitness_);
+    }
+
+    // Built with the saved max_order on the restored arena
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto meta = reader.column<std::int64_t>(prefix + "meta", 3);
+        if (meta[0] != max_order_ || !std::equal(trees_.begin(), trees_.end(), reader.column<TreeId>(prefix + "trees", trees_.size()).begin())) {
+            throw std::runtime_error("Checkpoint population was built over other trees");
+        }
+        const auto ids = reader.column<IndividualId>(prefix + "ids");
+        const std::size_t n = ids.size;
+        coefficients_ = reader.column<double>(prefix + "coefficients", n * trees_.size()).to_vector();
+        ids_ = ids.to_vector();
+        generations_ = reader.column<int>(prefix + "generations", n).to_vector();
+        parents_ = reader.column<IndividualId>(prefix + "parents", 2 * n).to_vector();
+        fitness_ = reader.column<double>(prefix + "fitness", n).to_vector();
+        next_id_ = meta[1];
+        epoch_ = static_cast<std::uint32_t>(meta[2]);
+    }
+
+private:
+    void check_row(int r) const {
+        if (r < 0 || r >= size()) {
+            throw std::runtime_error("Population row out of range: " + std::to_string(r));
+        }
+    }
+
+    void check_point(int point) const {
+        if (point < 1 || point > num_trees()) {
+            throw std::runtime_error("Crossover point out of range: " + std::to_string(point));
+        }
+    }
+
+    // point must have passed check_point
+    void write_crossover(const double* a, const double* b, int point, double* out) const noexcept {
+        const int T = num_trees();
+        std::memcpy(out, a, point * sizeof(double));
+        std::memcpy(out + point, b + point, (T - point) * sizeof(double));
+    }
+
+    void mutate_row(double* c, double rate, PhiloxStream& rng) const {
+        for (int t = 0; t < num_trees(); ++t) {
+            if (rng.uniform() < rate) c[t] += 0.1 * c[t] * rng.normal();
+        }
+    }
+
+    double row_distance(const double* a, const double* b) const {
+        double s = 0.0;
+        for (int t = 0; t < num_trees(); ++t) s += (a[t] - b[t]) * (a[t] - b[t]);
+        return std::sqrt(s);
+    }
+
+    std::vector<TreeId> trees_;
+    int max_order_;
+    IndividualId next_id_ = 0;
+    std::uint32_t epoch_ = 0;
+
+    std::vector<double> coefficients_;
+    std::vector<IndividualId> ids_;
+    std::vector<int> generations_;
+    std::vector<IndividualId> parents_;
+    std::vector<double> fitness_;
+
+    // Double buffer for next_generation
+    std::vector<double> next_coefficients_;
+    std::vector<IndividualId> next_ids_;
+    std::vector<int> next_generations_;
+    std::vector<IndividualId> next_parents_;
+    std::vector<double> next_fitness_;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,182 @@
+/**
+ * rhs_kernel.hpp
+ *
+ * Type-erased right-hand side kernels y' = f(y) for the native integrators.
+ *
+ * A kernel is any functor with
+ *
+ *     template <class Scalar>
+ *     void operator()(const Scalar* y, Scalar* dy) const;
+ *
+ * so that the same source is evaluated on doubles and on hyper-dual numbers
+ * (exact higher-order directional derivatives). RhsKernel exposes one virtual
+ * entry point per supported scalar type; make_rhs_kernel() instantiates all
+ * of them from a generic functor.
+ *
+ * Ensemble integration additionally calls the kernel on SimdLanes packs (one
+ * trajectory per lane). By default those entry points evaluate lane by lane
+ * through the scalar ones; make_vector_rhs_kernel() instantiates the functor
+ * on the packs directly, which requires branch-free kernel source.
+ */
+
+#pragma once
+
+#include "hyper_dual.hpp"
+#include "simd_lanes.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+// Largest number of simultaneous derivative directions a kernel supports.
+// A tree node with m children needs m directions, so this bounds the
+// bushiest tree the elementary differential engine can evaluate.
+constexpr int kMaxDualDirections = 7;
+
+// X-macro over the scalar types every kernel is instantiated for
+#define DTE_RHS_KERNEL_SCALARS(X) \
+    X(double)                     \
+    X(HyperDual<1>)               \
+    X(HyperDual<2>)               \
+    X(HyperDual<3>)               \
+    X(HyperDual<4>)               \
+    X(HyperDual<5>)               \
+    X(HyperDual<6>)               \
+    X(HyperDual<7>)
+
+template <int K>
+using LaneDual = HyperDual<K, SimdLanes>;
+
+// X-macro over (packed, per-lane) scalar pairs used by the ensemble engine
+#define DTE_RHS_KERNEL_LANE_SCALARS(X) \
+    X(SimdLanes, double)               \
+    X(LaneDual<1>, HyperDual<1>)       \
+    X(LaneDual<2>, HyperDual<2>)       \
+    X(LaneDual<3>, HyperDual<3>)       \
+    X(LaneDual<4>, HyperDual<4>)       \
+    X(LaneDual<5>, HyperDual<5>)       \
+    X(LaneDual<6>, HyperDual<6>)       \
+    X(LaneDual<7>, HyperDual<7>)
+
+namespace detail {
+
+template <int W>
+double lane_get(const Lanes<W>& x, int l) { return x.v[l]; }
+
+template <int W>
+void lane_set(Lanes<W>& x, int l, double value) { x.v[l] = value; }
+
+template <int K, int W>
+HyperDual<K> lane_get(const HyperDual<K, Lanes<W>>& x, int l) {
+    HyperDual<K> r;
+    for (std::size_t s = 0; s < r.c.size(); ++s) r.c[s] = x.c[s].v[l];
+    return r;
+}
+
+template <int K, int W>
+void lane_set(HyperDual<K, Lanes<W>>& x, int l, const HyperDual<K>& value) {
+    for (std::size_t s = 0; s < value.c.size(); ++s) x.c[s].v[l] = value.c[s];
+}
+
+} // namespace detail
+
+/**
+ * RhsKernel
+ *
+ * Abstract vector field of fixed dimension.
+ */
+class RhsKernel {
+public:
+    explicit RhsKernel(int dim, std::string name = "rhs")
+        : dim_(dim), name_(std::move(name)) {}
+
+    virtual ~RhsKernel() = default;
+
+    int dim() const { return dim_; }
+    const std::string& name() const { return name_; }
+
+#define DTE_DECLARE_EVAL(Scalar) \
+    virtual void eval(const Scalar* y, Scalar* dy) const = 0;
+    DTE_RHS_KERNEL_SCALARS(DTE_DECLARE_EVAL)
+#undef DTE_DECLARE_EVAL
+
+#define DTE_DECLARE_LANE_EVAL(Packed, Scalar)                   \
+    virtual void eval(const Packed* y, Packed* dy) const {      \
+        eval_lanewise<Scalar>(y, dy);                           \
+    }
+    DTE_RHS_KERNEL_LANE_SCALARS(DTE_DECLARE_LANE_EVAL)
+#undef DTE_DECLARE_LANE_EVAL
+
+protected:
+    // Fallback for packed scalars: gather each lane, evaluate, scatter
+    template <class Scalar, class Packed>
+    void eval_lanewise(const Packed* y, Packed* dy) const {
+        thread_local std::vector<Scalar> ys;
+        thread_local std::vector<Scalar> dys;
+        ys.resize(dim_);
+        dys.resize(dim_);
+        for (int l = 0; l < kSimdLanes; ++l) {
+            for (int i = 0; i < dim_; ++i) ys[i] = detail::lane_get(y[i], l);
+            eval(ys.data(), dys.data());
+            for (int i = 0; i < dim_; ++i) detail::lane_set(dy[i], l, dys[i]);
+        }
+    }
+
+private:
+    int dim_;
+    std::string name_;
+};
+
+/**
+ * FunctorKernel
+ *
+ * Adapts a generic functor to every RhsKernel entry point.
+ */
+template <class F>
+class FunctorKernel : public RhsKernel {
+public:
+    FunctorKernel(F f, int dim, std::string name)
+        : RhsKernel(dim, std::move(name)), f_(std::move(f)) {}
+
+    using RhsKernel::eval;
+
+#define DTE_DEFINE_EVAL(Scalar) \
+    void eval(const Scalar* y, Scalar* dy) const override { f_(y, dy); }
+    DTE_RHS_KERNEL_SCALARS(DTE_DEFINE_EVAL)
+#undef DTE_DEFINE_EVAL
+
+protected:
+    F f_;
+};
+
+/**
+ * VectorFunctorKernel
+ *
+ * FunctorKernel that also runs the functor directly on SimdLanes packs.
+ */
+template <class F>
+class VectorFunctorKernel final : public FunctorKernel<F> {
+public:
+    using FunctorKernel<F>::FunctorKernel;
+    using FunctorKernel<F>::eval;
+
+#define DTE_DEFINE_LANE_EVAL(Packed, Scalar) \
+    void eval(const Packed* y, Packed* dy) const override { this->f_(y, dy); }
+    DTE_RHS_KERNEL_LANE_SCALARS(DTE_DEFINE_LANE_EVAL)
+#undef DTE_DEFINE_LANE_EVAL
+};
+
+template <class F>
+std::shared_ptr<RhsKernel> make_rhs_kernel(F f, int dim, std::string name = "rhs") {
+    return std::make_shared<FunctorKernel<F>>(std::move(f), dim, std::move(name));
+}
+
+template <class F>
+std::shared_ptr<RhsKernel> make_vector_rhs_kernel(F f, int dim, std::string name = "rhs") {
+    return std::make_shared<VectorFunctorKernel<F>>(std::move(f), dim, std::move(name));
+}
+
+} // namespace taskflow_bridge
@@ -0,0 +1,300 @@
+/**
+ * riemannian_surface.hpp
+ *
+ * Native J-surface position for Riemannian gradient descent on B-series
+ * coefficients, c ← c - η M⁻¹ g.
+ *
+ * The metric M is held as its Cholesky factor M = RᵀR (R upper triangular,
+ * row-major, so every inner loop is contiguous). A step solves with R instead
+ * of inverting M, costing O(n²) and no allocation. When the metric changes by
+ * a low-rank term M ± Σ v vᵀ the factor is updated in O(k n²) rather than
+ * refactored in O(n³). Past positions go to a bounded ring of snapshots.
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * CholeskyFactor
+ *
+ * Upper-triangular R with A = RᵀR for a symmetric positive definite A.
+ */
+class CholeskyFactor {
+public:
+    explicit CholeskyFactor(int n) : n_(n), R_(static_cast<std::size_t>(n) * n, 0.0),
+                                     backup_(R_.size()), work_(n) {
+        for (int i = 0; i < n; ++i) at(i, i) = 1.0;
+    }
+
+    // Full O(n³) factorization of row-major A (only the upper triangle is read)
+    void factorize(const double* A) {
+        const int n = n_;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < i; ++j) at(i, j) = 0.0;
+            for (int j = i; j < n; ++j) at(i, j) = A[static_cast<std::size_t>(i) * n + j];
+        }
+        for (int k = 0; k < n; ++k) {
+            const double pivot = at(k, k);
+            if (!(pivot > 0.0)) {
+                throw std::runtime_error("Metric is not positive definite");
+            }
+            const double r = std::sqrt(pivot);
+            double* row_k = row(k);
+            for (int j = k; j < n; ++j) row_k[j] /= r;
+            for (int i = k + 1; i < n; ++i) {
+                const double rki = row_k[i];
+                double* row_i = row(i);
+                for (int j = i; j < n; ++j) row_i[j] -= rki * row_k[j];
+            }
+        }
+    }
+
+    /**
+     * A ← A + sign · x xᵀ in O(n²); x is not modified. A downdate that
+     * would lose definiteness throws and leaves the factor unchanged.
+     */
+    void rank_one_update(const double* x, double sign) {
+        rank_k_update(x, &sign, 1);
+    }
+
+    /**
+     * A ← A + Σ_r signs[r] · V_r V_rᵀ for the k rows of V (row-major k × n).
+     * Non-finite input is rejected before R is touched; if any downdate
+     * fails, all k updates are undone.
+     */
+    void rank_k_update(const double* V, const double* signs, int k) {
+        const auto finite = [](double v) { return std::isfinite(v); };
+        if (!std::all_of(signs, signs + k, finite) ||
+            !std::all_of(V, V + static_cast<std::size_t>(k) * n_, finite)) {
+            throw std::runtime_error("Metric update is not finite");
+        }
+        std::copy(R_.begin(), R_.end(), backup_.begin());
+        for (int r = 0; r < k; ++r) {
+            const bool downdate = signs[r] < 0.0;
+            if (!apply_rank_one(V + static_cast<std::size_t>(r) * n_, downdate)) {
+                std::copy(backup_.begin(), backup_.end(), R_.begin());
+                throw std::runtime_error(downdate ? "Metric downdate is not positive definite"
+                                                  : "Metric update is not positive definite");
+            }
+        }
+    }
+
+    // Solve A x = b in place (forward with Rᵀ, backward with R)
+    void solve(double* x) const {
+        const int n = n_;
+        for (int j = 0; j < n; ++j) {
+            const double* row_j = row(j);
+            x[j] /= row_j[j];
+            const double xj = x[j];
+            for (int i = j + 1; i < n; ++i) x[i] -= row_j[i] * xj;
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            const double* row_i = row(i);
+            double acc = x[i];
+            for (int j = i + 1; j < n; ++j) acc -= row_i[j] * x[j];
+            x[i] = acc / row_i[i];
+        }
+    }
+
+    // xᵀ A x = |R x|²
+    double quadratic_form(const double* x) const {
+        const int n = n_;
+        double acc = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double* row_i = row(i);
+            double v = 0.0;
+            for (int j = i; j < n; ++j) v += row_i[j] * x[j];
+            acc += v * v;
+        }
+        return acc;
+    }
+
+    int size() const { return n_; }
+    const std::vector<double>& factor() const { return R_; }
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const { writer.add(prefix + "R", R_); }
+
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto R = reader.column<double>(prefix + "R", R_.size());
+        std::copy(R.begin(), R.end(), R_.begin());
+    }
+
+private:
+    // One Givens sweep of x into R; false when a downdate loses definiteness
+    bool apply_rank_one(const double* x, bool downdate) {
+        const int n = n_;
+        std::copy(x, x + n, work_.begin());
+        for (int k = 0; k < n; ++k) {
+            double* row_k = row(k);
+            const double rkk = row_k[k];
+            const double xk = work_[k];
+            const double r2 = downdate ? rkk * rkk - xk * xk : rkk * rkk + xk * xk;
+            if (!(r2 > 0.0)) return false;
+            const double r = std::sqrt(r2);
+            const double c = r / rkk;
+            const double s = xk / rkk;
+            row_k[k] = r;
+            if (downdate) {
+                for (int i = k + 1; i < n; ++i) {
+                    row_k[i] = (row_k[i] - s * work_[i]) / c;
+                    work_[i] = c * work_[i] - s * row_k[i];
+                }
+            } else {
+                for (int i = k + 1; i < n; ++i) {
+                    row_k[i] = (row_k[i] + s * work_[i]) / c;
+                    work_[i] = c * work_[i] - s * row_k[i];
+                }
+            }
+        }
+        return true;
+    }
+
+    double& at(int i, int j) { return R_[static_cast<std::size_t>(i) * n_ + j]; }
+    double* row(int i) { return R_.data() + static_cast<std::size_t>(i) * n_; }
+    const double* row(int i) const { return R_.data() + static_cast<std::size_t>(i) * n_; }
+
+    int n_;
+    std::vector<double> R_;
+    std::vector<double> backup_;
+    std::vector<double> work_;
+};
+
+/**
+ * CoefficientHistory
+ *
+ * Fixed-capacity ring of coefficient snapshots; the oldest is overwritten.
+ */
+class CoefficientHistory {
+public:
+    CoefficientHistory(int dim, int capacity)
+        : dim_(dim), capacity_(std::max(capacity, 1)),
+          data_(static_cast<std::size_t>(dim) * capacity_) {}
+
+    void push(const double* c) {
+        std::copy(c, c + dim_, data_.begin() + static_cast<std::size_t>(head_) * dim_);
+        head_ = (head_ + 1) % capacity_;
+        ++total_;
+    }
+
+    int size() const { return static_cast<int>(std::min<std::uint64_t>(total_, capacity_)); }
+    int capacity() const { return capacity_; }
+    std::uint64_t total() const { return total_; }
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<std::int64_t>(prefix + "ring", {capacity_, head_, static_cast<std::int64_t>(total_)});
+        writer.add(prefix + "snapshots", data_);
+    }
+
+    // The ring must have the saved dimension and capacity
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto ring = reader.column<std::int64_t>(prefix + "ring", 3);
+        if (ring[0] != capacity_ || ring[1] < 0 || ring[1] >= capacity_) {
+            throw std::runtime_error("Checkpoint history has another capacity");
+        }
+        const auto snapshots = reader.column<double>(prefix + "snapshots", data_.size());
+        std::copy(snapshots.begin(), snapshots.end(), data_.begin());
+        head_ = static_cast<int>(ring[1]);
+        total_ = static_cast<std::uint64_t>(ring[2]);
+    }
+
+    // k = 0 is the most recent snapshot
+    const double* at(int k) const {
+        if (k < 0 || k >= size()) {
+            throw std::runtime_error("History index out of range: " + std::to_string(k));
+        }
+        const int slot = ((head_ - 1 - k) % capacity_ + capacity_) % capacity_;
+        return data_.data() + static_cast<std::size_t>(slot) * dim_;
+    }
+
+private:
+    int dim_;
+    int capacity_;
+    std::vector<double> data_;
+    int head_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+/**
+ * RiemannianSurface
+ *
+ * Coefficients, factored metric and bounded history. The metric defaults to
+ * the identity, matching JSurfaceIntegrator.JSurface.
+ */
+class RiemannianSurface {
+public:
+    RiemannianSurface(std::vector<double> coefficients, int history_capacity)
+        : coefficients_(std::move(coefficients)),
+          metric_(static_cast<int>(coefficients_.size())),
+          history_(static_cast<int>(coefficients_.size()), history_capacity),
+          direction_(coefficients_.size()) {
+        history_.push(coefficients_.data());
+    }
+
+    // Replace the metric (row-major n × n) and refactor
+    void set_metric(const double* M) { metric_.factorize(M); }
+
+    // M ← M + Σ_r signs[r] · V_r V_rᵀ for the k rows of V (row-major k × n); all or nothing
+    void update_metric(const double* V, const double* signs, int k) {
+        metric_.rank_k_update(V, signs, k);
+    }
+
+    // c ← c - η M⁻¹ g
+    void gradient_step(const double* gradient, double step_size) {
+        const int n = dim();
+        std::copy(gradient, gradient + n, direction_.begin());
+        metric_.solve(direction_.data());
+        for (int i = 0; i < n; ++i) coefficients_[i] -= step_size * direction_[i];
+        history_.push(coefficients_.data());
+        ++steps_;
+    }
+
+    // sqrt((c' - c)ᵀ M (c' - c))
+    double distance_to(const double* other) {
+        const int n = dim();
+        for (int i = 0; i < n; ++i) direction_[i] = other[i] - coefficients_[i];
+        return std::sqrt(std::max(0.0, metric_.quadratic_form(direction_.data())));
+    }
+
+    int dim() const { return static_cast<int>(coefficients_.size()); }
+    std::vector<double>& coefficients() { return coefficients_; }
+    const CholeskyFactor& metric() const { return metric_; }
+    const CoefficientHistory& history() const { return history_; }
+    std::uint64_t steps() const { return steps_; }
+
+    // Checkpoints
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add_values<std::int64_t>(prefix + "meta", {static_cast<std::int64_t>(steps_)});
+        writer.add(prefix + "coefficients", coefficients_);
+        metric_.save(writer, prefix + "metric.");
+        history_.save(writer, prefix + "history.");
+    }
+
+    // Built with the saved coefficients and history capacity
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto coefficients = reader.column<double>(prefix + "coefficients", coefficients_.size());
+        std::copy(coefficients.begin(), coefficients.end(), coefficients_.begin());
+        metric_.restore(reader, prefix + "metric.");
+        history_.restore(reader, prefix + "history.");
+        steps_ = static_cast<std::uint64_t>(reader.column<std::int64_t>(prefix + "meta", 1)[0]);
+    }
+
+private:
+    std::vector<double> coefficients_;
+    CholeskyFactor metric_;
+    CoefficientHistory history_;
+    std::vector<double> direction_;
+    std::uint64_t steps_ = 0;
+};
+
+} // namespace taskflow_bridge
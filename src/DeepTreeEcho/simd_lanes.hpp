@@ -0,0 +1,101 @@
+/**
+ * simd_lanes.hpp
+ *
+ * Fixed-width pack of doubles evaluated lane-wise.
+ *
+ * Lanes<W> is a plain aligned array with element-wise arithmetic and math
+ * functions written as straight loops, which compilers vectorize at -O3
+ * (-march=native picks up AVX2/AVX-512). It is the scalar type the ensemble
+ * integrator feeds to vectorized kernels, so W trajectories advance in one
+ * kernel call.
+ */
+
+#pragma once
+
+#include <cmath>
+
+namespace taskflow_bridge {
+
+#ifndef DTE_SIMD_LANES
+#define DTE_SIMD_LANES 4
+#endif
+
+constexpr int kSimdLanes = DTE_SIMD_LANES;
+
+template <int W>
+struct alignas(sizeof(double) * W) Lanes {
+    double v[W];
+
+    Lanes() = default;
+
+    Lanes(double x) {
+        for (int l = 0; l < W; ++l) v[l] = x;
+    }
+
+    double& operator[](int l) { return v[l]; }
+    double operator[](int l) const { return v[l]; }
+
+#define DTE_LANES_COMPOUND(op)                                  \
+    Lanes& operator op(const Lanes& o) {                        \
+        for (int l = 0; l < W; ++l) v[l] op o.v[l];             \
+        return *this;                                           \
+    }
+    DTE_LANES_COMPOUND(+=)
+    DTE_LANES_COMPOUND(-=)
+    DTE_LANES_COMPOUND(*=)
+    DTE_LANES_COMPOUND(/=)
+#undef DTE_LANES_COMPOUND
+
+    Lanes operator-() const {
+        Lanes r;
+        for (int l = 0; l < W; ++l) r.v[l] = -v[l];
+        return r;
+    }
+
+    friend Lanes operator+(Lanes a, const Lanes& b) { return a += b; }
+    friend Lanes operator-(Lanes a, const Lanes& b) { return a -= b; }
+    friend Lanes operator*(Lanes a, const Lanes& b) { return a *= b; }
+    friend Lanes operator/(Lanes a, const Lanes& b) { return a /= b; }
+};
+
+#define DTE_LANES_UNARY(fn)                                     \
+    template <int W>                                            \
+    Lanes<W> fn(const Lanes<W>& x) {                            \
+        Lanes<W> r;                                             \
+        for (int l = 0; l < W; ++l) r.v[l] = std::fn(x.v[l]);   \
+        return r;                                               \
+    }
+DTE_LANES_UNARY(exp)
+DTE_LANES_UNARY(log)
+DTE_LANES_UNARY(sin)
+DTE_LANES_UNARY(cos)
+DTE_LANES_UNARY(tan)
+DTE_LANES_UNARY(sqrt)
+DTE_LANES_UNARY(tanh)
+DTE_LANES_UNARY(abs)
+#undef DTE_LANES_UNARY
+
+template <int W>
+Lanes<W> pow(const Lanes<W>& x, const Lanes<W>& y) {
+    Lanes<W> r;
+    for (int l = 0; l < W; ++l) r.v[l] = std::pow(x.v[l], y.v[l]);
+    return r;
+}
+
+template <int W>
+Lanes<W> pow(const Lanes<W>& x, double y) {
+    Lanes<W> r;
+    for (int l = 0; l < W; ++l) r.v[l] = std::pow(x.v[l], y);
+    return r;
+}
+
+template <int W>
+Lanes<W> fma(const Lanes<W>& a, const Lanes<W>& b, const Lanes<W>& c) {
+    Lanes<W> r;
+    for (int l = 0; l < W; ++l) r.v[l] = std::fma(a.v[l], b.v[l], c.v[l]);
+    return r;
+}
+
+using SimdLanes = Lanes<kSimdLanes>;
+
+} // namespace taskflow_bridge
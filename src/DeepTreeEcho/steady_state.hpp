@@ -0,0 +1,321 @@
+/**
+ * steady_state.hpp
+ *
+ * Asynchronous steady-state evolution.
+ *
+ * A generational loop (evolve_generation!) waits at every barrier for its
+ * slowest individual. SteadyStateEngine has no barrier. Each worker runs its
+ * own loop: claim a ticket, select two parents, breed one child, evaluate
+ * it, and insert it into the shared population. Throughput is then bounded
+ * by evaluation speed, not by stragglers.
+ *
+ * The population is a fixed set of slots holding fixed-length genomes.
+ * Fitness values are atomics, so selection scans need no lock. Each slot
+ * also has its own mutex, held only while one genome is copied in or out.
+ * No lock is held during evaluation and no thread ever holds two locks.
+ *
+ * Plug points mirror evolve_generation!: select (tournament by default),
+ * crossover, mutate, and a crossover/mutation rate gating each. C++ callers
+ * override SteadyStateOperators; Julia supplies crossover and mutate through
+ * CompiledOperators (compiled_kernel.hpp). Insertion
+ * follows a ReplacementPolicy:
+ *   ReplaceWorst       the child replaces the current worst slot if better
+ *   TournamentReplace  the child replaces the worst of a random tournament
+ *                      if better
+ * Ticket t draws from Philox streams keyed (seed, run, t, operator). A run
+ * is therefore reproducible given the population each ticket saw, but
+ * interleaving makes the final population schedule-dependent.
+ */
+
+#pragma once
+
+#include "fitness_service.hpp"
+#include "philox.hpp"
+#include "population_store.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+enum class ReplacementPolicy : std::uint8_t {
+    ReplaceWorst = 0,
+    TournamentReplace = 1,
+};
+
+// Live fitness of the population; values may change between reads
+struct FitnessView {
+    const std::atomic<double>* values;
+    int size;
+
+    double operator[](int i) const { return values[i].load(std::memory_order_relaxed); }
+};
+
+/**
+ * SteadyStateOperators
+ *
+ * The defaults follow Evolution.jl / BSeriesGenome.jl: tournament selection,
+ * single-point crossover, and mutate!(genome, 0.1), which perturbs each
+ * coefficient by 0.1·c·N(0, 1) with probability gene_rate. Override any of
+ * them; all must be safe to call concurrently.
+ */
+class SteadyStateOperators {
+public:
+    explicit SteadyStateOperators(int tournament_size = 3, double gene_rate = 0.1)
+        : tournament_size_(tournament_size), gene_rate_(gene_rate) {
+        if (tournament_size < 1) {
+            throw std::runtime_error("Tournament size must be at least 1");
+        }
+    }
+
+    virtual ~SteadyStateOperators() = default;
+
+    virtual int select(const FitnessView& fitness, PhiloxStream& rng) const {
+        int best = static_cast<int>(rng.below(fitness.size));
+        for (int k = 1; k < tournament_size_; ++k) {
+            const int i = static_cast<int>(rng.below(fitness.size));
+            if (fitness[i] > fitness[best]) best = i;
+        }
+        return best;
+    }
+
+    virtual void crossover(const double* a, const double* b, int length, double* child, PhiloxStream& rng) const {
+        const int point = length > 1 ? 1 + static_cast<int>(rng.below(length - 1)) : length;
+        std::memcpy(child, a, point * sizeof(double));
+        std::memcpy(child + point, b + point, (length - point) * sizeof(double));
+    }
+
+    virtual void mutate(double* genome, int length, PhiloxStream& rng) const {
+        for (int k = 0; k < length; ++k) {
+            if (rng.uniform() < gene_rate_) genome[k] += 0.1 * genome[k] * rng.normal();
+        }
+    }
+
+    int tournament_size() const { return tournament_size_; }
+
+private:
+    int tournament_size_;
+    double gene_rate_;
+};
+
+struct SteadyStateParams {
+    double crossover_rate = 0.7;
+    double mutation_rate = 0.1;
+    ReplacementPolicy policy = ReplacementPolicy::ReplaceWorst;
+    int replace_tournament_size = 3;
+    double timeout_seconds = 0.0;   // <= 0: no deadline
+    double penalty = -1e300;        // fitness of timed-out or failed children
+};
+
+/**
+ * SteadyStateEngine
+ */
+class SteadyStateEngine {
+public:
+    SteadyStateEngine(std::shared_ptr<const FitnessKernel> kernel, int genome_length, SteadyStateParams params,
+                      std::shared_ptr<const SteadyStateOperators> operators = nullptr)
+        : kernel_(std::move(kernel)),
+          operators_(operators ? std::move(operators) : std::make_shared<SteadyStateOperators>()),
+          length_(genome_length),
+          params_(params) {
+        if (genome_length < 1) {
+            throw std::runtime_error("Genome length must be positive");
+        }
+        if (params.replace_tournament_size < 1) {
+            throw std::runtime_error("Replacement tournament size must be at least 1");
+        }
+    }
+
+    // Row-major num_individuals × genome_length; evaluates everyone in parallel
+    void initialize(tf::Executor& executor, const double* genomes, int num_individuals) {
+        if (num_individuals < 2) {
+            throw std::runtime_error("Steady-state population needs at least 2 individuals");
+        }
+        size_ = num_individuals;
+        genomes_.assign(genomes, genomes + static_cast<std::size_t>(num_individuals) * length_);
+        fitness_.reset(new std::atomic<double>[num_individuals]);
+        locks_.reset(new std::mutex[num_individuals]);
+        ids_.resize(num_individuals);
+        parents_.assign(2 * num_individuals, kNoParent);
+        for (int i = 0; i < num_individuals; ++i) ids_[i] = i;
+        next_id_ = num_individuals;
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, num_individuals, 1, [&](int i) {
+            fitness_[i].store(evaluate(genome(i)), std::memory_order_relaxed);
+        });
+        executor.run(taskflow).wait();
+        evaluations_ += num_individuals;
+    }
+
+    /**
+     * Breed and insert num_evaluations children, one worker loop per
+     * executor worker. Returns when the last claimed child is inserted.
+     */
+    void run(tf::Executor& executor, std::int64_t num_evaluations, std::uint64_t seed) {
+        if (size_ == 0) {
+            throw std::runtime_error("Steady-state population is not initialized");
+        }
+        using clock = std::chrono::steady_clock;
+        std::atomic<std::int64_t> next_ticket{0};
+        std::atomic<std::int64_t> accepted{0};
+        const std::uint32_t run = runs_;
+        const std::int64_t first_id = next_id_;
+
+        const auto start = clock::now();
+        tf::Taskflow taskflow;
+        const int workers = std::max<int>(1, static_cast<int>(executor.num_workers()));
+        for (int w = 0; w < workers; ++w) {
+            taskflow.emplace([&, run, first_id, seed] {
+                std::vector<double> a(length_), b(length_), child(length_);
+                const FitnessView view{fitness_.get(), size_};
+                for (std::int64_t t = next_ticket.fetch_add(1); t < num_evaluations; t = next_ticket.fetch_add(1)) {
+                    const std::uint32_t ticket = static_cast<std::uint32_t>(t);
+                    PhiloxStream select_rng(seed, run, ticket, RandomOperator::Selection);
+                    const int pa = operators_->select(view, select_rng);
+                    const int pb = operators_->select(view, select_rng);
+                    const IndividualId id_a = copy_out(pa, a.data());
+                    const IndividualId id_b = copy_out(pb, b.data());
+
+                    PhiloxStream cross_rng(seed, run, ticket, RandomOperator::Crossover);
+                    IndividualId parent_b = kNoParent;
+                    if (cross_rng.uniform() < params_.crossover_rate) {
+                        operators_->crossover(a.data(), b.data(), length_, child.data(), cross_rng);
+                        parent_b = id_b;
+                    } else {
+                        child = a;
+                    }
+                    PhiloxStream mut_rng(seed, run, ticket, RandomOperator::Mutation);
+                    if (mut_rng.uniform() < params_.mutation_rate) {
+                        operators_->mutate(child.data(), length_, mut_rng);
+                    }
+
+                    const double f = evaluate(child.data());
+                    PhiloxStream replace_rng(seed, run, ticket, RandomOperator::Replacement);
+                    if (insert(child.data(), f, first_id + t, id_a, parent_b, view, replace_rng)) {
+                        accepted.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        executor.run(taskflow).wait();
+
+        last_run_seconds_ = std::chrono::duration<double>(clock::now() - start).count();
+        const std::int64_t n = std::max<std::int64_t>(num_evaluations, 0);
+        next_id_ += n;
+        evaluations_ += n;
+        accepted_ += accepted.load();
+        ++runs_;
+    }
+
+    // Accessors (not synchronised with a running engine)
+
+    int size() const { return size_; }
+    int genome_length() const { return length_; }
+    const std::vector<double>& genomes() const { return genomes_; }
+    double fitness(int i) const { return fitness_[i].load(std::memory_order_relaxed); }
+    IndividualId id(int i) const { return ids_[i]; }
+    const std::vector<IndividualId>& ids() const { return ids_; }
+    const std::vector<IndividualId>& parent_ids() const { return parents_; }
+
+    int best() const {
+        int best = 0;
+        for (int i = 1; i < size_; ++i) {
+            if (fitness(i) > fitness(best)) best = i;
+        }
+        return best;
+    }
+
+    std::uint64_t evaluations() const { return evaluations_; }
+    std::uint64_t accepted() const { return accepted_; }
+    std::uint64_t timed_out() const { return timed_out_.load(); }
+    std::uint64_t failed() const { return failed_.load(); }
+    double last_run_seconds() const { return last_run_seconds_; }
+
+private:
+    double* genome(int i) { return genomes_.data() + static_cast<std::size_t>(i) * length_; }
+
+    IndividualId copy_out(int i, double* out) {
+        std::lock_guard<std::mutex> lock(locks_[i]);
+        std::memcpy(out, genome(i), length_ * sizeof(double));
+        return ids_[i];
+    }
+
+    double evaluate(const double* g) {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = params_.timeout_seconds > 0.0
+            ? clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(params_.timeout_seconds))
+            : clock::time_point::max();
+        const EvaluationBudget budget{deadline};
+        try {
+            const double f = kernel_->evaluate(g, length_, budget);
+            if (budget.expired()) {
+                timed_out_.fetch_add(1, std::memory_order_relaxed);
+                return params_.penalty;
+            }
+            return f;
+        } catch (const std::exception&) {
+            failed_.fetch_add(1, std::memory_order_relaxed);
+            return params_.penalty;
+        }
+    }
+
+    // The victim is chosen from a lock-free scan and re-checked under its lock
+    bool insert(const double* child, double f, IndividualId id, IndividualId parent_a, IndividualId parent_b,
+                const FitnessView& view, PhiloxStream& rng) {
+        int victim = 0;
+        if (params_.policy == ReplacementPolicy::ReplaceWorst) {
+            for (int i = 1; i < size_; ++i) {
+                if (view[i] < view[victim]) victim = i;
+            }
+        } else {
+            victim = static_cast<int>(rng.below(size_));
+            for (int k = 1; k < params_.replace_tournament_size; ++k) {
+                const int i = static_cast<int>(rng.below(size_));
+                if (view[i] < view[victim]) victim = i;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(locks_[victim]);
+        if (!(f > fitness_[victim].load(std::memory_order_relaxed))) return false;
+        std::memcpy(genome(victim), child, length_ * sizeof(double));
+        ids_[victim] = id;
+        parents_[2 * victim] = parent_a;
+        parents_[2 * victim + 1] = parent_b;
+        fitness_[victim].store(f, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::shared_ptr<const FitnessKernel> kernel_;
+    std::shared_ptr<const SteadyStateOperators> operators_;
+    int length_;
+    SteadyStateParams params_;
+
+    int size_ = 0;
+    std::vector<double> genomes_;
+    std::unique_ptr<std::atomic<double>[]> fitness_;
+    std::unique_ptr<std::mutex[]> locks_;
+    std::vector<IndividualId> ids_;
+    std::vector<IndividualId> parents_;
+
+    IndividualId next_id_ = 0;
+    std::uint32_t runs_ = 0;
+    std::uint64_t evaluations_ = 0;
+    std::uint64_t accepted_ = 0;
+    std::atomic<std::uint64_t> timed_out_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    double last_run_seconds_ = 0.0;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,356 @@
+/**
+ * symplectic.hpp
+ *
+ * Structure-exploiting symplectic integrators for Hamiltonian flows on the
+ * J-surface,
+ *
+ *     ψ = (q, p),   ψ' = J ∇H(ψ),   J = [0 I; -I 0].
+ *
+ * The canonical J is never formed: applying it is the block swap
+ * (J g)_q = g_p, (J g)_p = -g_q. Splitting schemes (Störmer–Verlet and the
+ * Yoshida 4th/6th order compositions) need H separable, H = T(p) + V(q), and
+ * evaluate only the partial gradients ∂V/∂q and ∂T/∂p they use; the ∂V/∂q at
+ * the end of one substep is reused at the start of the next. Implicit
+ * midpoint handles general H with a fixed-point iteration on the full
+ * gradient; steps that hit the iteration cap keep the last iterate and are
+ * counted by unconverged_steps().
+ *
+ * Gradients are either supplied analytically or computed exactly with
+ * forward-mode dual numbers from generic energy functors.
+ */
+
+#pragma once
+
+#include "hyper_dual.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace taskflow_bridge {
+
+// Dual-number work space for gradients, owned by the caller
+using GradientScratch = std::vector<HyperDual<1>>;
+
+/**
+ * Hamiltonian
+ *
+ * H on a 2·dof-dimensional phase space ψ = (q, p). Implementations keep no
+ * mutable state: gradient work space is passed in, so one const Hamiltonian
+ * can be shared by integrators on different threads.
+ */
+class Hamiltonian {
+public:
+    explicit Hamiltonian(int dof) : dof_(dof) {}
+    virtual ~Hamiltonian() = default;
+
+    int dof() const { return dof_; }
+    int dim() const { return 2 * dof_; }
+
+    virtual double energy(const double* z) const = 0;
+
+    // Full gradient ∇H(z), length 2·dof
+    virtual void gradient(const double* z, double* grad, GradientScratch& scratch) const = 0;
+
+    // Separable H = T(p) + V(q) also provides the partial gradients
+    virtual bool separable() const { return false; }
+
+    virtual void grad_potential(const double* /*q*/, double* /*dV_dq*/, GradientScratch& /*scratch*/) const {
+        throw std::runtime_error("Hamiltonian is not separable");
+    }
+
+    virtual void grad_kinetic(const double* /*p*/, double* /*dT_dp*/, GradientScratch& /*scratch*/) const {
+        throw std::runtime_error("Hamiltonian is not separable");
+    }
+
+private:
+    int dof_;
+};
+
+namespace detail {
+
+// Exact gradient of a generic scalar functor g(x) by one dual sweep per
+// coordinate
+template <class F>
+void dual_gradient(const F& f, const double* x, double* grad, int n,
+                   GradientScratch& scratch) {
+    scratch.resize(n);
+    for (int i = 0; i < n; ++i) scratch[i] = HyperDual<1>(x[i]);
+    for (int i = 0; i < n; ++i) {
+        scratch[i].seed(0, 1.0);
+        grad[i] = f(scratch.data()).top();
+        scratch[i].seed(0, 0.0);
+    }
+}
+
+} // namespace detail
+
+/**
+ * SeparableHamiltonian
+ *
+ * T and V are generic functors `template <class S> S operator()(const S* x)`
+ * over dof coordinates. Analytic gradients may be given as
+ * `void(const double* x, double* grad)`; otherwise they are taken with duals.
+ */
+template <class TF, class VF>
+class SeparableHamiltonian final : public Hamiltonian {
+public:
+    using Gradient = std::function<void(const double*, double*)>;
+
+    SeparableHamiltonian(TF kinetic, VF potential, int dof,
+                         Gradient grad_kinetic = {}, Gradient grad_potential = {})
+        : Hamiltonian(dof), T_(std::move(kinetic)), V_(std::move(potential)),
+          dT_(std::move(grad_kinetic)), dV_(std::move(grad_potential)) {}
+
+    double energy(const double* z) const override {
+        return T_(z + dof()) + V_(z);
+    }
+
+    void gradient(const double* z, double* grad, GradientScratch& scratch) const override {
+        grad_potential(z, grad, scratch);
+        grad_kinetic(z + dof(), grad + dof(), scratch);
+    }
+
+    bool separable() const override { return true; }
+
+    void grad_potential(const double* q, double* dV_dq, GradientScratch& scratch) const override {
+        if (dV_) {
+            dV_(q, dV_dq);
+        } else {
+            detail::dual_gradient(V_, q, dV_dq, dof(), scratch);
+        }
+    }
+
+    void grad_kinetic(const double* p, double* dT_dp, GradientScratch& scratch) const override {
+        if (dT_) {
+            dT_(p, dT_dp);
+        } else {
+            detail::dual_gradient(T_, p, dT_dp, dof(), scratch);
+        }
+    }
+
+private:
+    TF T_;
+    VF V_;
+    Gradient dT_;
+    Gradient dV_;
+};
+
+/**
+ * GeneralHamiltonian
+ *
+ * Non-separable H(z) from a generic functor over all 2·dof coordinates.
+ */
+template <class HF>
+class GeneralHamiltonian final : public Hamiltonian {
+public:
+    GeneralHamiltonian(HF h, int dof) : Hamiltonian(dof), H_(std::move(h)) {}
+
+    double energy(const double* z) const override { return H_(z); }
+
+    void gradient(const double* z, double* grad, GradientScratch& scratch) const override {
+        detail::dual_gradient(H_, z, grad, dim(), scratch);
+    }
+
+private:
+    HF H_;
+};
+
+template <class TF, class VF>
+std::shared_ptr<Hamiltonian> make_separable_hamiltonian(
+        TF kinetic, VF potential, int dof,
+        std::function<void(const double*, double*)> grad_kinetic = {},
+        std::function<void(const double*, double*)> grad_potential = {}) {
+    return std::make_shared<SeparableHamiltonian<TF, VF>>(
+        std::move(kinetic), std::move(potential), dof,
+        std::move(grad_kinetic), std::move(grad_potential));
+}
+
+template <class HF>
+std::shared_ptr<Hamiltonian> make_hamiltonian(HF h, int dof) {
+    return std::make_shared<GeneralHamiltonian<HF>>(std::move(h), dof);
+}
+
+enum class SymplecticScheme {
+    StormerVerlet,
+    Yoshida4,
+    Yoshida6,
+    ImplicitMidpoint
+};
+
+inline SymplecticScheme parse_symplectic_scheme(const std::string& name) {
+    if (name == "verlet" || name == "stormer_verlet") return SymplecticScheme::StormerVerlet;
+    if (name == "yoshida4") return SymplecticScheme::Yoshida4;
+    if (name == "yoshida6") return SymplecticScheme::Yoshida6;
+    if (name == "midpoint" || name == "implicit_midpoint") return SymplecticScheme::ImplicitMidpoint;
+    throw std::runtime_error("Unknown symplectic scheme: " + name);
+}
+
+/**
+ * SymplecticIntegrator
+ *
+ * Advances ψ = (q, p) in place. All work buffers are allocated once.
+ */
+class SymplecticIntegrator {
+public:
+    SymplecticIntegrator(std::shared_ptr<const Hamiltonian> hamiltonian, SymplecticScheme scheme)
+        : H_(std::move(hamiltonian)), scheme_(scheme) {
+        if (!H_) {
+            throw std::runtime_error("SymplecticIntegrator requires a Hamiltonian");
+        }
+        if (scheme != SymplecticScheme::ImplicitMidpoint && !H_->separable()) {
+            throw std::runtime_error("Splitting schemes require a separable Hamiltonian");
+        }
+
+        const int d = H_->dof();
+        dV_.assign(d, 0.0);
+        dT_.assign(d, 0.0);
+        q_cached_.assign(d, 0.0);
+        z_mid_.assign(2 * d, 0.0);
+        z_next_.assign(2 * d, 0.0);
+        grad_.assign(2 * d, 0.0);
+        scratch_.reserve(2 * d);
+
+        switch (scheme) {
+        case SymplecticScheme::StormerVerlet:
+            weights_ = {1.0};
+            break;
+        case SymplecticScheme::Yoshida4: {
+            const double w1 = 1.0 / (2.0 - std::cbrt(2.0));
+            const double w0 = -std::cbrt(2.0) * w1;
+            weights_ = {w1, w0, w1};
+            break;
+        }
+        case SymplecticScheme::Yoshida6: {
+            // Yoshida (1990), solution A
+            const double w1 = -1.17767998417887;
+            const double w2 = 0.235573213359357;
+            const double w3 = 0.784513610477560;
+            const double w0 = 1.0 - 2.0 * (w1 + w2 + w3);
+            weights_ = {w3, w2, w1, w0, w1, w2, w3};
+            break;
+        }
+        case SymplecticScheme::ImplicitMidpoint:
+            break;
+        }
+    }
+
+    void step(double* z, double h) {
+        if (scheme_ == SymplecticScheme::ImplicitMidpoint) {
+            implicit_midpoint(z, h);
+        } else {
+            for (double w : weights_) verlet(z, w * h);
+        }
+        ++steps_;
+    }
+
+    void integrate(double* z, double h, int num_steps) {
+        for (int k = 0; k < num_steps; ++k) step(z, h);
+    }
+
+    // Fixed-point controls for implicit midpoint
+    void set_midpoint_tolerance(double tol, int max_iterations) {
+        if (max_iterations < 1) {
+            throw std::runtime_error("Implicit midpoint needs at least one iteration");
+        }
+        midpoint_tol_ = tol;
+        midpoint_max_iterations_ = max_iterations;
+    }
+
+    double energy(const double* z) const { return H_->energy(z); }
+    int dim() const { return H_->dim(); }
+    std::uint64_t steps() const { return steps_; }
+    std::uint64_t gradient_evaluations() const { return gradient_evaluations_; }
+    // Implicit midpoint steps whose fixed-point iteration hit the cap
+    std::uint64_t unconverged_steps() const { return unconverged_steps_; }
+
+private:
+    // Kick-drift-kick; ∂V/∂q is reused while q is unchanged since the last kick
+    void verlet(double* z, double h) {
+        const int d = H_->dof();
+        double* q = z;
+        double* p = z + d;
+
+        if (!dV_valid_ || !std::equal(q, q + d, q_cached_.begin())) {
+            H_->grad_potential(q, dV_.data(), scratch_);
+            ++gradient_evaluations_;
+        }
+        for (int i = 0; i < d; ++i) p[i] -= 0.5 * h * dV_[i];
+
+        H_->grad_kinetic(p, dT_.data(), scratch_);
+        ++gradient_evaluations_;
+        for (int i = 0; i < d; ++i) q[i] += h * dT_[i];
+
+        H_->grad_potential(q, dV_.data(), scratch_);
+        ++gradient_evaluations_;
+        for (int i = 0; i < d; ++i) p[i] -= 0.5 * h * dV_[i];
+
+        std::copy(q, q + d, q_cached_.begin());
+        dV_valid_ = true;
+    }
+
+    // z₁ = z₀ + h J ∇H((z₀ + z₁)/2), solved by fixed-point iteration
+    void implicit_midpoint(double* z, double h) {
+        const int d = H_->dof();
+        const int n = 2 * d;
+        std::copy(z, z + n, z_next_.begin());
+
+        bool converged = false;
+        for (int it = 0; it < midpoint_max_iterations_ && !converged; ++it) {
+            for (int i = 0; i < n; ++i) z_mid_[i] = 0.5 * (z[i] + z_next_[i]);
+            H_->gradient(z_mid_.data(), grad_.data(), scratch_);
+            ++gradient_evaluations_;
+
+            double change = 0.0;
+            for (int i = 0; i < d; ++i) {
+                // J block swap: q' = ∂H/∂p, p' = -∂H/∂q
+                const double q_new = z[i] + h * grad_[d + i];
+                const double p_new = z[d + i] - h * grad_[i];
+                change = std::max(change, std::abs(q_new - z_next_[i]));
+                change = std::max(change, std::abs(p_new - z_next_[d + i]));
+                z_next_[i] = q_new;
+                z_next_[d + i] = p_new;
+            }
+            converged = change <= midpoint_tol_ * (1.0 + max_abs(z_next_));
+        }
+        if (!converged) ++unconverged_steps_;
+
+        std::copy(z_next_.begin(), z_next_.end(), z);
+        dV_valid_ = false;
+    }
+
+    static double max_abs(const std::vector<double>& v) {
+        double m = 0.0;
+        for (double x : v) m = std::max(m, std::abs(x));
+        return m;
+    }
+
+    std::shared_ptr<const Hamiltonian> H_;
+    SymplecticScheme scheme_;
+    std::vector<double> weights_;
+
+    std::vector<double> dV_;
+    std::vector<double> dT_;
+    std::vector<double> z_mid_;
+    std::vector<double> z_next_;
+    std::vector<double> grad_;
+    GradientScratch scratch_;
+
+    bool dV_valid_ = false;
+    std::vector<double> q_cached_;
+
+    double midpoint_tol_ = 1e-14;
+    int midpoint_max_iterations_ = 50;
+
+    std::uint64_t steps_ = 0;
+    std::uint64_t gradient_evaluations_ = 0;
+    std::uint64_t unconverged_steps_ = 0;
+};
+
+} // namespace taskflow_bridge
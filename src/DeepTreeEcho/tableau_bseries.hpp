@@ -0,0 +1,107 @@
+/**
+ * tableau_bseries.hpp
+ *
+ * Butcher tableau → B-series coefficients.
+ *
+ * An s-stage Runge–Kutta method (A, b) is the B-series with b(τ) = Φ(τ), its
+ * elementary weights, so the output plugs straight into BSeriesStepper and
+ * EnsembleIntegrator (exact flow: b(τ) = 1/γ(τ)). Φ is computed by dynamic
+ * programming over the interned subtrees of an ElementaryWeightForest, with
+ * inner loops running over the stages. Batches of tableaux, as produced by
+ * an evolutionary search, are converted in parallel with per-worker stage
+ * buffers.
+ */
+
+#pragma once
+
+#include "order_conditions.hpp"
+#include "tree_arena.hpp"
+
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace taskflow_bridge {
+
+/**
+ * TableauConverter
+ *
+ * Coefficients follow TreeArena::enumerate_up_to(max_order) (slot order).
+ */
+class TableauConverter {
+public:
+    TableauConverter(TreeArena& arena, int max_order, int stages, int num_workers)
+        : forest_(arena, max_order), stages_(stages) {
+        if (stages < 1) {
+            throw std::runtime_error("Tableau needs at least one stage");
+        }
+        const std::size_t stage_values = static_cast<std::size_t>(forest_.num_trees()) * stages;
+        buffers_.resize(std::max(num_workers, 1) + 1);
+        for (auto& buffer : buffers_) {
+            buffer.g.assign(stage_values, 0.0);
+            buffer.u.assign(stage_values, 0.0);
+        }
+    }
+
+    // A: s × s row-major, b: s; writes num_trees coefficients
+    void convert(const double* A, const double* b, double* coefficients) {
+        Buffers& buffer = buffers_[0];
+        forest_.elementary_weights(stages_, A, b, buffer.g.data(), buffer.u.data(), coefficients);
+        ++converted_;
+    }
+
+    /**
+     * Tableaux k = 0..num_tableaux-1 at As + k·s², bs + k·s; coefficients
+     * of tableau k at out + k·num_trees.
+     */
+    void convert_batch(tf::Executor& executor, const double* As, const double* bs,
+                       int num_tableaux, double* out) {
+        if (executor.num_workers() + 1 > buffers_.size()) {
+            throw std::runtime_error("TableauConverter was built for fewer workers than the executor has");
+        }
+        const std::size_t S = stages_;
+        const std::size_t T = num_trees();
+
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0, num_tableaux, 1, [&](int k) {
+            Buffers& buffer = buffers_[executor.this_worker_id() + 1];
+            forest_.elementary_weights(stages_, As + k * S * S, bs + k * S,
+                                       buffer.g.data(), buffer.u.data(), out + k * T);
+        });
+        executor.run(taskflow).wait();
+        converted_ += num_tableaux;
+    }
+
+    // Largest p ≤ max_order with |b(τ) - 1/γ(τ)| ≤ tol for every |τ| ≤ p
+    int order_of(const double* coefficients, double tol) const {
+        for (int p = 1; p <= forest_.max_order(); ++p) {
+            for (int s = forest_.order_begin(p - 1); s < forest_.order_begin(p); ++s) {
+                if (std::abs(coefficients[s] - forest_.inverse_density(s)) > tol) return p - 1;
+            }
+        }
+        return forest_.max_order();
+    }
+
+    const ElementaryWeightForest& forest() const { return forest_; }
+    int num_trees() const { return forest_.num_trees(); }
+    int stages() const { return stages_; }
+    int max_order() const { return forest_.max_order(); }
+    std::uint64_t converted() const { return converted_; }
+
+private:
+    struct Buffers {
+        std::vector<double> g;
+        std::vector<double> u;
+    };
+
+    ElementaryWeightForest forest_;
+    int stages_;
+    std::vector<Buffers> buffers_;
+    std::uint64_t converted_ = 0;
+};
+
+} // namespace taskflow_bridge
@@ -10,7 +10,7 @@
  *   g++ -std=c++17 -O3 -shared -fPIC taskflow_bridge.cpp \
  *       -I/path/to/taskflow/include \
  *       -I/path/to/CxxWrap/include \
- *       -o libtaskflow_bridge.so
+ *       -o libtaskflow_bridge.so -ldl -lrt
  * 
  * Usage from Julia:
  *   using CxxWrap
@@ -20,10 +20,44 @@
 
 #include <taskflow/taskflow.hpp>
 #include <taskflow/cognitive/cognitive.hpp>
+#include "tree_arena.hpp"
+#include "rhs_kernel.hpp"
+#include "elementary_differentials.hpp"
+#include "bseries_stepper.hpp"
+#include "ensemble_integrator.hpp"
+#include "dopri5.hpp"
+#include "output_sinks.hpp"
+#include "symplectic.hpp"
+#include "riemannian_surface.hpp"
+#include "gradient_service.hpp"
+#include "order_conditions.hpp"
+#include "tableau_bseries.hpp"
+#include "compiled_kernel.hpp"
+#include "membrane_network.hpp"
+#include "fitness_service.hpp"
+#include "population_store.hpp"
+#include "philox.hpp"
+#include "tree_operators.hpp"
+#include "fitness_cache.hpp"
+#include "steady_state.hpp"
+#include "island_model.hpp"
+#include "pareto_selection.hpp"
+#include "garden_table.hpp"
+#include "lineage_log.hpp"
+#include "checkpoint.hpp"
+#include "delta_checkpoint.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
 #include <vector>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 #include <iostream>
 
 // Uncomment when building with CxxWrap.jl
@@ -225,6 +259,1225 @@ public:
         return taskflow_id;
     }
     
+    // Rooted trees and elementary differentials
+    
+    int register_kernel(std::shared_ptr<RhsKernel> kernel) {
+        if (!kernel) {
+            throw std::runtime_error("Kernel is null");
+        }
+        int id = next_id_++;
+        kernels_[id] = std::move(kernel);
+        return id;
+    }
+    
+    int intern_tree(const std::vector<int>& level_sequence) {
+        return tree_arena_.intern_level_sequence(level_sequence);
+    }
+    
+    std::vector<int> enumerate_trees(int max_order) {
+        auto ids = tree_arena_.enumerate_up_to(max_order);
+        return std::vector<int>(ids.begin(), ids.end());
+    }
+    
+    std::vector<int> tree_level_sequence(int tree_id) {
+        if (tree_id < 0 || static_cast<size_t>(tree_id) >= tree_arena_.size()) {
+            throw std::runtime_error("Tree not found: " + std::to_string(tree_id));
+        }
+        return tree_arena_.level_sequence(tree_id);
+    }
+    
+    // Genetic operators on interned trees; nodes are preorder indices (root = 0)
+    
+    int replace_subtree(int tree_id, int node, int replacement_id) {
+        return tree_operators_.replace(tree_id, node, replacement_id);
+    }
+    
+    int prune_subtree(int tree_id, int node) {
+        return tree_operators_.prune(tree_id, node);
+    }
+    
+    int graft_subtree(int tree_id, int node, int subtree_id) {
+        return tree_operators_.graft(tree_id, node, subtree_id);
+    }
+    
+    // Offspring k from (parents_a[k], parents_b[k]); canonical tree ids
+    std::vector<int> breed_trees(const std::vector<int>& parents_a, const std::vector<int>& parents_b,
+                                 int max_order, double crossover_rate, double mutation_rate,
+                                 int64_t seed, int generation) {
+        if (parents_a.size() != parents_b.size()) {
+            throw std::runtime_error("Parent arrays differ in length");
+        }
+        BreedingParams params;
+        params.max_order = max_order;
+        params.crossover_rate = crossover_rate;
+        params.mutation_rate = mutation_rate;
+        params.seed = static_cast<uint64_t>(seed);
+        params.generation = static_cast<uint32_t>(generation);
+        
+        std::vector<int> offspring(parents_a.size());
+        tree_operators_.breed(parents_a.data(), parents_b.data(), static_cast<int>(offspring.size()),
+                              params, offspring.data());
+        return offspring;
+    }
+    
+    double tree_symmetry(int tree_id) {
+        if (tree_id < 0 || static_cast<size_t>(tree_id) >= tree_arena_.size()) {
+            throw std::runtime_error("Tree not found: " + std::to_string(tree_id));
+        }
+        return tree_arena_.symmetry(tree_id);
+    }
+    
+    double tree_density(int tree_id) {
+        if (tree_id < 0 || static_cast<size_t>(tree_id) >= tree_arena_.size()) {
+            throw std::runtime_error("Tree not found: " + std::to_string(tree_id));
+        }
+        return tree_arena_.density(tree_id);
+    }
+    
+    int create_differential_dag(int kernel_id, int max_order) {
+        if (kernels_.find(kernel_id) == kernels_.end()) {
+            throw std::runtime_error("Kernel not found: " + std::to_string(kernel_id));
+        }
+        
+        int id = next_id_++;
+        differential_dags_[id] = std::make_shared<ElementaryDifferentialDAG>(
+            kernels_[kernel_id], tree_arena_, max_order);
+        return id;
+    }
+    
+    // Returns F(τ)(y) for every tree of the DAG, node-major
+    std::vector<double> evaluate_elementary_differentials(int dag_id, const std::vector<double>& y) {
+        if (differential_dags_.find(dag_id) == differential_dags_.end()) {
+            throw std::runtime_error("Differential DAG not found");
+        }
+        
+        auto& dag = differential_dags_[dag_id];
+        if (static_cast<int>(y.size()) != dag->dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        
+        dag->evaluate(y.data());
+        return dag->values();
+    }
+    
+    // B-series stepping
+    
+    int create_bseries_stepper(int kernel_id, int max_order) {
+        if (kernels_.find(kernel_id) == kernels_.end()) {
+            throw std::runtime_error("Kernel not found: " + std::to_string(kernel_id));
+        }
+        
+        int id = next_id_++;
+        steppers_[id] = std::make_shared<BSeriesStepper>(kernels_[kernel_id], tree_arena_, max_order);
+        return id;
+    }
+    
+    // Coefficients b(τ) in the order of enumerate_trees(max_order)
+    void set_bseries_coefficients(int stepper_id, const std::vector<double>& coefficients) {
+        find_stepper(stepper_id).set_coefficients(coefficients);
+    }
+    
+    void bseries_step(int stepper_id, std::vector<double>& state, double h) {
+        auto& stepper = find_stepper(stepper_id);
+        if (static_cast<int>(state.size()) != stepper.dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        stepper.step(state.data(), h);
+    }
+    
+    void bseries_integrate(int stepper_id, std::vector<double>& state, double h, int num_steps) {
+        auto& stepper = find_stepper(stepper_id);
+        if (static_cast<int>(state.size()) != stepper.dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        stepper.integrate(state.data(), h, num_steps);
+    }
+    
+    // Ensemble integration
+    
+    int create_ensemble(int kernel_id, int max_order, int num_trajectories) {
+        if (kernels_.find(kernel_id) == kernels_.end()) {
+            throw std::runtime_error("Kernel not found: " + std::to_string(kernel_id));
+        }
+        
+        int id = next_id_++;
+        ensembles_[id] = std::make_shared<EnsembleIntegrator>(
+            kernels_[kernel_id], tree_arena_, max_order, num_trajectories, executor_.num_workers());
+        return id;
+    }
+    
+    void set_ensemble_coefficients(int ensemble_id, const std::vector<double>& coefficients) {
+        find_ensemble(ensemble_id).set_coefficients(coefficients);
+    }
+    
+    // Trajectory-major: states[j * dim + i]
+    void set_ensemble_states(int ensemble_id, const std::vector<double>& states) {
+        find_ensemble(ensemble_id).set_states(states);
+    }
+    
+    std::vector<double> get_ensemble_states(int ensemble_id) {
+        return find_ensemble(ensemble_id).get_states();
+    }
+    
+    void ensemble_integrate(int ensemble_id, double h, int num_steps) {
+        find_ensemble(ensemble_id).integrate(executor_, h, num_steps);
+    }
+    
+    // Adaptive Dormand–Prince integration
+    
+    int create_dopri5(int kernel_id, double rtol, double atol) {
+        if (kernels_.find(kernel_id) == kernels_.end()) {
+            throw std::runtime_error("Kernel not found: " + std::to_string(kernel_id));
+        }
+        
+        Dopri5Options options;
+        options.rtol = rtol;
+        options.atol = atol;
+        
+        int id = next_id_++;
+        dopri5_integrators_[id] = std::make_shared<Dopri5Integrator>(kernels_[kernel_id], options);
+        return id;
+    }
+    
+    // Integrates y in place; returns rows (t, y...) on the grid t0 + k·dense_dt
+    std::vector<double> dopri5_solve(int integrator_id, std::vector<double>& y,
+                                     double t0, double t1, double dense_dt) {
+        auto& integrator = find_dopri5(integrator_id, y.size());
+        if (dense_dt <= 0.0) {
+            integrator.options().dense_dt = 0.0;
+            integrator.integrate(y.data(), t0, t1, nullptr);
+            return {};
+        }
+        
+        const size_t rows = static_cast<size_t>(std::floor(std::abs(t1 - t0) / dense_dt + 1e-9)) + 1;
+        std::vector<double> output(rows * (y.size() + 1));
+        MatrixSink sink(output.data(), rows, static_cast<int>(y.size()));
+        integrator.options().dense_dt = dense_dt;
+        integrator.integrate(y.data(), t0, t1, &sink);
+        output.resize(sink.rows() * (y.size() + 1));
+        return output;
+    }
+    
+    // Streams rows to a memory-mapped file; returns the number of rows written
+    int dopri5_solve_to_file(int integrator_id, std::vector<double>& y, double t0, double t1,
+                             double dense_dt, const std::string& path) {
+        auto& integrator = find_dopri5(integrator_id, y.size());
+        MmapFileSink file(path, static_cast<int>(y.size()));
+        RingBufferSink ring(file, static_cast<int>(y.size()));
+        integrator.options().dense_dt = std::max(dense_dt, 0.0);
+        integrator.integrate(y.data(), t0, t1, &ring);
+        return static_cast<int>(file.rows());
+    }
+    
+    // Symplectic integration of Hamiltonian flows on the J-surface
+    
+    int register_hamiltonian(std::shared_ptr<Hamiltonian> hamiltonian) {
+        int id = next_id_++;
+        hamiltonians_[id] = std::move(hamiltonian);
+        return id;
+    }
+    
+    // Loads a shared library implementing DTE_EXPORT_COMPILED_(SEPARABLE_)HAMILTONIAN
+    int load_compiled_hamiltonian(const std::string& path, const std::vector<double>& params) {
+        return register_hamiltonian(CompiledHamiltonian::load(path, params));
+    }
+    
+    // scheme: "verlet", "yoshida4", "yoshida6" or "midpoint"
+    int create_symplectic_integrator(int hamiltonian_id, const std::string& scheme) {
+        auto it = hamiltonians_.find(hamiltonian_id);
+        if (it == hamiltonians_.end()) {
+            throw std::runtime_error("Hamiltonian not found: " + std::to_string(hamiltonian_id));
+        }
+        
+        int id = next_id_++;
+        symplectic_integrators_[id] = std::make_shared<SymplecticIntegrator>(
+            it->second, parse_symplectic_scheme(scheme));
+        return id;
+    }
+    
+    // Advances ψ = (q, p) in place
+    void symplectic_integrate(int integrator_id, std::vector<double>& z, double h, int num_steps) {
+        find_symplectic(integrator_id, z.size()).integrate(z.data(), h, num_steps);
+    }
+    
+    double symplectic_energy(int integrator_id, const std::vector<double>& z) {
+        return find_symplectic(integrator_id, z.size()).energy(z.data());
+    }
+    
+    // Implicit midpoint fixed-point tolerance (relative) and iteration cap
+    void set_symplectic_midpoint_tolerance(int integrator_id, double tol, int max_iterations) {
+        find_symplectic(integrator_id).set_midpoint_tolerance(tol, max_iterations);
+    }
+    
+    // [steps, gradient evaluations, unconverged implicit midpoint steps]
+    std::vector<double> get_symplectic_stats(int integrator_id) {
+        auto& integrator = find_symplectic(integrator_id);
+        return {static_cast<double>(integrator.steps()), static_cast<double>(integrator.gradient_evaluations()),
+                static_cast<double>(integrator.unconverged_steps())};
+    }
+    
+    // Riemannian gradient descent on the J-surface
+    
+    // Identity metric; history keeps the last history_capacity positions
+    int create_riemannian_surface(const std::vector<double>& coefficients, int history_capacity) {
+        int id = next_id_++;
+        surfaces_[id] = std::make_shared<RiemannianSurface>(coefficients, history_capacity);
+        return id;
+    }
+    
+    // Row-major n × n metric, factored once
+    void set_surface_metric(int surface_id, const std::vector<double>& metric) {
+        auto& surface = find_surface(surface_id);
+        if (metric.size() != static_cast<size_t>(surface.dim()) * surface.dim()) {
+            throw std::runtime_error("Metric size mismatch");
+        }
+        surface.set_metric(metric.data());
+    }
+    
+    // M ← M + Σ signs[r] v_r v_rᵀ, vectors row-major (k × n)
+    void update_surface_metric(int surface_id, const std::vector<double>& vectors,
+                               const std::vector<double>& signs) {
+        auto& surface = find_surface(surface_id);
+        if (vectors.size() != signs.size() * surface.dim()) {
+            throw std::runtime_error("Metric update size mismatch");
+        }
+        surface.update_metric(vectors.data(), signs.data(), static_cast<int>(signs.size()));
+    }
+    
+    void surface_gradient_step(int surface_id, const std::vector<double>& gradient, double step_size) {
+        auto& surface = find_surface(surface_id);
+        if (gradient.size() != static_cast<size_t>(surface.dim())) {
+            throw std::runtime_error("Gradient size mismatch");
+        }
+        surface.gradient_step(gradient.data(), step_size);
+    }
+    
+    std::vector<double> get_surface_coefficients(int surface_id) {
+        return find_surface(surface_id).coefficients();
+    }
+    
+    double surface_distance(int surface_id, const std::vector<double>& other) {
+        auto& surface = find_surface(surface_id);
+        if (other.size() != static_cast<size_t>(surface.dim())) {
+            throw std::runtime_error("Coefficient size mismatch");
+        }
+        return surface.distance_to(other.data());
+    }
+    
+    // k = 0 is the current position
+    std::vector<double> get_surface_history(int surface_id, int k) {
+        auto& surface = find_surface(surface_id);
+        const double* c = surface.history().at(k);
+        return std::vector<double>(c, c + surface.dim());
+    }
+    
+    // Loss gradients
+    
+    int register_loss(std::shared_ptr<LossKernel> loss) {
+        int id = next_id_++;
+        losses_[id] = std::move(loss);
+        return id;
+    }
+    
+    // Loads a shared library implementing DTE_EXPORT_COMPILED_LOSS; returns a loss id
+    int load_compiled_loss(const std::string& path, const std::vector<double>& params) {
+        return register_loss(CompiledLoss::load(path, params));
+    }
+    
+    int create_gradient_service(int loss_id) {
+        auto it = losses_.find(loss_id);
+        if (it == losses_.end()) {
+            throw std::runtime_error("Loss not found: " + std::to_string(loss_id));
+        }
+        
+        int id = next_id_++;
+        gradient_services_[id] = std::make_shared<GradientService>(
+            it->second, static_cast<int>(executor_.num_workers()));
+        return id;
+    }
+    
+    // method: "forward", "central" or "reverse"; step <= 0 picks a default
+    std::vector<double> compute_gradient(int service_id, const std::vector<double>& coefficients,
+                                         const std::string& method, double step) {
+        auto it = gradient_services_.find(service_id);
+        if (it == gradient_services_.end()) {
+            throw std::runtime_error("Gradient service not found: " + std::to_string(service_id));
+        }
+        if (static_cast<int>(coefficients.size()) != it->second->dim()) {
+            throw std::runtime_error("Coefficient size mismatch");
+        }
+        
+        std::vector<double> gradient(coefficients.size());
+        it->second->gradient(executor_, coefficients.data(), gradient.data(),
+                             parse_gradient_method(method), step);
+        return gradient;
+    }
+    
+    // Runge–Kutta order conditions
+    
+    int create_order_conditions(int max_order, int stages) {
+        int id = next_id_++;
+        order_conditions_[id] = std::make_shared<OrderConditionEngine>(
+            tree_arena_, max_order, stages, static_cast<int>(executor_.num_workers()));
+        return id;
+    }
+    
+    // Residuals Φ(τ) - 1/γ(τ) in the order of enumerate_trees(max_order)
+    std::vector<double> order_condition_residuals(int engine_id, const std::vector<double>& A,
+                                                  const std::vector<double>& b) {
+        auto& engine = find_order_conditions(engine_id, A, b);
+        engine.evaluate(executor_, A.data(), b.data());
+        return engine.residuals();
+    }
+    
+    // Row-major num_trees × (s + s²): columns b₁..b_s, then a_ij row-major
+    std::vector<double> order_condition_jacobian(int engine_id, const std::vector<double>& A,
+                                                 const std::vector<double>& b) {
+        auto& engine = find_order_conditions(engine_id, A, b);
+        engine.evaluate(executor_, A.data(), b.data());
+        std::vector<double> J(static_cast<size_t>(engine.num_trees()) * engine.num_parameters());
+        engine.jacobian(executor_, J.data());
+        return J;
+    }
+    
+    // Butcher tableau → B-series coefficients
+    
+    int create_tableau_converter(int max_order, int stages) {
+        int id = next_id_++;
+        tableau_converters_[id] = std::make_shared<TableauConverter>(
+            tree_arena_, max_order, stages, static_cast<int>(executor_.num_workers()));
+        return id;
+    }
+    
+    // Coefficients b(τ) = Φ(τ) in the order of enumerate_trees(max_order)
+    std::vector<double> convert_tableau(int converter_id, const std::vector<double>& A,
+                                        const std::vector<double>& b) {
+        auto& converter = find_converter(converter_id);
+        const size_t s = converter.stages();
+        if (A.size() != s * s || b.size() != s) {
+            throw std::runtime_error("Tableau size mismatch");
+        }
+        std::vector<double> coefficients(converter.num_trees());
+        converter.convert(A.data(), b.data(), coefficients.data());
+        return coefficients;
+    }
+    
+    // As: k × s², bs: k × s; returns k × num_trees
+    std::vector<double> convert_tableaux(int converter_id, const std::vector<double>& As,
+                                         const std::vector<double>& bs) {
+        auto& converter = find_converter(converter_id);
+        const size_t s = converter.stages();
+        const size_t k = bs.size() / s;
+        if (bs.size() != k * s || As.size() != k * s * s) {
+            throw std::runtime_error("Tableau batch size mismatch");
+        }
+        std::vector<double> coefficients(k * converter.num_trees());
+        converter.convert_batch(executor_, As.data(), bs.data(), static_cast<int>(k), coefficients.data());
+        return coefficients;
+    }
+    
+    int bseries_order(int converter_id, const std::vector<double>& coefficients, double tol) {
+        auto& converter = find_converter(converter_id);
+        if (static_cast<int>(coefficients.size()) != converter.num_trees()) {
+            throw std::runtime_error("Coefficient size mismatch");
+        }
+        return converter.order_of(coefficients.data(), tol);
+    }
+    
+    // Compiled ModelingToolkit kernels (NativeRHSExport.jl)
+    
+    // Loads a shared library implementing compiled_rhs_abi.hpp; returns a kernel id
+    int load_compiled_kernel(const std::string& path, const std::vector<double>& params) {
+        return register_kernel(CompiledKernel::load(path, params));
+    }
+    
+    void set_kernel_parameters(int kernel_id, const std::vector<double>& params) {
+        find_compiled_kernel(kernel_id).set_parameters(params);
+    }
+    
+    // Row-major dim × dim
+    std::vector<double> kernel_jacobian(int kernel_id, const std::vector<double>& y) {
+        auto& kernel = find_compiled_kernel(kernel_id);
+        if (static_cast<int>(y.size()) != kernel.dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        std::vector<double> J(y.size() * y.size());
+        kernel.jacobian(y.data(), J.data());
+        return J;
+    }
+    
+    // Membrane-reservoir networks (MembraneReservoirBridge.step!)
+    
+    // parents[k] = -1 for roots; leak_rate is the bridge's α
+    int create_membrane_network(const std::vector<int>& labels, const std::vector<int>& parents,
+                                const std::vector<int>& sizes, double leak_rate) {
+        int id = next_id_++;
+        membrane_networks_[id] = std::make_shared<MembraneNetwork>(
+            labels, parents, sizes, leak_rate, executor_.num_workers());
+        return id;
+    }
+    
+    // Triplets (i, j, w) in membrane index order (ascending label)
+    void set_membrane_communication(int network_id, const std::vector<int>& rows,
+                                    const std::vector<int>& cols, const std::vector<double>& weights) {
+        find_membrane_network(network_id).set_communication(rows, cols, weights);
+    }
+    
+    // Row-major n × n reservoir weights; zeros are not stored
+    void set_membrane_reservoir(int network_id, int label, const std::vector<double>& weights) {
+        auto& network = find_membrane_network(network_id);
+        const int m = network.index_of(label);
+        const size_t n = network.size(m);
+        if (weights.size() != n * n) {
+            throw std::runtime_error("Reservoir matrix does not match membrane " + std::to_string(label));
+        }
+        network.set_reservoir(m, CsrMatrix::from_dense(n, n, weights.data()));
+    }
+    
+    void set_membrane_state(int network_id, int label, const std::vector<double>& state) {
+        auto& network = find_membrane_network(network_id);
+        const int m = network.index_of(label);
+        if (static_cast<int>(state.size()) != network.size(m)) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        std::copy(state.begin(), state.end(), network.state(m));
+    }
+    
+    std::vector<double> get_membrane_state(int network_id, int label) {
+        auto& network = find_membrane_network(network_id);
+        const int m = network.index_of(label);
+        return std::vector<double>(network.state(m), network.state(m) + network.size(m));
+    }
+    
+    // inputs[m] drives membrane index m
+    void membrane_network_step(int network_id, const std::vector<double>& inputs) {
+        auto& network = find_membrane_network(network_id);
+        if (static_cast<int>(inputs.size()) != network.num_membranes()) {
+            throw std::runtime_error("Expected one input per membrane");
+        }
+        network.step(executor_, inputs.data());
+    }
+    
+    // Concatenated states in ascending label order
+    std::vector<double> get_membrane_global_state(int network_id) {
+        return find_membrane_network(network_id).global_state();
+    }
+    
+    // Zero-copy view of the global state (membrane_total_size doubles), valid while
+    // the network exists and updated in place by every step
+    const double* membrane_global_state_data(int network_id) {
+        return find_membrane_network(network_id).global_state().data();
+    }
+    
+    int membrane_total_size(int network_id) {
+        return find_membrane_network(network_id).total_size();
+    }
+    
+    /**
+     * inputs: num_steps × M step-major. history: caller-owned column-major
+     * matrix with leading dimension ld ≥ membrane_total_size and num_steps
+     * columns, or null to skip recording.
+     */
+    void membrane_network_run(int network_id, const std::vector<double>& inputs, int num_steps,
+                              double* history, int ld) {
+        auto& network = find_membrane_network(network_id);
+        if (num_steps < 0 || inputs.size() != static_cast<size_t>(num_steps) * network.num_membranes()) {
+            throw std::runtime_error("Expected one input per membrane and step");
+        }
+        network.run(executor_, inputs.data(), num_steps, history, ld);
+    }
+    
+    // Batched fitness evaluation
+    
+    int register_fitness(std::shared_ptr<FitnessKernel> fitness) {
+        int id = next_id_++;
+        fitness_kernels_[id] = std::move(fitness);
+        return id;
+    }
+    
+    // Loads a shared library implementing DTE_EXPORT_COMPILED_FITNESS; returns a fitness id
+    int load_compiled_fitness(const std::string& path, const std::vector<double>& params) {
+        return register_fitness(CompiledFitness::load(path, params));
+    }
+    
+    // Individuals that exceed timeout_seconds (<= 0: none) or throw score penalty
+    int create_evaluation_service(int fitness_id, double timeout_seconds, double penalty) {
+        auto it = fitness_kernels_.find(fitness_id);
+        if (it == fitness_kernels_.end()) {
+            throw std::runtime_error("Fitness kernel not found: " + std::to_string(fitness_id));
+        }
+        
+        int id = next_id_++;
+        evaluation_services_[id] = std::make_shared<EvaluationService>(it->second, timeout_seconds, penalty);
+        return id;
+    }
+    
+    // Individual i is genomes[offsets[i]] .. genomes[offsets[i+1]-1]
+    std::vector<double> evaluate_population(int service_id, const std::vector<double>& genomes,
+                                            const std::vector<int>& offsets) {
+        auto& service = find_evaluation_service(service_id);
+        if (offsets.empty() || offsets.front() != 0 || offsets.back() != static_cast<int>(genomes.size()) ||
+            !std::is_sorted(offsets.begin(), offsets.end())) {
+            throw std::runtime_error("Genome offsets must rise from 0 to the genome buffer length");
+        }
+        
+        std::vector<double> fitness(offsets.size() - 1);
+        service.evaluate(executor_, genomes.data(), offsets.data(), static_cast<int>(fitness.size()),
+                         fitness.data());
+        return fitness;
+    }
+    
+    // Last batch: 0 ok, 1 timed out, 2 failed, 3 served from cache
+    std::vector<int> get_evaluation_status(int service_id) {
+        std::vector<int> codes;
+        for (EvaluationStatus status : find_evaluation_service(service_id).status()) {
+            codes.push_back(static_cast<int>(status));
+        }
+        return codes;
+    }
+    
+    // [evaluated, timed out, failed, last batch seconds, slowest individual seconds, cached]
+    std::vector<double> get_evaluation_stats(int service_id) {
+        auto& service = find_evaluation_service(service_id);
+        return {static_cast<double>(service.evaluated()), static_cast<double>(service.timed_out()),
+                static_cast<double>(service.failed()), service.last_batch_seconds(),
+                service.last_slowest_seconds(), static_cast<double>(service.cached())};
+    }
+    
+    // Fitness cache
+    
+    // LRU over at most `capacity` genomes, split into num_shards locks
+    int create_fitness_cache(int capacity, int num_shards) {
+        if (capacity < 1) {
+            throw std::runtime_error("Fitness cache capacity must be positive");
+        }
+        int id = next_id_++;
+        fitness_caches_[id] = std::make_shared<FitnessCache>(static_cast<size_t>(capacity), num_shards);
+        return id;
+    }
+    
+    // cache_id < 0 detaches; several services may share one cache
+    void attach_fitness_cache(int service_id, int cache_id) {
+        auto& service = find_evaluation_service(service_id);
+        if (cache_id < 0) {
+            service.set_cache(nullptr);
+            return;
+        }
+        auto it = fitness_caches_.find(cache_id);
+        if (it == fitness_caches_.end()) {
+            throw std::runtime_error("Fitness cache not found: " + std::to_string(cache_id));
+        }
+        service.set_cache(it->second);
+    }
+    
+    // Bump whenever the evaluation data changes; older entries stop matching
+    void set_fitness_data_version(int cache_id, int64_t version) {
+        find_fitness_cache(cache_id).set_data_version(static_cast<uint64_t>(version));
+    }
+    
+    void clear_fitness_cache(int cache_id) {
+        find_fitness_cache(cache_id).clear();
+    }
+    
+    // [hits, misses, hit rate, entries, capacity, insertions, evictions]
+    std::vector<double> get_fitness_cache_stats(int cache_id) {
+        auto& cache = find_fitness_cache(cache_id);
+        return {static_cast<double>(cache.hits()), static_cast<double>(cache.misses()), cache.hit_rate(),
+                static_cast<double>(cache.size()), static_cast<double>(cache.capacity()),
+                static_cast<double>(cache.insertions()), static_cast<double>(cache.evictions())};
+    }
+    
+    // Structure-of-arrays B-series populations
+    
+    // Columns follow enumerate_trees(max_order)
+    int create_population(int max_order, int capacity) {
+        int id = next_id_++;
+        populations_[id] = std::make_shared<PopulationStore>(tree_arena_, max_order, capacity);
+        return id;
+    }
+    
+    // Appends k individuals (k × num_trees row-major); returns their ids
+    std::vector<int64_t> population_add(int population_id, const std::vector<double>& coefficients,
+                                        int generation) {
+        auto& population = find_population(population_id);
+        const size_t T = population.num_trees();
+        if (coefficients.size() % T != 0) {
+            throw std::runtime_error("Coefficient size mismatch");
+        }
+        std::vector<int64_t> ids;
+        for (size_t k = 0; k < coefficients.size() / T; ++k) {
+            ids.push_back(population.id(population.add(coefficients.data() + k * T, generation)));
+        }
+        return ids;
+    }
+    
+    // size × num_trees row-major
+    std::vector<double> get_population_coefficients(int population_id) {
+        return find_population(population_id).coefficients();
+    }
+    
+    std::vector<int64_t> get_population_ids(int population_id) {
+        return find_population(population_id).ids();
+    }
+    
+    // size × 2 row-major; -1 marks no parent
+    std::vector<int64_t> get_population_parents(int population_id) {
+        return find_population(population_id).parent_ids();
+    }
+    
+    void set_population_fitness(int population_id, const std::vector<double>& fitness) {
+        auto& population = find_population(population_id);
+        if (static_cast<int>(fitness.size()) != population.size()) {
+            throw std::runtime_error("Expected one fitness per individual");
+        }
+        population.fitness() = fitness;
+    }
+    
+    std::vector<double> get_population_fitness(int population_id) {
+        return find_population(population_id).fitness();
+    }
+    
+    /**
+     * Rows refer to the current population. Offspring k crosses parent_a[k]
+     * with parent_b[k] at points[k] (<= 0: clone parent_a[k]), then mutates.
+     */
+    void population_next_generation(int population_id, const std::vector<int>& elites,
+                                    const std::vector<int>& parent_a, const std::vector<int>& parent_b,
+                                    const std::vector<int>& points, double mutation_rate, int64_t seed) {
+        if (parent_b.size() != parent_a.size() || points.size() != parent_a.size()) {
+            throw std::runtime_error("Parent and crossover point arrays differ in length");
+        }
+        find_population(population_id).next_generation(
+            executor_, elites.data(), static_cast<int>(elites.size()), parent_a.data(), parent_b.data(),
+            points.data(), static_cast<int>(parent_a.size()), mutation_rate, static_cast<uint64_t>(seed));
+    }
+    
+    // Row-major size × size
+    std::vector<double> population_distances(int population_id) {
+        auto& population = find_population(population_id);
+        std::vector<double> D(static_cast<size_t>(population.size()) * population.size());
+        population.distance_matrix(executor_, D.data());
+        return D;
+    }
+    
+    double population_diversity(int population_id) {
+        return find_population(population_id).diversity(executor_);
+    }
+    
+    // [means..., variances...] per tree column
+    std::vector<double> population_column_moments(int population_id) {
+        auto& population = find_population(population_id);
+        std::vector<double> moments(2 * population.num_trees());
+        population.column_moments(moments.data(), moments.data() + population.num_trees());
+        return moments;
+    }
+    
+    // Counter-based random streams keyed by (seed, generation, individual, operator)
+    
+    // op: RandomOperator tag (0 generic, 1 mutation, 2 crossover, 3 selection, 4 hybrid, 5 sampling)
+    std::vector<double> random_uniform(int64_t seed, int generation, int individual, int op, int n) {
+        std::vector<double> out(std::max(n, 0));
+        philox_uniform(random_key(seed, generation, individual, op), out.size(), out.data());
+        return out;
+    }
+    
+    std::vector<double> random_normal(int64_t seed, int generation, int individual, int op, int n) {
+        std::vector<double> out(std::max(n, 0));
+        philox_normal(random_key(seed, generation, individual, op), out.size(), out.data());
+        return out;
+    }
+    
+    // n integers in [0, bound)
+    std::vector<int> random_integers(int64_t seed, int generation, int individual, int op, int n, int bound) {
+        if (bound < 1) {
+            throw std::runtime_error("Random integer bound must be positive");
+        }
+        PhiloxStream stream(random_key(seed, generation, individual, op));
+        std::vector<int> out(std::max(n, 0));
+        for (int& x : out) x = static_cast<int>(stream.below(static_cast<uint32_t>(bound)));
+        return out;
+    }
+    
+    // Asynchronous steady-state evolution
+    
+    // policy: 0 replace worst, 1 tournament replace (of replace_tournament_size)
+    int create_steady_state(int fitness_id, int genome_length, int tournament_size, double crossover_rate,
+                            double mutation_rate, int policy, int replace_tournament_size,
+                            double timeout_seconds, double penalty) {
+        return make_steady_state(fitness_id, genome_length, std::make_shared<SteadyStateOperators>(tournament_size),
+                                 crossover_rate, mutation_rate, policy, replace_tournament_size, timeout_seconds,
+                                 penalty);
+    }
+    
+    // Loads a shared library implementing DTE_EXPORT_COMPILED_OPERATORS; returns an operators id
+    int load_compiled_operators(const std::string& path, const std::vector<double>& params, int tournament_size) {
+        int id = next_id_++;
+        steady_state_operators_[id] = CompiledOperators::load(path, params, tournament_size);
+        return id;
+    }
+    
+    // As create_steady_state, with crossover and mutation from load_compiled_operators
+    int create_steady_state_with_operators(int fitness_id, int operators_id, int genome_length,
+                                           double crossover_rate, double mutation_rate, int policy,
+                                           int replace_tournament_size, double timeout_seconds, double penalty) {
+        auto it = steady_state_operators_.find(operators_id);
+        if (it == steady_state_operators_.end()) {
+            throw std::runtime_error("Steady-state operators not found: " + std::to_string(operators_id));
+        }
+        return make_steady_state(fitness_id, genome_length, it->second, crossover_rate, mutation_rate, policy,
+                                 replace_tournament_size, timeout_seconds, penalty);
+    }
+    
+    // Custom select / crossover / mutate operators written in C++
+    int register_steady_state(std::shared_ptr<SteadyStateEngine> engine) {
+        int id = next_id_++;
+        steady_states_[id] = std::move(engine);
+        return id;
+    }
+    
+    // k × genome_length row-major; returns the initial fitness
+    std::vector<double> steady_state_initialize(int engine_id, const std::vector<double>& genomes) {
+        auto& engine = find_steady_state(engine_id);
+        if (genomes.size() % engine.genome_length() != 0) {
+            throw std::runtime_error("Genome buffer is not a whole number of genomes");
+        }
+        engine.initialize(executor_, genomes.data(), static_cast<int>(genomes.size() / engine.genome_length()));
+        return get_steady_state_fitness(engine_id);
+    }
+    
+    void steady_state_run(int engine_id, int64_t num_evaluations, int64_t seed) {
+        find_steady_state(engine_id).run(executor_, num_evaluations, static_cast<uint64_t>(seed));
+    }
+    
+    std::vector<double> get_steady_state_genomes(int engine_id) {
+        return find_steady_state(engine_id).genomes();
+    }
+    
+    std::vector<double> get_steady_state_fitness(int engine_id) {
+        auto& engine = find_steady_state(engine_id);
+        std::vector<double> fitness(engine.size());
+        for (int i = 0; i < engine.size(); ++i) fitness[i] = engine.fitness(i);
+        return fitness;
+    }
+    
+    std::vector<int64_t> get_steady_state_ids(int engine_id) {
+        return find_steady_state(engine_id).ids();
+    }
+    
+    // Two parent ids per slot (-1 = none)
+    std::vector<int64_t> get_steady_state_parents(int engine_id) {
+        return find_steady_state(engine_id).parent_ids();
+    }
+    
+    // [evaluations, accepted, timed out, failed, last run seconds, best fitness]
+    std::vector<double> get_steady_state_stats(int engine_id) {
+        auto& engine = find_steady_state(engine_id);
+        return {static_cast<double>(engine.evaluations()), static_cast<double>(engine.accepted()),
+                static_cast<double>(engine.timed_out()), static_cast<double>(engine.failed()),
+                engine.last_run_seconds(), engine.size() > 0 ? engine.fitness(engine.best()) : 0.0};
+    }
+    
+    // Island model over local processes
+    
+    // topology: 0 ring, 1 bidirectional ring, 2 fully connected; name is a POSIX shm name ("/dte-islands")
+    int create_island_model(const std::string& name, int num_islands, int genome_length, int ring_capacity,
+                            int topology, int interval) {
+        int id = next_id_++;
+        island_coordinators_[id] = std::make_shared<IslandCoordinator>(
+            name, num_islands, genome_length, ring_capacity, static_cast<IslandTopology>(topology), interval);
+        return id;
+    }
+    
+    // Each worker sees DTE_ISLAND_SEGMENT and DTE_ISLAND_INDEX
+    void launch_islands(int model_id, const std::vector<std::string>& argv) {
+        find_island_coordinator(model_id).launch(argv);
+    }
+    
+    std::vector<int> wait_islands(int model_id) {
+        return find_island_coordinator(model_id).wait();
+    }
+    
+    // Per island: [generation, best fitness, sent, received, dropped]
+    std::vector<double> get_island_status(int model_id) {
+        auto& segment = *find_island_coordinator(model_id).segment();
+        std::vector<double> status;
+        for (int i = 0; i < segment.num_islands(); ++i) {
+            auto& s = segment.status(i);
+            status.insert(status.end(), {static_cast<double>(s.generation.load()), s.best_fitness.load(),
+                                         static_cast<double>(s.sent.load()), static_cast<double>(s.received.load()),
+                                         static_cast<double>(s.dropped.load())});
+        }
+        return status;
+    }
+    
+    // Worker side: attach to a segment created by another process (or this one)
+    int attach_island(const std::string& name, int island) {
+        int id = next_id_++;
+        island_endpoints_[id] = std::make_shared<IslandEndpoint>(IslandSegment::attach(name), island);
+        return id;
+    }
+    
+    bool island_should_migrate(int endpoint_id, int64_t generation) {
+        return find_island_endpoint(endpoint_id).should_migrate(generation);
+    }
+    
+    // k × genome_length rows with their fitness and ids; returns ring pushes made
+    int island_emigrate(int endpoint_id, const std::vector<double>& genomes, const std::vector<double>& fitness,
+                        const std::vector<int64_t>& ids, int generation) {
+        auto& endpoint = find_island_endpoint(endpoint_id);
+        const size_t length = endpoint.segment().genome_length();
+        if (genomes.size() != fitness.size() * length || ids.size() != fitness.size()) {
+            throw std::runtime_error("Expected one genome row, fitness and id per migrant");
+        }
+        int sent = 0;
+        for (size_t k = 0; k < fitness.size(); ++k) {
+            sent += endpoint.emigrate(genomes.data() + k * length, fitness[k], ids[k], generation);
+        }
+        return sent;
+    }
+    
+    // Rows of [source island, id, generation, fitness, genome...]
+    std::vector<double> island_immigrate(int endpoint_id) {
+        auto& endpoint = find_island_endpoint(endpoint_id);
+        std::vector<Migrant> migrants;
+        std::vector<double> genomes;
+        endpoint.immigrate(migrants, genomes);
+        const size_t length = endpoint.segment().genome_length();
+        std::vector<double> rows;
+        rows.reserve(migrants.size() * (length + 4));
+        for (size_t k = 0; k < migrants.size(); ++k) {
+            rows.insert(rows.end(), {static_cast<double>(migrants[k].source), static_cast<double>(migrants[k].id),
+                                     static_cast<double>(migrants[k].generation), migrants[k].fitness});
+            rows.insert(rows.end(), genomes.begin() + k * length, genomes.begin() + (k + 1) * length);
+        }
+        return rows;
+    }
+    
+    void island_report(int endpoint_id, int64_t generation, double best_fitness) {
+        find_island_endpoint(endpoint_id).report(generation, best_fitness);
+    }
+    
+    // Multi-objective selection (objectives maximized, objective-major: F[m * n + i])
+    
+    // Front index per individual (0 = non-dominated)
+    std::vector<int> pareto_ranks(const std::vector<double>& objectives, int num_objectives) {
+        const int n = objective_count(objectives, num_objectives);
+        pareto_selector_.sort(executor_, objectives.data(), num_objectives, n);
+        return pareto_selector_.rank();
+    }
+    
+    // Crowding distance within each front (+inf at front boundaries)
+    std::vector<double> crowding_distance(const std::vector<double>& objectives, int num_objectives) {
+        const int n = objective_count(objectives, num_objectives);
+        pareto_selector_.sort(executor_, objectives.data(), num_objectives, n);
+        pareto_selector_.crowding(executor_, objectives.data());
+        return pareto_selector_.crowding();
+    }
+    
+    std::vector<int> nsga2_select(const std::vector<double>& objectives, int num_objectives, int mu) {
+        const int n = objective_count(objectives, num_objectives);
+        std::vector<int> selected(std::max(mu, 0));
+        pareto_selector_.select_nsga2(executor_, objectives.data(), num_objectives, n, mu, selected.data());
+        return selected;
+    }
+    
+    // Row-major Das–Dennis simplex lattice
+    std::vector<double> reference_points(int num_objectives, int divisions) {
+        return das_dennis_points(num_objectives, divisions);
+    }
+    
+    std::vector<int> nsga3_select(const std::vector<double>& objectives, int num_objectives, int mu, int divisions,
+                                  int64_t seed, int generation) {
+        const int n = objective_count(objectives, num_objectives);
+        const std::vector<double> refs = das_dennis_points(num_objectives, divisions);
+        std::vector<int> selected(std::max(mu, 0));
+        pareto_selector_.select_nsga3(executor_, objectives.data(), num_objectives, n, mu, refs.data(),
+                                      static_cast<int>(refs.size()) / num_objectives, static_cast<uint64_t>(seed),
+                                      static_cast<uint32_t>(generation), selected.data());
+        return selected;
+    }
+    
+    // Membrane garden table
+    
+    int create_garden_table() {
+        int id = next_id_++;
+        gardens_[id] = std::make_shared<GardenTable>(tree_arena_);
+        return id;
+    }
+    
+    // Tree ids (from intern_tree) with their membranes; returns the new rows
+    std::vector<int> garden_plant(int garden_id, const std::vector<int>& trees, const std::vector<int>& membranes) {
+        auto& garden = find_garden(garden_id);
+        if (trees.size() != membranes.size()) {
+            throw std::runtime_error("Expected one membrane per tree");
+        }
+        std::vector<int> rows;
+        for (size_t k = 0; k < trees.size(); ++k) rows.push_back(garden.plant(trees[k], membranes[k]));
+        return rows;
+    }
+    
+    // feedback = [reservoir activity, reservoir stability, energy, gradient norm]; returns trees planted
+    int garden_grow(int garden_id, int num_generations, double mutation_rate, double crossover_rate,
+                    double selection_pressure, int max_order, const std::vector<double>& feedback, int64_t seed) {
+        auto& garden = find_garden(garden_id);
+        const GardenGrowth growth = garden_growth(mutation_rate, crossover_rate, selection_pressure, max_order, feedback);
+        int planted = 0;
+        for (int g = 0; g < num_generations; ++g) {
+            planted += garden.grow(executor_, growth, static_cast<uint64_t>(seed));
+        }
+        return planted;
+    }
+    
+    // As garden_grow, but each membrane selects and breeds on its own, one task per membrane
+    int garden_grow_membranes(int garden_id, int num_generations, double mutation_rate, double crossover_rate,
+                              double selection_pressure, int max_order, const std::vector<double>& feedback,
+                              int64_t seed) {
+        auto& garden = find_garden(garden_id);
+        const GardenGrowth growth = garden_growth(mutation_rate, crossover_rate, selection_pressure, max_order, feedback);
+        int planted = 0;
+        for (int g = 0; g < num_generations; ++g) {
+            planted += garden.grow_membranes(executor_, growth, static_cast<uint64_t>(seed));
+        }
+        return planted;
+    }
+    
+    // Flat [m1, m2, m1, m2, ...] pairs, or empty for a ring over all membranes; returns hybrids planted
+    int garden_exchange(int garden_id, const std::vector<int>& membrane_pairs, int crosses, int max_order,
+                        int64_t seed) {
+        auto& garden = find_garden(garden_id);
+        if (membrane_pairs.size() % 2 != 0) {
+            throw std::runtime_error("Membrane pairs must have even length");
+        }
+        std::vector<std::pair<int, int>> pairs;
+        for (size_t k = 0; k < membrane_pairs.size(); k += 2) {
+            pairs.emplace_back(membrane_pairs[k], membrane_pairs[k + 1]);
+        }
+        if (pairs.empty()) pairs = garden.ring_pairs();
+        return garden.exchange(pairs, crosses, max_order, static_cast<uint64_t>(seed));
+    }
+    
+    int garden_prune(int garden_id, double threshold) {
+        return find_garden(garden_id).prune(threshold);
+    }
+    
+    double garden_quantile(int garden_id, double q) {
+        return find_garden(garden_id).quantile(q);
+    }
+    
+    std::vector<int> get_garden_trees(int garden_id) {
+        return find_garden(garden_id).trees();
+    }
+    
+    std::vector<int> get_garden_membranes(int garden_id) {
+        return find_garden(garden_id).membranes();
+    }
+    
+    std::vector<double> get_garden_fitness(int garden_id) {
+        return find_garden(garden_id).fitness();
+    }
+    
+    std::vector<int> get_garden_membrane_rows(int garden_id, int membrane) {
+        return find_garden(garden_id).membrane_rows(membrane);
+    }
+    
+    // [trees, generation, mean fitness, membranes]
+    std::vector<double> get_garden_stats(int garden_id) {
+        auto& garden = find_garden(garden_id);
+        return {static_cast<double>(garden.size()), static_cast<double>(garden.generation()), garden.mean_fitness(),
+                static_cast<double>(garden.membrane_index().size())};
+    }
+    
+    // Lineage log
+    
+    int create_lineage_log() {
+        int id = next_id_++;
+        lineage_logs_[id] = std::make_shared<LineageLog>();
+        return id;
+    }
+    
+    // op: 0 seed, 1 mutation, 2 crossover, 3 hybrid, 4 migration; -1 parents mark none
+    int lineage_record(int log_id, const std::vector<int64_t>& children, const std::vector<int64_t>& parent_a,
+                       const std::vector<int64_t>& parent_b, int op, int generation) {
+        auto& log = find_lineage_log(log_id);
+        if (parent_a.size() != children.size() || parent_b.size() != children.size()) {
+            throw std::runtime_error("Expected two parents per child");
+        }
+        if (op < 0 || op > static_cast<int>(LineageOperator::Migration)) {
+            throw std::runtime_error("Unknown lineage operator: " + std::to_string(op));
+        }
+        for (size_t k = 0; k < children.size(); ++k) {
+            log.record(children[k], parent_a[k], parent_b[k], static_cast<LineageOperator>(op), generation);
+        }
+        return static_cast<int>(children.size());
+    }
+    
+    // Records every individual not yet in the log; returns how many were new
+    int lineage_record_population(int log_id, int population_id) {
+        auto& log = find_lineage_log(log_id);
+        auto& population = find_population(population_id);
+        int added = 0;
+        for (int r = 0; r < population.size(); ++r) {
+            if (log.contains(population.id(r))) continue;
+            const IndividualId* parents = population.parents(r);
+            const LineageOperator op = parents[1] != kNoParent ? LineageOperator::Crossover
+                                     : parents[0] != kNoParent ? LineageOperator::Mutation
+                                                               : LineageOperator::Seed;
+            log.record(population.id(r), parents[0], parents[1], op, population.generation(r));
+            ++added;
+        }
+        return added;
+    }
+    
+    std::vector<int64_t> lineage_ancestors(int log_id, int64_t id, int max_depth) {
+        return find_lineage_log(log_id).ancestors(id, max_depth);
+    }
+    
+    std::vector<int64_t> lineage_descendants(int log_id, int64_t id, int max_depth) {
+        return find_lineage_log(log_id).descendants(id, max_depth);
+    }
+    
+    // Keeps the living, the last keep_generations generations and their ancestors; returns entries removed
+    int lineage_prune(int log_id, const std::vector<int64_t>& living, int keep_generations) {
+        return find_lineage_log(log_id).prune(living.data(), static_cast<int>(living.size()), keep_generations);
+    }
+    
+    // [entries, latest generation, recorded, pruned]
+    std::vector<double> get_lineage_stats(int log_id) {
+        auto& log = find_lineage_log(log_id);
+        return {static_cast<double>(log.size()), static_cast<double>(log.latest_generation()),
+                static_cast<double>(log.recorded()), static_cast<double>(log.pruned())};
+    }
+    
+    // Checkpoints
+    
+    /**
+     * Writes the tree arena and every population, garden, lineage log,
+     * membrane network and Riemannian surface, keyed by id. Kernels,
+     * services and running engines are not saved. Returns the file size.
+     */
+    int64_t save_checkpoint(const std::string& path) {
+        CheckpointWriter writer;
+        collect_checkpoint(writer);
+        return static_cast<int64_t>(writer.write(executor_, path));
+    }
+    
+    /**
+     * Restores a checkpoint under its saved ids, replacing live objects with
+     * the same ids. A base written by a checkpoint chain is replayed with its
+     * deltas. The live tree arena must be a prefix of the saved one (a fresh
+     * bridge always is). With verify, every checksum is checked first.
+     * Nothing is replaced unless all objects restore. Returns the number of
+     * objects restored.
+     */
+    int load_checkpoint(const std::string& path, bool verify) {
+        const std::unique_ptr<CheckpointReader> replayed = DeltaCheckpointer::replay(executor_, path, verify);
+        const CheckpointReader& reader = *replayed;
+        tree_arena_.restore(reader, "arena.");
+        const auto objects = reader.column<int64_t>("bridge.objects");
+        if (objects.size % 2 != 0) {
+            throw std::runtime_error("Corrupt checkpoint object table");
+        }
+        std::vector<std::function<void()>> commit;
+        for (size_t k = 0; k < objects.size; k += 2) {
+            const auto kind = static_cast<CheckpointObject>(objects[k]);
+            const int id = static_cast<int>(objects[k + 1]);
+            const std::string prefix = checkpoint_prefix(kind, id);
+            switch (kind) {
+                case CheckpointObject::Population: {
+                    const int max_order = static_cast<int>(reader.column<int64_t>(prefix + "meta", 3)[0]);
+                    auto population = std::make_shared<PopulationStore>(tree_arena_, max_order);
+                    population->restore(reader, prefix);
+                    commit.push_back([this, id, population] { populations_[id] = population; });
+                    break;
+                }
+                case CheckpointObject::Garden: {
+                    auto garden = std::make_shared<GardenTable>(tree_arena_);
+                    garden->restore(reader, prefix);
+                    commit.push_back([this, id, garden] { gardens_[id] = garden; });
+                    break;
+                }
+                case CheckpointObject::LineageLog: {
+                    auto log = std::make_shared<LineageLog>();
+                    log->restore(reader, prefix);
+                    commit.push_back([this, id, log] { lineage_logs_[id] = log; });
+                    break;
+                }
+                case CheckpointObject::MembraneNetwork: {
+                    const auto labels = reader.column<int>(prefix + "labels").to_vector();
+                    const auto offsets = reader.column<int>(prefix + "offsets", labels.size() + 1);
+                    std::vector<int> sizes(labels.size());
+                    for (size_t m = 0; m < labels.size(); ++m) sizes[m] = offsets[m + 1] - offsets[m];
+                    auto network = std::make_shared<MembraneNetwork>(
+                        labels, std::vector<int>(labels.size(), -1), sizes,
+                        reader.column<double>(prefix + "leak_rate", 1)[0], executor_.num_workers());
+                    network->restore(reader, prefix);
+                    commit.push_back([this, id, network] { membrane_networks_[id] = network; });
+                    break;
+                }
+                case CheckpointObject::Surface: {
+                    const int capacity = static_cast<int>(reader.column<int64_t>(prefix + "history.ring", 3)[0]);
+                    auto surface = std::make_shared<RiemannianSurface>(
+                        reader.column<double>(prefix + "coefficients").to_vector(), capacity);
+                    surface->restore(reader, prefix);
+                    commit.push_back([this, id, surface] { surfaces_[id] = surface; });
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Unknown checkpoint object kind: " + std::to_string(objects[k]));
+            }
+        }
+        for (auto& apply : commit) apply();
+        next_id_ = std::max<int>(next_id_, static_cast<int>(reader.column<int64_t>("bridge.meta", 1)[0]));
+        return static_cast<int>(commit.size());
+    }
+    
+    // [version, sections, bytes, objects]
+    std::vector<double> get_checkpoint_info(const std::string& path) {
+        CheckpointReader reader(path);
+        return {static_cast<double>(reader.version()), static_cast<double>(reader.sections().size()),
+                static_cast<double>(reader.bytes()),
+                static_cast<double>(reader.column<int64_t>("bridge.objects").size / 2)};
+    }
+    
+    // Checkpoint chains: a base, then deltas of the blocks that changed
+    
+    // block_bytes: delta granularity; max_deltas > 0 compacts in the background after that many
+    int create_checkpoint_chain(const std::string& path, int64_t block_bytes, int max_deltas) {
+        int id = next_id_++;
+        checkpoint_chains_[id] = std::make_shared<DeltaCheckpointer>(path, static_cast<size_t>(block_bytes), max_deltas);
+        return id;
+    }
+    
+    // Full snapshot; starts a new chain. Returns bytes written
+    int64_t checkpoint_chain_base(int chain_id) {
+        auto& chain = find_checkpoint_chain(chain_id);
+        CheckpointWriter writer;
+        collect_checkpoint(writer);
+        return static_cast<int64_t>(chain.write_base(executor_, writer));
+    }
+    
+    // Only the blocks changed since the previous checkpoint; returns bytes written
+    int64_t checkpoint_chain_delta(int chain_id) {
+        auto& chain = find_checkpoint_chain(chain_id);
+        CheckpointWriter writer;
+        collect_checkpoint(writer);
+        return static_cast<int64_t>(chain.write_delta(executor_, writer));
+    }
+    
+    void compact_checkpoint_chain(int chain_id, bool wait) {
+        auto& chain = find_checkpoint_chain(chain_id);
+        chain.compact_async();
+        if (wait) chain.wait();
+    }
+    
+    // [bases, deltas, delta bytes, dirty blocks in the last delta, compactions, sequence]
+    std::vector<double> get_checkpoint_chain_stats(int chain_id) {
+        auto& chain = find_checkpoint_chain(chain_id);
+        return {static_cast<double>(chain.bases()), static_cast<double>(chain.deltas()),
+                static_cast<double>(chain.delta_bytes()), static_cast<double>(chain.last_dirty_blocks()),
+                static_cast<double>(chain.compactions()), static_cast<double>(chain.sequence())};
+    }
+    
     // Statistics
     
     int num_taskflows() const {
@@ -240,6 +1493,260 @@ public:
     }
 
 private:
+    BSeriesStepper& find_stepper(int stepper_id) {
+        auto it = steppers_.find(stepper_id);
+        if (it == steppers_.end()) {
+            throw std::runtime_error("B-series stepper not found: " + std::to_string(stepper_id));
+        }
+        return *it->second;
+    }
+    
+    EnsembleIntegrator& find_ensemble(int ensemble_id) {
+        auto it = ensembles_.find(ensemble_id);
+        if (it == ensembles_.end()) {
+            throw std::runtime_error("Ensemble not found: " + std::to_string(ensemble_id));
+        }
+        return *it->second;
+    }
+    
+    Dopri5Integrator& find_dopri5(int integrator_id, size_t dim) {
+        auto it = dopri5_integrators_.find(integrator_id);
+        if (it == dopri5_integrators_.end()) {
+            throw std::runtime_error("Dopri5 integrator not found: " + std::to_string(integrator_id));
+        }
+        if (static_cast<int>(dim) != it->second->dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        return *it->second;
+    }
+    
+    SymplecticIntegrator& find_symplectic(int integrator_id) {
+        auto it = symplectic_integrators_.find(integrator_id);
+        if (it == symplectic_integrators_.end()) {
+            throw std::runtime_error("Symplectic integrator not found: " + std::to_string(integrator_id));
+        }
+        return *it->second;
+    }
+    
+    SymplecticIntegrator& find_symplectic(int integrator_id, size_t dim) {
+        auto& integrator = find_symplectic(integrator_id);
+        if (static_cast<int>(dim) != integrator.dim()) {
+            throw std::runtime_error("State dimension mismatch");
+        }
+        return integrator;
+    }
+    
+    RiemannianSurface& find_surface(int surface_id) {
+        auto it = surfaces_.find(surface_id);
+        if (it == surfaces_.end()) {
+            throw std::runtime_error("Riemannian surface not found: " + std::to_string(surface_id));
+        }
+        return *it->second;
+    }
+    
+    OrderConditionEngine& find_order_conditions(int engine_id, const std::vector<double>& A,
+                                                const std::vector<double>& b) {
+        auto it = order_conditions_.find(engine_id);
+        if (it == order_conditions_.end()) {
+            throw std::runtime_error("Order condition engine not found: " + std::to_string(engine_id));
+        }
+        const size_t s = it->second->stages();
+        if (A.size() != s * s || b.size() != s) {
+            throw std::runtime_error("Tableau size mismatch");
+        }
+        return *it->second;
+    }
+    
+    TableauConverter& find_converter(int converter_id) {
+        auto it = tableau_converters_.find(converter_id);
+        if (it == tableau_converters_.end()) {
+            throw std::runtime_error("Tableau converter not found: " + std::to_string(converter_id));
+        }
+        return *it->second;
+    }
+    
+    MembraneNetwork& find_membrane_network(int network_id) {
+        auto it = membrane_networks_.find(network_id);
+        if (it == membrane_networks_.end()) {
+            throw std::runtime_error("Membrane network not found: " + std::to_string(network_id));
+        }
+        return *it->second;
+    }
+    
+    EvaluationService& find_evaluation_service(int service_id) {
+        auto it = evaluation_services_.find(service_id);
+        if (it == evaluation_services_.end()) {
+            throw std::runtime_error("Evaluation service not found: " + std::to_string(service_id));
+        }
+        return *it->second;
+    }
+    
+    FitnessCache& find_fitness_cache(int cache_id) {
+        auto it = fitness_caches_.find(cache_id);
+        if (it == fitness_caches_.end()) {
+            throw std::runtime_error("Fitness cache not found: " + std::to_string(cache_id));
+        }
+        return *it->second;
+    }
+    
+    static int objective_count(const std::vector<double>& objectives, int num_objectives) {
+        if (num_objectives < 1 || objectives.size() % num_objectives != 0) {
+            throw std::runtime_error("Objective buffer is not num_objectives × n");
+        }
+        return static_cast<int>(objectives.size() / num_objectives);
+    }
+    
+    static RandomKey random_key(int64_t seed, int generation, int individual, int op) {
+        if (op < 0 || op > static_cast<int>(RandomOperator::Replacement)) {
+            throw std::runtime_error("Unknown random operator: " + std::to_string(op));
+        }
+        return {static_cast<uint64_t>(seed), static_cast<uint32_t>(generation),
+                static_cast<uint32_t>(individual), static_cast<RandomOperator>(op)};
+    }
+    
+    PopulationStore& find_population(int population_id) {
+        auto it = populations_.find(population_id);
+        if (it == populations_.end()) {
+            throw std::runtime_error("Population not found: " + std::to_string(population_id));
+        }
+        return *it->second;
+    }
+    
+    int make_steady_state(int fitness_id, int genome_length, std::shared_ptr<const SteadyStateOperators> operators,
+                          double crossover_rate, double mutation_rate, int policy, int replace_tournament_size,
+                          double timeout_seconds, double penalty) {
+        auto it = fitness_kernels_.find(fitness_id);
+        if (it == fitness_kernels_.end()) {
+            throw std::runtime_error("Fitness kernel not found: " + std::to_string(fitness_id));
+        }
+        if (policy < 0 || policy > static_cast<int>(ReplacementPolicy::TournamentReplace)) {
+            throw std::runtime_error("Unknown replacement policy: " + std::to_string(policy));
+        }
+        
+        SteadyStateParams params;
+        params.crossover_rate = crossover_rate;
+        params.mutation_rate = mutation_rate;
+        params.policy = static_cast<ReplacementPolicy>(policy);
+        params.replace_tournament_size = replace_tournament_size;
+        params.timeout_seconds = timeout_seconds;
+        params.penalty = penalty;
+        int id = next_id_++;
+        steady_states_[id] = std::make_shared<SteadyStateEngine>(it->second, genome_length, params,
+                                                                 std::move(operators));
+        return id;
+    }
+    
+    SteadyStateEngine& find_steady_state(int engine_id) {
+        auto it = steady_states_.find(engine_id);
+        if (it == steady_states_.end()) {
+            throw std::runtime_error("Steady-state engine not found: " + std::to_string(engine_id));
+        }
+        return *it->second;
+    }
+    
+    IslandCoordinator& find_island_coordinator(int model_id) {
+        auto it = island_coordinators_.find(model_id);
+        if (it == island_coordinators_.end()) {
+            throw std::runtime_error("Island model not found: " + std::to_string(model_id));
+        }
+        return *it->second;
+    }
+    
+    IslandEndpoint& find_island_endpoint(int endpoint_id) {
+        auto it = island_endpoints_.find(endpoint_id);
+        if (it == island_endpoints_.end()) {
+            throw std::runtime_error("Island endpoint not found: " + std::to_string(endpoint_id));
+        }
+        return *it->second;
+    }
+    
+    static GardenGrowth garden_growth(double mutation_rate, double crossover_rate, double selection_pressure,
+                                      int max_order, const std::vector<double>& feedback) {
+        if (feedback.size() != 4) {
+            throw std::runtime_error("Garden feedback is [activity, stability, energy, gradient_norm]");
+        }
+        GardenGrowth growth;
+        growth.mutation_rate = mutation_rate;
+        growth.crossover_rate = crossover_rate;
+        growth.selection_pressure = selection_pressure;
+        growth.max_order = max_order;
+        growth.reservoir_activity = feedback[0];
+        growth.reservoir_stability = feedback[1];
+        growth.energy = feedback[2];
+        growth.gradient_norm = feedback[3];
+        return growth;
+    }
+    
+    enum class CheckpointObject : int64_t {
+        Population = 0,
+        Garden = 1,
+        LineageLog = 2,
+        MembraneNetwork = 3,
+        Surface = 4,
+    };
+    
+    // The tree arena and every checkpointed object, keyed by id
+    void collect_checkpoint(CheckpointWriter& writer) {
+        std::vector<int64_t> objects;
+        auto add = [&](CheckpointObject kind, int id, const auto& object) {
+            objects.insert(objects.end(), {static_cast<int64_t>(kind), id});
+            object->save(writer, checkpoint_prefix(kind, id));
+        };
+        tree_arena_.save(writer, "arena.");
+        for (const auto& [id, population] : populations_) add(CheckpointObject::Population, id, population);
+        for (const auto& [id, garden] : gardens_) add(CheckpointObject::Garden, id, garden);
+        for (const auto& [id, log] : lineage_logs_) add(CheckpointObject::LineageLog, id, log);
+        for (const auto& [id, network] : membrane_networks_) add(CheckpointObject::MembraneNetwork, id, network);
+        for (const auto& [id, surface] : surfaces_) add(CheckpointObject::Surface, id, surface);
+        writer.add_values<int64_t>("bridge.meta", {next_id_});
+        writer.add_values<int64_t>("bridge.objects", std::move(objects));
+    }
+    
+    static std::string checkpoint_prefix(CheckpointObject kind, int id) {
+        static const char* const names[] = {"population.", "garden.", "lineage.", "network.", "surface."};
+        const auto k = static_cast<size_t>(kind);
+        if (k >= sizeof(names) / sizeof(names[0])) {
+            throw std::runtime_error("Unknown checkpoint object kind: " + std::to_string(static_cast<int64_t>(kind)));
+        }
+        return names[k] + std::to_string(id) + ".";
+    }
+    
+    DeltaCheckpointer& find_checkpoint_chain(int chain_id) {
+        auto it = checkpoint_chains_.find(chain_id);
+        if (it == checkpoint_chains_.end()) {
+            throw std::runtime_error("Checkpoint chain not found: " + std::to_string(chain_id));
+        }
+        return *it->second;
+    }
+    
+    LineageLog& find_lineage_log(int log_id) {
+        auto it = lineage_logs_.find(log_id);
+        if (it == lineage_logs_.end()) {
+            throw std::runtime_error("Lineage log not found: " + std::to_string(log_id));
+        }
+        return *it->second;
+    }
+    
+    GardenTable& find_garden(int garden_id) {
+        auto it = gardens_.find(garden_id);
+        if (it == gardens_.end()) {
+            throw std::runtime_error("Garden not found: " + std::to_string(garden_id));
+        }
+        return *it->second;
+    }
+    
+    CompiledKernel& find_compiled_kernel(int kernel_id) {
+        auto it = kernels_.find(kernel_id);
+        if (it == kernels_.end()) {
+            throw std::runtime_error("Kernel not found: " + std::to_string(kernel_id));
+        }
+        auto* compiled = dynamic_cast<CompiledKernel*>(it->second.get());
+        if (!compiled) {
+            throw std::runtime_error("Kernel is not compiled: " + std::to_string(kernel_id));
+        }
+        return *compiled;
+    }
+    
     tf::Executor executor_;
     tf::CognitiveExecutor cognitive_executor_;
     
@@ -249,6 +1756,34 @@ private:
     std::map<int, std::shared_ptr<tf::Atom>> atoms_;
     std::map<int, std::shared_ptr<tf::CognitiveTensor>> tensors_;
     
+    TreeArena tree_arena_;
+    TreeOperators tree_operators_{tree_arena_};
+    ParetoSelector pareto_selector_;
+    std::map<int, std::shared_ptr<RhsKernel>> kernels_;
+    std::map<int, std::shared_ptr<ElementaryDifferentialDAG>> differential_dags_;
+    std::map<int, std::shared_ptr<BSeriesStepper>> steppers_;
+    std::map<int, std::shared_ptr<EnsembleIntegrator>> ensembles_;
+    std::map<int, std::shared_ptr<Dopri5Integrator>> dopri5_integrators_;
+    std::map<int, std::shared_ptr<Hamiltonian>> hamiltonians_;
+    std::map<int, std::shared_ptr<SymplecticIntegrator>> symplectic_integrators_;
+    std::map<int, std::shared_ptr<RiemannianSurface>> surfaces_;
+    std::map<int, std::shared_ptr<LossKernel>> losses_;
+    std::map<int, std::shared_ptr<GradientService>> gradient_services_;
+    std::map<int, std::shared_ptr<OrderConditionEngine>> order_conditions_;
+    std::map<int, std::shared_ptr<TableauConverter>> tableau_converters_;
+    std::map<int, std::shared_ptr<MembraneNetwork>> membrane_networks_;
+    std::map<int, std::shared_ptr<FitnessKernel>> fitness_kernels_;
+    std::map<int, std::shared_ptr<EvaluationService>> evaluation_services_;
+    std::map<int, std::shared_ptr<FitnessCache>> fitness_caches_;
+    std::map<int, std::shared_ptr<PopulationStore>> populations_;
+    std::map<int, std::shared_ptr<const SteadyStateOperators>> steady_state_operators_;
+    std::map<int, std::shared_ptr<SteadyStateEngine>> steady_states_;
+    std::map<int, std::shared_ptr<IslandCoordinator>> island_coordinators_;
+    std::map<int, std::shared_ptr<IslandEndpoint>> island_endpoints_;
+    std::map<int, std::shared_ptr<GardenTable>> gardens_;
+    std::map<int, std::shared_ptr<LineageLog>> lineage_logs_;
+    std::map<int, std::shared_ptr<DeltaCheckpointer>> checkpoint_chains_;
+    
     int next_id_;
 };
 
@@ -276,6 +1811,140 @@ JLCXX_MODULE define_julia_module(jlcxx::Module& mod) {
         .method("get_tensor_data", &TaskflowBridge::get_tensor_data)
         .method("taskgraph_to_tree", &TaskflowBridge::taskgraph_to_tree)
         .method("tree_to_taskgraph", &TaskflowBridge::tree_to_taskgraph)
+        .method("intern_tree", &TaskflowBridge::intern_tree)
+        .method("enumerate_trees", &TaskflowBridge::enumerate_trees)
+        .method("tree_level_sequence", &TaskflowBridge::tree_level_sequence)
+        .method("replace_subtree", &TaskflowBridge::replace_subtree)
+        .method("prune_subtree", &TaskflowBridge::prune_subtree)
+        .method("graft_subtree", &TaskflowBridge::graft_subtree)
+        .method("breed_trees", &TaskflowBridge::breed_trees)
+        .method("tree_symmetry", &TaskflowBridge::tree_symmetry)
+        .method("tree_density", &TaskflowBridge::tree_density)
+        .method("create_differential_dag", &TaskflowBridge::create_differential_dag)
+        .method("evaluate_elementary_differentials", &TaskflowBridge::evaluate_elementary_differentials)
+        .method("create_bseries_stepper", &TaskflowBridge::create_bseries_stepper)
+        .method("set_bseries_coefficients", &TaskflowBridge::set_bseries_coefficients)
+        .method("bseries_step", &TaskflowBridge::bseries_step)
+        .method("bseries_integrate", &TaskflowBridge::bseries_integrate)
+        .method("create_ensemble", &TaskflowBridge::create_ensemble)
+        .method("set_ensemble_coefficients", &TaskflowBridge::set_ensemble_coefficients)
+        .method("set_ensemble_states", &TaskflowBridge::set_ensemble_states)
+        .method("get_ensemble_states", &TaskflowBridge::get_ensemble_states)
+        .method("ensemble_integrate", &TaskflowBridge::ensemble_integrate)
+        .method("create_dopri5", &TaskflowBridge::create_dopri5)
+        .method("dopri5_solve", &TaskflowBridge::dopri5_solve)
+        .method("dopri5_solve_to_file", &TaskflowBridge::dopri5_solve_to_file)
+        .method("load_compiled_hamiltonian", &TaskflowBridge::load_compiled_hamiltonian)
+        .method("create_symplectic_integrator", &TaskflowBridge::create_symplectic_integrator)
+        .method("symplectic_integrate", &TaskflowBridge::symplectic_integrate)
+        .method("symplectic_energy", &TaskflowBridge::symplectic_energy)
+        .method("set_symplectic_midpoint_tolerance", &TaskflowBridge::set_symplectic_midpoint_tolerance)
+        .method("get_symplectic_stats", &TaskflowBridge::get_symplectic_stats)
+        .method("create_riemannian_surface", &TaskflowBridge::create_riemannian_surface)
+        .method("set_surface_metric", &TaskflowBridge::set_surface_metric)
+        .method("update_surface_metric", &TaskflowBridge::update_surface_metric)
+        .method("surface_gradient_step", &TaskflowBridge::surface_gradient_step)
+        .method("get_surface_coefficients", &TaskflowBridge::get_surface_coefficients)
+        .method("surface_distance", &TaskflowBridge::surface_distance)
+        .method("get_surface_history", &TaskflowBridge::get_surface_history)
+        .method("load_compiled_loss", &TaskflowBridge::load_compiled_loss)
+        .method("create_gradient_service", &TaskflowBridge::create_gradient_service)
+        .method("compute_gradient", &TaskflowBridge::compute_gradient)
+        .method("create_order_conditions", &TaskflowBridge::create_order_conditions)
+        .method("order_condition_residuals", &TaskflowBridge::order_condition_residuals)
+        .method("order_condition_jacobian", &TaskflowBridge::order_condition_jacobian)
+        .method("create_tableau_converter", &TaskflowBridge::create_tableau_converter)
+        .method("convert_tableau", &TaskflowBridge::convert_tableau)
+        .method("convert_tableaux", &TaskflowBridge::convert_tableaux)
+        .method("bseries_order", &TaskflowBridge::bseries_order)
+        .method("load_compiled_kernel", &TaskflowBridge::load_compiled_kernel)
+        .method("set_kernel_parameters", &TaskflowBridge::set_kernel_parameters)
+        .method("kernel_jacobian", &TaskflowBridge::kernel_jacobian)
+        .method("create_membrane_network", &TaskflowBridge::create_membrane_network)
+        .method("set_membrane_communication", &TaskflowBridge::set_membrane_communication)
+        .method("set_membrane_reservoir", &TaskflowBridge::set_membrane_reservoir)
+        .method("set_membrane_state", &TaskflowBridge::set_membrane_state)
+        .method("get_membrane_state", &TaskflowBridge::get_membrane_state)
+        .method("membrane_network_step", &TaskflowBridge::membrane_network_step)
+        .method("get_membrane_global_state", &TaskflowBridge::get_membrane_global_state)
+        .method("membrane_global_state_data", &TaskflowBridge::membrane_global_state_data)
+        .method("membrane_total_size", &TaskflowBridge::membrane_total_size)
+        .method("membrane_network_run", &TaskflowBridge::membrane_network_run)
+        .method("load_compiled_fitness", &TaskflowBridge::load_compiled_fitness)
+        .method("create_evaluation_service", &TaskflowBridge::create_evaluation_service)
+        .method("evaluate_population", &TaskflowBridge::evaluate_population)
+        .method("get_evaluation_status", &TaskflowBridge::get_evaluation_status)
+        .method("get_evaluation_stats", &TaskflowBridge::get_evaluation_stats)
+        .method("create_fitness_cache", &TaskflowBridge::create_fitness_cache)
+        .method("attach_fitness_cache", &TaskflowBridge::attach_fitness_cache)
+        .method("set_fitness_data_version", &TaskflowBridge::set_fitness_data_version)
+        .method("clear_fitness_cache", &TaskflowBridge::clear_fitness_cache)
+        .method("get_fitness_cache_stats", &TaskflowBridge::get_fitness_cache_stats)
+        .method("create_population", &TaskflowBridge::create_population)
+        .method("population_add", &TaskflowBridge::population_add)
+        .method("get_population_coefficients", &TaskflowBridge::get_population_coefficients)
+        .method("get_population_ids", &TaskflowBridge::get_population_ids)
+        .method("get_population_parents", &TaskflowBridge::get_population_parents)
+        .method("set_population_fitness", &TaskflowBridge::set_population_fitness)
+        .method("get_population_fitness", &TaskflowBridge::get_population_fitness)
+        .method("population_next_generation", &TaskflowBridge::population_next_generation)
+        .method("population_distances", &TaskflowBridge::population_distances)
+        .method("population_diversity", &TaskflowBridge::population_diversity)
+        .method("population_column_moments", &TaskflowBridge::population_column_moments)
+        .method("random_uniform", &TaskflowBridge::random_uniform)
+        .method("random_normal", &TaskflowBridge::random_normal)
+        .method("random_integers", &TaskflowBridge::random_integers)
+        .method("create_steady_state", &TaskflowBridge::create_steady_state)
+        .method("load_compiled_operators", &TaskflowBridge::load_compiled_operators)
+        .method("create_steady_state_with_operators", &TaskflowBridge::create_steady_state_with_operators)
+        .method("steady_state_initialize", &TaskflowBridge::steady_state_initialize)
+        .method("steady_state_run", &TaskflowBridge::steady_state_run)
+        .method("get_steady_state_genomes", &TaskflowBridge::get_steady_state_genomes)
+        .method("get_steady_state_fitness", &TaskflowBridge::get_steady_state_fitness)
+        .method("get_steady_state_ids", &TaskflowBridge::get_steady_state_ids)
+        .method("get_steady_state_parents", &TaskflowBridge::get_steady_state_parents)
+        .method("get_steady_state_stats", &TaskflowBridge::get_steady_state_stats)
+        .method("create_island_model", &TaskflowBridge::create_island_model)
+        .method("launch_islands", &TaskflowBridge::launch_islands)
+        .method("wait_islands", &TaskflowBridge::wait_islands)
+        .method("get_island_status", &TaskflowBridge::get_island_status)
+        .method("attach_island", &TaskflowBridge::attach_island)
+        .method("island_should_migrate", &TaskflowBridge::island_should_migrate)
+        .method("island_emigrate", &TaskflowBridge::island_emigrate)
+        .method("island_immigrate", &TaskflowBridge::island_immigrate)
+        .method("island_report", &TaskflowBridge::island_report)
+        .method("pareto_ranks", &TaskflowBridge::pareto_ranks)
+        .method("crowding_distance", &TaskflowBridge::crowding_distance)
+        .method("nsga2_select", &TaskflowBridge::nsga2_select)
+        .method("reference_points", &TaskflowBridge::reference_points)
+        .method("nsga3_select", &TaskflowBridge::nsga3_select)
+        .method("create_garden_table", &TaskflowBridge::create_garden_table)
+        .method("garden_plant", &TaskflowBridge::garden_plant)
+        .method("garden_grow", &TaskflowBridge::garden_grow)
+        .method("garden_grow_membranes", &TaskflowBridge::garden_grow_membranes)
+        .method("garden_exchange", &TaskflowBridge::garden_exchange)
+        .method("garden_prune", &TaskflowBridge::garden_prune)
+        .method("garden_quantile", &TaskflowBridge::garden_quantile)
+        .method("get_garden_trees", &TaskflowBridge::get_garden_trees)
+        .method("get_garden_membranes", &TaskflowBridge::get_garden_membranes)
+        .method("get_garden_fitness", &TaskflowBridge::get_garden_fitness)
+        .method("get_garden_membrane_rows", &TaskflowBridge::get_garden_membrane_rows)
+        .method("get_garden_stats", &TaskflowBridge::get_garden_stats)
+        .method("create_lineage_log", &TaskflowBridge::create_lineage_log)
+        .method("lineage_record", &TaskflowBridge::lineage_record)
+        .method("lineage_record_population", &TaskflowBridge::lineage_record_population)
+        .method("lineage_ancestors", &TaskflowBridge::lineage_ancestors)
+        .method("lineage_descendants", &TaskflowBridge::lineage_descendants)
+        .method("lineage_prune", &TaskflowBridge::lineage_prune)
+        .method("get_lineage_stats", &TaskflowBridge::get_lineage_stats)
+        .method("save_checkpoint", &TaskflowBridge::save_checkpoint)
+        .method("load_checkpoint", &TaskflowBridge::load_checkpoint)
+        .method("get_checkpoint_info", &TaskflowBridge::get_checkpoint_info)
+        .method("create_checkpoint_chain", &TaskflowBridge::create_checkpoint_chain)
+        .method("checkpoint_chain_base", &TaskflowBridge::checkpoint_chain_base)
+        .method("checkpoint_chain_delta", &TaskflowBridge::checkpoint_chain_delta)
+        .method("compact_checkpoint_chain", &TaskflowBridge::compact_checkpoint_chain)
+        .method("get_checkpoint_chain_stats", &TaskflowBridge::get_checkpoint_chain_stats)
         .method("num_taskflows", &TaskflowBridge::num_taskflows)
         .method("num_atomspaces", &TaskflowBridge::num_atomspaces)
         .method("num_tensors", &TaskflowBridge::num_tensors);
@@ -289,6 +1958,39 @@ int main() {
     
     std::cout << "=== Taskflow Bridge Standalone Test ===\n\n";
     
+    // Every check feeds the exit status, so a regression in any engine fails the run
+    int failures = 0;
+    auto expect = [&failures](bool ok) {
+        failures += ok ? 0 : 1;
+        return ok;
+    };
+    // Fixture units are found through DTE_SOURCE_DIR when defined, next to __FILE__, or
+    // under src/DeepTreeEcho when run from the repository root, and built with $CXX
+    // into a per-process library; returns that library path, or "" if the build fails
+    auto build_fixture = [](const std::string& fixture) {
+        const std::string source = __FILE__;
+        const std::size_t slash = source.find_last_of('/');
+        std::vector<std::string> source_dirs;
+#ifdef DTE_SOURCE_DIR
+        source_dirs.push_back(DTE_SOURCE_DIR);
+#endif
+        source_dirs.push_back(slash == std::string::npos ? "." : source.substr(0, slash));
+        source_dirs.push_back("src/DeepTreeEcho");
+        std::string source_dir = source_dirs.front();
+        for (const auto& dir : source_dirs) {
+            if (::access((dir + "/" + fixture + ".cpp").c_str(), R_OK) == 0) {
+                source_dir = dir;
+                break;
+            }
+        }
+        const std::string library = "/tmp/libdte_" + fixture + "_" + std::to_string(::getpid()) + ".so";
+        const char* cxx = std::getenv("CXX");
+        const std::string build = std::string(cxx ? cxx : "c++") +
+            " -std=c++17 -O2 -shared -fPIC -fvisibility=hidden -I" + source_dir + " " +
+            source_dir + "/" + fixture + ".cpp -o " + library;
+        return std::system(build.c_str()) == 0 ? library : std::string();
+    };
+    
     // Create bridge
     TaskflowBridge bridge(4);
     
@@ -336,12 +2038,897 @@ int main() {
     int tf_from_tree = bridge.tree_to_taskgraph(tree);
     std::cout << "\nCreated taskflow " << tf_from_tree << " from tree\n";
     
+    // Elementary differentials of y' = y^2: Σ_{|τ|=n} F(τ)/(σ(τ)γ(τ)) = y^(n+1)
+    int kernel_id = bridge.register_kernel(make_rhs_kernel(
+        [](const auto* y, auto* dy) { dy[0] = y[0] * y[0]; }, 1, "riccati"));
+    int dag_id = bridge.create_differential_dag(kernel_id, 6);
+    const double y0 = 0.7;
+    auto F = bridge.evaluate_elementary_differentials(dag_id, {y0});
+    auto trees = bridge.enumerate_trees(6);
+    std::vector<double> taylor(7, 0.0);
+    for (size_t s = 0; s < trees.size(); ++s) {
+        int order = bridge.tree_level_sequence(trees[s]).size();
+        taylor[order] += F[s] / (bridge.tree_symmetry(trees[s]) * bridge.tree_density(trees[s]));
+    }
+    double max_err = 0.0;
+    for (int n = 1; n <= 6; ++n) {
+        max_err = std::max(max_err, std::abs(taylor[n] - std::pow(y0, n + 1)));
+    }
+    std::cout << "\nElementary differentials: " << trees.size()
+              << " trees up to order 6, Taylor identity error " << max_err << "\n";
+    expect(max_err < 1e-12);
+    // Hyper-dual tanh stays finite when saturated: value t, first 1 - t², second -2t(1 - t²)
+    bool tanh_ok = true;
+    for (double x : {0.7, -3.0, 200.0, -400.0}) {
+        HyperDual<2> xd(x);
+        xd.seed(0, 1.0);
+        xd.seed(1, 1.0);
+        const HyperDual<2> td = tanh(xd);
+        const double t = std::tanh(x), dt = 1.0 - t * t;
+        tanh_ok = tanh_ok && std::abs(td.value() - t) < 1e-15 && std::abs(td.c[1] - dt) < 1e-15 &&
+                  std::abs(td.c[2] - dt) < 1e-15 && std::abs(td.top() + 2.0 * t * dt) < 1e-15;
+    }
+    std::cout << "Hyper-dual tanh at |x| up to 400: " << (expect(tanh_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Order-4 B-series (b = 1/γ) on y' = y^2 from y(0) = 0.5 to t = 1, exact y = 1
+    int stepper_id = bridge.create_bseries_stepper(kernel_id, 4);
+    std::vector<double> state = {0.5};
+    bridge.bseries_integrate(stepper_id, state, 0.01, 100);
+    std::cout << "B-series order 4: y(1) = " << state[0]
+              << ", error " << std::abs(state[0] - 1.0) << "\n";
+    expect(std::abs(state[0] - 1.0) < 1e-7);
+    
+    // Ensemble of 10 initial conditions y0 = 0.05k, exact y(1) = y0 / (1 - y0)
+    int vector_kernel_id = bridge.register_kernel(make_vector_rhs_kernel(
+        [](const auto* y, auto* dy) { dy[0] = y[0] * y[0]; }, 1, "riccati"));
+    int ensemble_id = bridge.create_ensemble(vector_kernel_id, 4, 10);
+    std::vector<double> initial(10);
+    for (int k = 0; k < 10; ++k) initial[k] = 0.05 * (k + 1);
+    bridge.set_ensemble_states(ensemble_id, initial);
+    bridge.ensemble_integrate(ensemble_id, 0.01, 100);
+    auto finals = bridge.get_ensemble_states(ensemble_id);
+    double ensemble_err = 0.0;
+    for (int k = 0; k < 10; ++k) {
+        ensemble_err = std::max(ensemble_err, std::abs(finals[k] - initial[k] / (1.0 - initial[k])));
+    }
+    std::cout << "Ensemble of 10 trajectories: max error " << ensemble_err << "\n";
+    expect(ensemble_err < 1e-7);
+    bool ensemble_null_ok = false;
+    try {
+        TreeArena ensemble_arena;
+        EnsembleIntegrator(nullptr, ensemble_arena, 4, 10, 1);
+    } catch (const std::runtime_error&) {
+        ensemble_null_ok = true;
+    }
+    std::cout << "Ensemble without a kernel rejected " << (expect(ensemble_null_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Dopri5 with dense output on y' = y^2, y(0) = 0.5: y(t) = 0.5 / (1 - 0.5t)
+    int dp5_id = bridge.create_dopri5(kernel_id, 1e-9, 1e-12);
+    std::vector<double> dp5_state = {0.5};
+    auto dense = bridge.dopri5_solve(dp5_id, dp5_state, 0.0, 1.0, 0.1);
+    double dense_err = 0.0;
+    for (size_t r = 0; r < dense.size() / 2; ++r) {
+        dense_err = std::max(dense_err, std::abs(dense[2 * r + 1] - 0.5 / (1.0 - 0.5 * dense[2 * r])));
+    }
+    std::cout << "Dopri5: " << dense.size() / 2 << " dense rows, max error " << dense_err
+              << ", y(1) = " << dp5_state[0] << "\n";
+    expect(dense_err < 1e-6);
+    // A remainder far below the underflow bound still ends the solve normally
+    bridge.dopri5_solve(dp5_id, dp5_state, 0.0, 1e-20, 0.0);
+    
+    // Pendulum H = p²/2 - cos q: bounded energy error, 2nd/4th/6th order convergence
+    int pendulum_id = bridge.register_hamiltonian(make_separable_hamiltonian(
+        [](const auto* p) { return 0.5 * p[0] * p[0]; },
+        [](const auto* q) { using std::cos; return -cos(q[0]); }, 1));
+    const double pendulum_ref[] = {1.0, 0.0};
+    double reference = 0.0;
+    {
+        int ref_id = bridge.create_symplectic_integrator(pendulum_id, "yoshida6");
+        std::vector<double> z(pendulum_ref, pendulum_ref + 2);
+        bridge.symplectic_integrate(ref_id, z, 0.001, 10000);
+        reference = z[0];
+    }
+    const std::pair<const char*, double> schemes[] = {{"verlet", 2.0}, {"yoshida4", 4.0}, {"yoshida6", 6.0}, {"midpoint", 2.0}};
+    for (const auto& [scheme, scheme_order] : schemes) {
+        int sym_id = bridge.create_symplectic_integrator(pendulum_id, scheme);
+        std::vector<double> z(pendulum_ref, pendulum_ref + 2);
+        const double e0 = bridge.symplectic_energy(sym_id, z);
+        double drift = 0.0;
+        for (int k = 0; k < 100; ++k) {
+            bridge.symplectic_integrate(sym_id, z, 0.1, 10);
+            drift = std::max(drift, std::abs(bridge.symplectic_energy(sym_id, z) - e0));
+        }
+        std::vector<double> coarse(pendulum_ref, pendulum_ref + 2);
+        std::vector<double> fine(pendulum_ref, pendulum_ref + 2);
+        bridge.symplectic_integrate(sym_id, coarse, 0.1, 100);
+        bridge.symplectic_integrate(sym_id, fine, 0.05, 200);
+        const double rate = std::log2(std::abs(coarse[0] - reference) / std::abs(fine[0] - reference));
+        std::cout << "Symplectic " << scheme << ": energy drift over t = 100 " << drift
+                  << ", observed order " << rate << "\n";
+        expect(std::abs(rate - scheme_order) < 0.2 && drift < 1e-2);
+    }
+    // Integrators sharing one Hamiltonian run concurrently and match a sequential run
+    bool shared_hamiltonian_ok = true;
+    {
+        std::vector<int> ids;
+        std::vector<std::vector<double>> parallel(4, std::vector<double>(pendulum_ref, pendulum_ref + 2));
+        for (int k = 0; k < 4; ++k) ids.push_back(bridge.create_symplectic_integrator(pendulum_id, k % 2 ? "midpoint" : "yoshida4"));
+        std::vector<std::thread> threads;
+        for (int k = 0; k < 4; ++k) {
+            threads.emplace_back([&, k] { bridge.symplectic_integrate(ids[k], parallel[k], 0.01, 5000); });
+        }
+        for (auto& thread : threads) thread.join();
+        for (int k = 0; k < 4; ++k) {
+            std::vector<double> z(pendulum_ref, pendulum_ref + 2);
+            bridge.symplectic_integrate(bridge.create_symplectic_integrator(pendulum_id, k % 2 ? "midpoint" : "yoshida4"),
+                                        z, 0.01, 5000);
+            shared_hamiltonian_ok = shared_hamiltonian_ok && z == parallel[k];
+        }
+    }
+    std::cout << "Symplectic: 4 threads on one Hamiltonian " << (expect(shared_hamiltonian_ok) ? "OK" : "MISMATCH") << "\n";
+    // Midpoint steps that stop at the iteration cap are counted, converged ones are not
+    bool midpoint_count_ok = false;
+    {
+        int midpoint_id = bridge.create_symplectic_integrator(pendulum_id, "midpoint");
+        std::vector<double> z(pendulum_ref, pendulum_ref + 2);
+        bridge.symplectic_integrate(midpoint_id, z, 0.1, 20);
+        const auto converged = bridge.get_symplectic_stats(midpoint_id);
+        bridge.set_symplectic_midpoint_tolerance(midpoint_id, 1e-14, 2);
+        bridge.symplectic_integrate(midpoint_id, z, 0.1, 20);
+        const auto capped = bridge.get_symplectic_stats(midpoint_id);
+        midpoint_count_ok = converged[0] == 20 && converged[2] == 0 && capped[0] == 40 && capped[2] == 20 &&
+                            capped[1] - converged[1] == 40;
+    }
+    std::cout << "Symplectic: unconverged midpoint steps counted " << (expect(midpoint_count_ok) ? "OK" : "MISMATCH") << "\n";
+    // The compiled pendulum (compiled_objective_fixture.cpp) follows the functor one
+    bool compiled_hamiltonian_ok = false;
+    {
+        const std::string library = build_fixture("compiled_objective_fixture");
+        if (!library.empty()) {
+            const int compiled_pendulum_id = bridge.load_compiled_hamiltonian(library, {1.0});
+            compiled_hamiltonian_ok = true;
+            for (const char* scheme : {"yoshida4", "midpoint"}) {
+                std::vector<double> native(pendulum_ref, pendulum_ref + 2);
+                std::vector<double> compiled(pendulum_ref, pendulum_ref + 2);
+                bridge.symplectic_integrate(bridge.create_symplectic_integrator(pendulum_id, scheme), native, 0.05, 200);
+                const int compiled_sym_id = bridge.create_symplectic_integrator(compiled_pendulum_id, scheme);
+                bridge.symplectic_integrate(compiled_sym_id, compiled, 0.05, 200);
+                compiled_hamiltonian_ok = compiled_hamiltonian_ok && std::abs(compiled[0] - native[0]) < 1e-12 &&
+                                          std::abs(compiled[1] - native[1]) < 1e-12 &&
+                                          std::abs(bridge.symplectic_energy(compiled_sym_id, compiled) -
+                                                   bridge.symplectic_energy(compiled_sym_id, native)) < 1e-12;
+            }
+            try {
+                bridge.load_compiled_hamiltonian(library, {});
+                compiled_hamiltonian_ok = false;
+            } catch (const std::runtime_error&) {
+            }
+            std::remove(library.c_str());
+        }
+    }
+    std::cout << "Symplectic: compiled Hamiltonian library " << (expect(compiled_hamiltonian_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Riemannian step after a rank-2 metric update: check M · (Δc / η) = g
+    const int surface_n = 6;
+    std::vector<double> metric(surface_n * surface_n, 0.0);
+    for (int i = 0; i < surface_n; ++i) {
+        for (int j = 0; j < surface_n; ++j) metric[i * surface_n + j] = i == j ? 1.0 + i : 0.1 / (1 + std::abs(i - j));
+    }
+    std::vector<double> updates(2 * surface_n), signs = {1.0, -1.0};
+    for (int i = 0; i < surface_n; ++i) {
+        updates[i] = 0.3 * (i + 1);
+        updates[surface_n + i] = 0.2 * std::cos(i);
+    }
+    int surface_id = bridge.create_riemannian_surface(std::vector<double>(surface_n, 1.0), 4);
+    bridge.set_surface_metric(surface_id, metric);
+    bridge.update_surface_metric(surface_id, updates, signs);
+    for (int r = 0; r < 2; ++r) {
+        for (int i = 0; i < surface_n; ++i) {
+            for (int j = 0; j < surface_n; ++j) {
+                metric[i * surface_n + j] += signs[r] * updates[r * surface_n + i] * updates[r * surface_n + j];
+            }
+        }
+    }
+    std::vector<double> gradient(surface_n);
+    for (int i = 0; i < surface_n; ++i) gradient[i] = std::sin(i + 1.0);
+    for (int k = 0; k < 10; ++k) bridge.surface_gradient_step(surface_id, gradient, 0.1);
+    auto c_now = bridge.get_surface_coefficients(surface_id);
+    auto c_prev = bridge.get_surface_history(surface_id, 1);
+    double metric_residual = 0.0;
+    for (int i = 0; i < surface_n; ++i) {
+        double acc = 0.0;
+        for (int j = 0; j < surface_n; ++j) acc += metric[i * surface_n + j] * (c_prev[j] - c_now[j]) / 0.1;
+        metric_residual = std::max(metric_residual, std::abs(acc - gradient[i]));
+    }
+    std::cout << "Riemannian surface: rank-2 updated metric, solve residual " << metric_residual
+              << ", distance of last step " << bridge.surface_distance(surface_id, c_prev) << "\n";
+    expect(metric_residual < 1e-10);
+    // An update whose second row cannot be downdated leaves the metric as it was
+    const double distance_before = bridge.surface_distance(surface_id, c_prev);
+    bool rollback_ok = false;
+    try {
+        std::vector<double> rows(2 * surface_n, 0.0);
+        rows[0] = 1.0;
+        rows[surface_n + 1] = 100.0;
+        bridge.update_surface_metric(surface_id, rows, {1.0, -1.0});
+    } catch (const std::runtime_error&) {
+        rollback_ok = bridge.surface_distance(surface_id, c_prev) == distance_before;
+    }
+    // A non-finite update-only row is rejected, on a fresh factor and after the failed downdate
+    try {
+        std::vector<double> rows(2 * surface_n, 0.5);
+        rows[surface_n + 2] = std::nan("");
+        bridge.update_surface_metric(surface_id, rows, {1.0, 1.0});
+        rollback_ok = false;
+    } catch (const std::runtime_error&) {
+        rollback_ok = rollback_ok && bridge.surface_distance(surface_id, c_prev) == distance_before;
+    }
+    {
+        CholeskyFactor fresh(surface_n);
+        const std::vector<double> identity = fresh.factor();
+        std::vector<double> row(surface_n, 0.5);
+        row[1] = std::numeric_limits<double>::infinity();
+        try {
+            fresh.rank_one_update(row.data(), 1.0);
+            rollback_ok = false;
+        } catch (const std::runtime_error&) {
+            rollback_ok = rollback_ok && fresh.factor() == identity;
+        }
+    }
+    std::cout << "Riemannian surface: failed rank-2 downdate and non-finite update rolled back " << (expect(rollback_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Gradients of a 500-coefficient Rosenbrock loss: parallel FD vs reverse mode
+    const int loss_n = 500;
+    int loss_id = bridge.register_loss(make_loss_kernel([](const auto* c) {
+        using std::cos;
+        auto acc = 0.0 * c[0];
+        for (int i = 0; i + 1 < loss_n; ++i) {
+            const auto a = c[i + 1] - c[i] * c[i];
+            const auto b = 1.0 - c[i];
+            acc += 100.0 * a * a + b * b + 0.1 * cos(c[i]);
+        }
+        return acc;
+    }, loss_n, "rosenbrock"));
+    int grad_id = bridge.create_gradient_service(loss_id);
+    std::vector<double> point(loss_n);
+    for (int i = 0; i < loss_n; ++i) point[i] = 0.5 + 0.3 * std::sin(0.1 * i);
+    auto grad_central = bridge.compute_gradient(grad_id, point, "central", 0.0);
+    auto grad_reverse = bridge.compute_gradient(grad_id, point, "reverse", 0.0);
+    double grad_diff = 0.0, grad_scale = 0.0;
+    for (int i = 0; i < loss_n; ++i) {
+        grad_diff = std::max(grad_diff, std::abs(grad_central[i] - grad_reverse[i]));
+        grad_scale = std::max(grad_scale, std::abs(grad_reverse[i]));
+    }
+    std::cout << "Gradient service: " << loss_n << " coefficients, central FD vs reverse "
+              << grad_diff / grad_scale << " relative\n";
+    expect(grad_diff / grad_scale < 1e-6);
+    // A compiled loss (compiled_objective_fixture.cpp) hands reverse mode its own gradient
+    bool compiled_loss_ok = false;
+    {
+        const std::string library = build_fixture("compiled_objective_fixture");
+        if (!library.empty()) {
+            const int compiled_grad_id = bridge.create_gradient_service(bridge.load_compiled_loss(library, {100.0}));
+            const std::vector<double> c = {0.5, -0.3, 1.2, 0.8};
+            std::vector<double> analytic(4, 0.0);
+            for (int i = 0; i < 3; ++i) {
+                const double a = c[i + 1] - c[i] * c[i];
+                analytic[i] += -400.0 * a * c[i] - 2.0 * (1.0 - c[i]);
+                analytic[i + 1] += 200.0 * a;
+            }
+            auto compiled_reverse = bridge.compute_gradient(compiled_grad_id, c, "reverse", 0.0);
+            auto compiled_central = bridge.compute_gradient(compiled_grad_id, c, "central", 0.0);
+            compiled_loss_ok = true;
+            for (int i = 0; i < 4; ++i) {
+                compiled_loss_ok = compiled_loss_ok && std::abs(compiled_reverse[i] - analytic[i]) < 1e-12 &&
+                                   std::abs(compiled_central[i] - analytic[i]) < 1e-6 * std::abs(analytic[i]) + 1e-6;
+            }
+            try {
+                bridge.load_compiled_loss(library, {});
+                compiled_loss_ok = false;
+            } catch (const std::runtime_error&) {
+            }
+            std::remove(library.c_str());
+        }
+    }
+    std::cout << "Gradient service: compiled loss library " << (expect(compiled_loss_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Order conditions: classical RK4 satisfies every condition up to order 4
+    int rk4_conditions = bridge.create_order_conditions(5, 4);
+    const std::vector<double> rk4_A = {0, 0, 0, 0,  0.5, 0, 0, 0,  0, 0.5, 0, 0,  0, 0, 1, 0};
+    const std::vector<double> rk4_b = {1.0 / 6, 1.0 / 3, 1.0 / 3, 1.0 / 6};
+    auto rk4_residuals = bridge.order_condition_residuals(rk4_conditions, rk4_A, rk4_b);
+    auto condition_trees = bridge.enumerate_trees(5);
+    double low_order = 0.0, order5 = 0.0;
+    for (size_t s = 0; s < condition_trees.size(); ++s) {
+        const bool fifth = bridge.tree_level_sequence(condition_trees[s]).size() == 5;
+        (fifth ? order5 : low_order) = std::max(fifth ? order5 : low_order, std::abs(rk4_residuals[s]));
+    }
+    auto rk4_jacobian = bridge.order_condition_jacobian(rk4_conditions, rk4_A, rk4_b);
+    double jacobian_err = 0.0;
+    for (int p = 0; p < 20; ++p) {
+        std::vector<double> A_plus = rk4_A, A_minus = rk4_A, b_plus = rk4_b, b_minus = rk4_b;
+        const double h = 1e-6;
+        if (p < 4) {
+            b_plus[p] += h;
+            b_minus[p] -= h;
+        } else {
+            A_plus[p - 4] += h;
+            A_minus[p - 4] -= h;
+        }
+        auto r_plus = bridge.order_condition_residuals(rk4_conditions, A_plus, b_plus);
+        auto r_minus = bridge.order_condition_residuals(rk4_conditions, A_minus, b_minus);
+        for (size_t s = 0; s < condition_trees.size(); ++s) {
+            const double fd = (r_plus[s] - r_minus[s]) / (2 * h);
+            jacobian_err = std::max(jacobian_err, std::abs(fd - rk4_jacobian[s * 20 + p]));
+        }
+    }
+    std::cout << "Order conditions (RK4): max residual order <= 4 " << low_order
+              << ", order 5 " << order5 << ", Jacobian vs FD " << jacobian_err << "\n";
+    expect(low_order < 1e-12 && order5 > 1e-3 && jacobian_err < 1e-6);
+    
+    // Batch tableau conversion (Euler, midpoint, Heun3, RK4 padded to 4 stages)
+    int converter_id = bridge.create_tableau_converter(6, 4);
+    std::vector<double> batch_A(4 * 16, 0.0), batch_b(4 * 4, 0.0);
+    batch_b[0] = 1.0;                 // explicit Euler
+    batch_A[16 + 4] = 0.5;            // explicit midpoint
+    batch_b[4 + 1] = 1.0;
+    batch_A[32 + 4] = 1.0 / 3;        // Heun's third-order method
+    batch_A[32 + 9] = 2.0 / 3;
+    batch_b[8 + 0] = 0.25;
+    batch_b[8 + 2] = 0.75;
+    std::copy(rk4_A.begin(), rk4_A.end(), batch_A.begin() + 48);
+    std::copy(rk4_b.begin(), rk4_b.end(), batch_b.begin() + 12);
+    auto batch_coefficients = bridge.convert_tableaux(converter_id, batch_A, batch_b);
+    const size_t coefficients_per_method = bridge.enumerate_trees(6).size();
+    std::cout << "Tableau conversion: orders";
+    for (int k = 0; k < 4; ++k) {
+        std::vector<double> c(batch_coefficients.begin() + k * coefficients_per_method,
+                              batch_coefficients.begin() + (k + 1) * coefficients_per_method);
+        const int tableau_order = bridge.bseries_order(converter_id, c, 1e-12);
+        expect(tableau_order == k + 1);
+        std::cout << " " << tableau_order;
+    }
+    std::cout << " (expected 1 2 3 4)\n";
+    
+    // Compiled kernels come from NativeRHSExport.jl; a missing library is reported
+    try {
+        bridge.load_compiled_kernel("libdte_missing_kernel.so", {});
+    } catch (const std::runtime_error& e) {
+        std::cout << "Compiled kernel loader: " << e.what() << "\n";
+    }
+    // compiled_rhs_fixture.cpp is emitter output (scripts/generate_compiled_rhs_fixture.jl):
+    // build it, load it and compare values, dual derivatives, Jacobian and a Dopri5 solve
+    // with a reference
+    bool compiled_ok = false;
+    {
+        const std::string library = build_fixture("compiled_rhs_fixture");
+        if (!library.empty()) {
+            const std::vector<double> chua_params = {15.6, 28.0, -8.0 / 7.0, -5.0 / 7.0};
+            auto chua = [chua_params](const auto* y, auto* dy) {
+                using S = std::decay_t<decltype(y[0])>;
+                const double alpha = chua_params[0], beta = chua_params[1], m0 = chua_params[2], m1 = chua_params[3];
+                const double x = compiled::value(y[0]);
+                const S g = x < -1.0 ? S(m1 * (y[0] + 1.0) - m0) : x > 1.0 ? S(m1 * (y[0] - 1.0) + m0) : S(m0 * y[0]);
+                dy[0] = alpha * (y[1] - y[0] - g);
+                dy[1] = y[0] - y[1] + y[2];
+                dy[2] = -beta * y[1];
+            };
+            auto fixture = load_compiled_kernel(library, chua_params);
+            compiled_ok = fixture->dim() == 3 && fixture->name() == "chua";
+            double compiled_err = 0.0;
+            for (double x : {-2.0, 0.3, 1.7}) {
+                const double y[3] = {x, 0.2, -0.4};
+                double dy[3], dy_ref[3], J[9];
+                fixture->eval(y, dy);
+                chua(y, dy_ref);
+                fixture->jacobian(y, J);
+                for (int i = 0; i < 3; ++i) compiled_err = std::max(compiled_err, std::abs(dy[i] - dy_ref[i]));
+                for (int j = 0; j < 3; ++j) {
+                    HyperDual<1> yd[3] = {y[0], y[1], y[2]}, dyd[3];
+                    yd[j].seed(0, 1.0);
+                    fixture->eval(yd, dyd);
+                    for (int i = 0; i < 3; ++i) compiled_err = std::max(compiled_err, std::abs(dyd[i].top() - J[3 * i + j]));
+                }
+            }
+            const int compiled_id = bridge.load_compiled_kernel(library, chua_params);
+            const int reference_id = bridge.register_kernel(make_rhs_kernel(chua, 3, "chua_reference"));
+            std::vector<double> z_compiled = {0.7, 0.0, 0.0}, z_reference = z_compiled;
+            bridge.dopri5_solve(bridge.create_dopri5(compiled_id, 1e-10, 1e-12), z_compiled, 0.0, 5.0, 0.0);
+            bridge.dopri5_solve(bridge.create_dopri5(reference_id, 1e-10, 1e-12), z_reference, 0.0, 5.0, 0.0);
+            for (int i = 0; i < 3; ++i) compiled_err = std::max(compiled_err, std::abs(z_compiled[i] - z_reference[i]));
+            compiled_ok = compiled_ok && compiled_err < 1e-9;
+            std::cout << "Compiled kernel fixture: max deviation " << compiled_err << ", "
+                      << (expect(compiled_ok) ? "OK" : "MISMATCH") << "\n";
+            std::remove(library.c_str());
+        } else {
+            std::cout << "Compiled kernel fixture: cannot build compiled_rhs_fixture.cpp\n";
+            expect(false);
+        }
+    }
+    
+    // Membrane network: 300 membranes in a binary hierarchy vs an all-pairs reference step
+    const int num_membranes = 300;
+    const int membrane_n = 6;
+    std::vector<int> membrane_labels, membrane_parents, membrane_sizes;
+    for (int m = 0; m < num_membranes; ++m) {
+        membrane_labels.push_back(m + 1);
+        membrane_parents.push_back(m == 0 ? -1 : (m + 1) / 2);
+        membrane_sizes.push_back(membrane_n);
+    }
+    int network_id = bridge.create_membrane_network(membrane_labels, membrane_parents, membrane_sizes, 0.3);
+    std::vector<std::vector<double>> membrane_W(num_membranes), membrane_x(num_membranes);
+    for (int m = 0; m < num_membranes; ++m) {
+        membrane_W[m].assign(membrane_n * membrane_n, 0.0);
+        for (int i = 0; i < membrane_n; ++i) {
+            membrane_W[m][i * membrane_n + (i + m) % membrane_n] = 0.4 * std::sin(i + m);
+            membrane_x[m].push_back(0.1 * std::cos(i * m));
+        }
+        bridge.set_membrane_reservoir(network_id, m + 1, membrane_W[m]);
+        bridge.set_membrane_state(network_id, m + 1, membrane_x[m]);
+    }
+    std::vector<double> membrane_inputs(num_membranes);
+    for (int m = 0; m < num_membranes; ++m) membrane_inputs[m] = 0.01 * m;
+    for (int s = 0; s < 5; ++s) {
+        bridge.membrane_network_step(network_id, membrane_inputs);
+        std::vector<double> means(num_membranes);
+        for (int m = 0; m < num_membranes; ++m) {
+            for (double v : membrane_x[m]) means[m] += v / membrane_n;
+        }
+        for (int m = 0; m < num_membranes; ++m) {
+            double u = membrane_inputs[m];
+            for (int o = 0; o < num_membranes; ++o) {
+                const bool linked = (m > 0 && o == (m + 1) / 2 - 1) || (o > 0 && m == (o + 1) / 2 - 1);
+                if (o != m && linked) u += 0.5 * means[o];
+            }
+            std::vector<double> next(membrane_n);
+            for (int i = 0; i < membrane_n; ++i) {
+                double wx = 0.0;
+                for (int j = 0; j < membrane_n; ++j) wx += membrane_W[m][i * membrane_n + j] * membrane_x[m][j];
+                next[i] = 0.7 * membrane_x[m][i] + 0.3 * std::tanh(wx + u);
+            }
+            membrane_x[m] = next;
+        }
+    }
+    double membrane_err = 0.0;
+    auto membrane_global = bridge.get_membrane_global_state(network_id);
+    for (int m = 0; m < num_membranes; ++m) {
+        for (int i = 0; i < membrane_n; ++i) {
+            membrane_err = std::max(membrane_err, std::abs(membrane_global[m * membrane_n + i] - membrane_x[m][i]));
+        }
+    }
+    std::cout << "Membrane network (" << num_membranes << " membranes, 5 steps): max error vs reference = "
+              << membrane_err << "\n";
+    expect(membrane_err < 1e-12);
+    
+    // Recorded run: history columns land at stride ld, padding rows untouched
+    const int membrane_total = bridge.membrane_total_size(network_id);
+    const int history_ld = membrane_total + 2;
+    std::vector<double> membrane_history(static_cast<size_t>(history_ld) * 3, -7.0);
+    std::vector<double> run_inputs;
+    for (int s = 0; s < 3; ++s) run_inputs.insert(run_inputs.end(), membrane_inputs.begin(), membrane_inputs.end());
+    bridge.membrane_network_run(network_id, run_inputs, 3, membrane_history.data(), history_ld);
+    const double* membrane_view = bridge.membrane_global_state_data(network_id);
+    bool history_ok = std::equal(membrane_view, membrane_view + membrane_total, membrane_history.begin() + 2 * history_ld);
+    for (int s = 0; s < 3; ++s) {
+        history_ok = history_ok && membrane_history[s * history_ld + membrane_total] == -7.0;
+    }
+    std::cout << "Membrane history (3 steps, ld " << history_ld << "): " << (expect(history_ok) ? "OK" : "MISMATCH") << "\n";
+    
+    // Fitness service: genome lengths 1..64, individual 13 spins until its deadline
+    int fitness_id = bridge.register_fitness(make_fitness_kernel(
+        [](const double* g, int n, const EvaluationBudget& budget) {
+            if (n == 13) {
+                while (!budget.expired()) {
+                }
+            }
+            double s = 0.0;
+            for (int k = 0; k < n; ++k) s -= g[k] * g[k];
+            return s;
+        }));
+    int evaluation_id = bridge.create_evaluation_service(fitness_id, 0.02, -1e300);
+    std::vector<double> population_genomes;
+    std::vector<int> population_offsets = {0};
+    for (int i = 0; i < 64; ++i) {
+        for (int k = 0; k <= i; ++k) population_genomes.push_back(0.1);
+        population_offsets.push_back(static_cast<int>(population_genomes.size()));
+    }
+    auto population_fitness = bridge.evaluate_population(evaluation_id, population_genomes, population_offsets);
+    auto evaluation_status = bridge.get_evaluation_status(evaluation_id);
+    bool fitness_ok = true;
+    for (int i = 0; i < 64; ++i) {
+        const double expected = i == 12 ? -1e300 : -0.01 * (i + 1);
+        fitness_ok = fitness_ok && std::abs(population_fitness[i] - expected) < 1e-12 &&
+                     evaluation_status[i] == (i == 12 ? 1 : 0);
+    }
+    auto evaluation_stats = bridge.get_evaluation_stats(evaluation_id);
+    std::cout << "Fitness service: " << evaluation_stats[0] << " evaluated, " << evaluation_stats[1]
+              << " timed out, values " << (expect(fitness_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Fitness cache: the repeat batch hits all but the timed-out genome; a new data version misses
+    int fitness_cache_id = bridge.create_fitness_cache(1024, 8);
+    bridge.attach_fitness_cache(evaluation_id, fitness_cache_id);
+    bridge.evaluate_population(evaluation_id, population_genomes, population_offsets);
+    auto cached_fitness = bridge.evaluate_population(evaluation_id, population_genomes, population_offsets);
+    auto cached_status = bridge.get_evaluation_status(evaluation_id);
+    bool cache_ok = cached_fitness == population_fitness;
+    for (int i = 0; i < 64; ++i) cache_ok = cache_ok && cached_status[i] == (i == 12 ? 1 : 3);
+    bridge.set_fitness_data_version(fitness_cache_id, 1);
+    bridge.evaluate_population(evaluation_id, population_genomes, population_offsets);
+    auto cache_stats = bridge.get_fitness_cache_stats(fitness_cache_id);
+    cache_ok = cache_ok && cache_stats[0] == 63 && cache_stats[1] == 129 && cache_stats[3] == 126;
+    std::cout << "Fitness cache: hit rate " << cache_stats[2] << ", " << cache_stats[3] << " entries, "
+              << (expect(cache_ok) ? "OK" : "MISMATCH") << "\n";
+    bridge.attach_fitness_cache(evaluation_id, -1);
+
+    // A compiled fitness (compiled_objective_fixture.cpp) drives the same service from a library
+    bool compiled_fitness_ok = false;
+    {
+        const std::string library = build_fixture("compiled_objective_fixture");
+        if (!library.empty()) {
+            const int compiled_fitness_id = bridge.load_compiled_fitness(library, {1.0});
+            const int compiled_service_id = bridge.create_evaluation_service(compiled_fitness_id, 0.0, -1e300);
+            auto compiled_fitness = bridge.evaluate_population(compiled_service_id, population_genomes, population_offsets);
+            compiled_fitness_ok = compiled_fitness.size() == 64;
+            for (int i = 0; i < 64 && compiled_fitness_ok; ++i) {
+                compiled_fitness_ok = std::abs(compiled_fitness[i] + 0.01 * (i + 1)) < 1e-12;
+            }
+            try {
+                bridge.load_compiled_fitness(library, {});
+                compiled_fitness_ok = false;
+            } catch (const std::runtime_error&) {
+            }
+            std::remove(library.c_str());
+        }
+    }
+    std::cout << "Compiled fitness: library kernel through the evaluation service "
+              << (expect(compiled_fitness_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Population store: 2000 order-4 genomes, one generation of 4 elites + 1996 offspring
+    int population_id = bridge.create_population(4, 2000);
+    const int population_T = 8;
+    std::vector<double> population_init;
+    for (int i = 0; i < 2000; ++i) {
+        for (int t = 0; t < population_T; ++t) population_init.push_back(1.0 + 0.001 * ((i * 7 + t * 3) % 11));
+    }
+    bridge.population_add(population_id, population_init, 0);
+    std::vector<int> population_elites = {0, 1, 2, 3}, population_a, population_b, population_points;
+    for (int k = 0; k < 1996; ++k) {
+        population_a.push_back(k % 2000);
+        population_b.push_back((k * 13 + 5) % 2000);
+        population_points.push_back(k % 3 == 0 ? 0 : 1 + k % population_T);
+    }
+    bridge.population_next_generation(population_id, population_elites, population_a, population_b,
+                                      population_points, 0.0, 42);
+    auto population_next = bridge.get_population_coefficients(population_id);
+    auto population_parents = bridge.get_population_parents(population_id);
+    bool population_ok = bridge.get_population_ids(population_id)[4] == 2000;
+    for (int k = 0; k < 1996; ++k) {
+        const int point = population_points[k] > 0 ? population_points[k] : population_T;
+        for (int t = 0; t < population_T; ++t) {
+            const int from = t < point ? population_a[k] : population_b[k];
+            population_ok = population_ok && population_next[(4 + k) * population_T + t] == population_init[from * population_T + t];
+        }
+        if (population_points[k] > 0) {
+            population_ok = population_ok && population_parents[2 * (4 + k)] == population_a[k] &&
+                            population_parents[2 * (4 + k) + 1] == population_b[k];
+        }
+    }
+    // A bad crossover point is rejected up front and leaves the population untouched
+    try {
+        bridge.population_next_generation(population_id, {}, {0}, {1}, {population_T + 1}, 0.0, 42);
+        population_ok = false;
+    } catch (const std::runtime_error&) {
+        population_ok = population_ok && bridge.get_population_coefficients(population_id) == population_next;
+    }
+    std::cout << "Population store: crossover and lineage " << (expect(population_ok) ? "OK" : "MISMATCH")
+              << ", diversity " << bridge.population_diversity(population_id) << "\n";
+    
+    // Philox4x32-10 known-answer vector (Random123) and stream/bulk agreement
+    PhiloxBlock philox_kat = philox4x32_10({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+                                           0xa4093822ULL | (0x299f31d0ULL << 32));
+    bool philox_ok = philox_kat == PhiloxBlock{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u};
+    auto bulk_normals = bridge.random_normal(42, 3, 7, 1, 1001);
+    PhiloxStream philox_stream(42, 3, 7, RandomOperator::Mutation);
+    double philox_mean = 0.0;
+    for (double x : bulk_normals) {
+        philox_ok = philox_ok && x == philox_stream.normal();
+        philox_mean += x / bulk_normals.size();
+    }
+    std::cout << "Philox RNG: known answer and bulk == stream " << (expect(philox_ok) ? "OK" : "MISMATCH")
+              << ", normal mean " << philox_mean << "\n";
+    
+    // Tree operators: 2000 offspring from order-6 parents stay canonical and within order 8
+    auto breeding_pool = bridge.enumerate_trees(6);
+    std::vector<int> breed_a, breed_b;
+    for (int k = 0; k < 2000; ++k) {
+        breed_a.push_back(breeding_pool[(k * 7) % breeding_pool.size()]);
+        breed_b.push_back(breeding_pool[(k * 11 + 3) % breeding_pool.size()]);
+    }
+    auto offspring = bridge.breed_trees(breed_a, breed_b, 8, 0.7, 0.5, 2024, 1);
+    bool offspring_ok = offspring == bridge.breed_trees(breed_a, breed_b, 8, 0.7, 0.5, 2024, 1);
+    for (int child : offspring) {
+        auto levels = bridge.tree_level_sequence(child);
+        offspring_ok = offspring_ok && levels.size() <= 8 && bridge.intern_tree(levels) == child;
+    }
+    int grafted = bridge.graft_subtree(bridge.intern_tree({1, 2}), 0, bridge.intern_tree({1, 2}));
+    offspring_ok = offspring_ok && bridge.tree_level_sequence(grafted) == std::vector<int>{1, 2, 3, 2};
+    offspring_ok = offspring_ok && bridge.prune_subtree(grafted, 1) == bridge.intern_tree({1, 2, 3}) &&
+                   bridge.prune_subtree(grafted, 2) == bridge.intern_tree({1, 2});
+    std::cout << "Tree operators: 2000 offspring canonical, bounded and reproducible "
+              << (expect(offspring_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Steady-state evolution: 32 genomes of length 8 climbing -|g - 1|², replace-worst keeps the best
+    int sphere_id = bridge.register_fitness(make_fitness_kernel(
+        [](const double* g, int n, const EvaluationBudget&) {
+            double s = 0.0;
+            for (int k = 0; k < n; ++k) s -= (g[k] - 1.0) * (g[k] - 1.0);
+            return s;
+        }));
+    int steady_id = bridge.create_steady_state(sphere_id, 8, 3, 0.7, 0.9, 0, 3, 0.0, -1e300);
+    auto steady_initial = bridge.steady_state_initialize(steady_id, bridge.random_uniform(11, 0, 0, 5, 32 * 8));
+    const double steady_best0 = *std::max_element(steady_initial.begin(), steady_initial.end());
+    bridge.steady_state_run(steady_id, 4000, 11);
+    auto steady_stats = bridge.get_steady_state_stats(steady_id);
+    auto steady_ids = bridge.get_steady_state_ids(steady_id);
+    std::sort(steady_ids.begin(), steady_ids.end());
+    bool steady_ok = steady_stats[0] == 32 + 4000 && steady_stats[5] >= steady_best0 && steady_stats[1] > 0 &&
+                     std::adjacent_find(steady_ids.begin(), steady_ids.end()) == steady_ids.end() &&
+                     steady_ids.back() < 32 + 4000;
+    std::cout << "Steady-state evolution: best " << steady_best0 << " -> " << steady_stats[5] << " after "
+              << steady_stats[1] << " accepted of 4000, " << (expect(steady_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Compiled operators: the default mutation scales each gene, so an all-zero population
+    // can only leave the origin through the library's additive mutation (fitness +|g|²)
+    bool compiled_operators_ok = false;
+    {
+        const std::string library = build_fixture("compiled_objective_fixture");
+        if (!library.empty()) {
+            const int norm_id = bridge.load_compiled_fitness(library, {-1.0});
+            const int operators_id = bridge.load_compiled_operators(library, {0.5}, 3);
+            const int default_id = bridge.create_steady_state(norm_id, 4, 3, 0.0, 1.0, 0, 3, 0.0, -1e300);
+            const int custom_id =
+                bridge.create_steady_state_with_operators(norm_id, operators_id, 4, 0.5, 1.0, 0, 3, 0.0, -1e300);
+            const std::vector<double> origin(16 * 4, 0.0);
+            bridge.steady_state_initialize(default_id, origin);
+            bridge.steady_state_initialize(custom_id, origin);
+            bridge.steady_state_run(default_id, 500, 5);
+            bridge.steady_state_run(custom_id, 500, 5);
+            compiled_operators_ok = bridge.get_steady_state_stats(default_id)[5] == 0.0 &&
+                                    bridge.get_steady_state_stats(custom_id)[5] > 1.0;
+            try {
+                bridge.create_steady_state_with_operators(norm_id, -1, 4, 0.5, 1.0, 0, 3, 0.0, -1e300);
+                compiled_operators_ok = false;
+            } catch (const std::runtime_error&) {
+            }
+            try {
+                bridge.load_compiled_operators(library, {}, 3);
+                compiled_operators_ok = false;
+            } catch (const std::runtime_error&) {
+            }
+            std::remove(library.c_str());
+        }
+    }
+    std::cout << "Compiled operators: library crossover and mutation in the steady-state engine "
+              << (expect(compiled_operators_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Island model: ring of 3 with capacity 2 (third migrant dropped); workers see their index
+    const std::string island_name = "/dte-islands-test-" + std::to_string(::getpid());
+    int island_model = bridge.create_island_model(island_name, 3, 4, 2, 0, 5);
+    int island0 = bridge.attach_island(island_name, 0);
+    int island1 = bridge.attach_island(island_name, 1);
+    std::vector<double> island_genomes = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    int island_sent = bridge.island_emigrate(island0, island_genomes, {0.5, 0.25, 0.125}, {10, 11, 12}, 5);
+    auto island_rows = bridge.island_immigrate(island1);
+    bridge.island_report(island1, 5, 0.5);
+    auto island_status = bridge.get_island_status(island_model);
+    bridge.launch_islands(island_model, {"sh", "-c", "exit $DTE_ISLAND_INDEX"});
+    auto island_codes = bridge.wait_islands(island_model);
+    bool island_ok = island_sent == 2 && island_rows.size() == 16 &&
+                     std::vector<double>(island_rows.begin(), island_rows.begin() + 8) ==
+                         std::vector<double>{0, 10, 5, 0.5, 1, 2, 3, 4} &&
+                     island_rows[9] == 11 && island_rows[15] == 8 && bridge.island_immigrate(island1).empty() &&
+                     island_status[4] == 1 && island_status[5] == 5 && island_status[8] == 2 &&
+                     bridge.island_should_migrate(island0, 10) && !bridge.island_should_migrate(island0, 7) &&
+                     island_codes == std::vector<int>{0, 1, 2};
+    std::cout << "Island model: shared-memory ring migration and worker launch "
+              << (expect(island_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Pareto selection: ENS-BS ranks vs O(M·N²) peeling for 2 and 3 objectives, NSGA-II/III keep whole fronts
+    bool pareto_ok = bridge.reference_points(3, 4).size() == 15 * 3;
+    for (int pareto_M : {2, 3}) {
+        const int pareto_n = 600;
+        auto F = bridge.random_uniform(5, pareto_M, 0, 5, pareto_M * pareto_n);
+        for (auto& v : F) v = std::round(v * 20.0);  // ties and duplicates
+        auto ranks = bridge.pareto_ranks(F, pareto_M);
+        std::vector<int> reference(pareto_n, -1);
+        for (int front = 0, left = pareto_n; left > 0; ++front) {
+            std::vector<int> current;
+            for (int p = 0; p < pareto_n; ++p) {
+                if (reference[p] >= 0) continue;
+                bool dominated = false;
+                for (int q = 0; q < pareto_n && !dominated; ++q) {
+                    if (q == p || (reference[q] >= 0 && reference[q] < front)) continue;
+                    bool ge = true, gt = false;
+                    for (int m = 0; m < pareto_M; ++m) {
+                        ge = ge && F[m * pareto_n + q] >= F[m * pareto_n + p];
+                        gt = gt || F[m * pareto_n + q] > F[m * pareto_n + p];
+                    }
+                    dominated = ge && gt && reference[q] < 0;
+                }
+                if (!dominated) current.push_back(p);
+            }
+            for (int p : current) reference[p] = front;
+            left -= static_cast<int>(current.size());
+        }
+        pareto_ok = pareto_ok && ranks == reference;
+        for (auto selected : {bridge.nsga2_select(F, pareto_M, 150), bridge.nsga3_select(F, pareto_M, 150, 6, 9, 0)}) {
+            std::vector<int> sorted_sel(selected);
+            std::sort(sorted_sel.begin(), sorted_sel.end());
+            int worst = 0;
+            for (int i : selected) worst = std::max(worst, ranks[i]);
+            int better = 0;
+            for (int r : ranks) better += r < worst;
+            int kept_better = 0;
+            for (int i : selected) kept_better += ranks[i] < worst;
+            pareto_ok = pareto_ok && selected.size() == 150 && kept_better == better &&
+                        std::adjacent_find(sorted_sel.begin(), sorted_sel.end()) == sorted_sel.end();
+        }
+    }
+    std::cout << "Pareto selection: ranks match brute force, NSGA-II/III keep whole fronts "
+              << (expect(pareto_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Garden table: 20000 trees on 7 membranes, 3 generations, prune at the median; index == rebuild
+    int garden_id = bridge.create_garden_table();
+    auto garden_pool = bridge.enumerate_trees(6);
+    std::vector<int> garden_trees, garden_membranes;
+    for (int k = 0; k < 20000; ++k) {
+        garden_trees.push_back(garden_pool[(k * 13) % garden_pool.size()]);
+        garden_membranes.push_back(1 + k % 7);
+    }
+    bridge.garden_plant(garden_id, garden_trees, garden_membranes);
+    int garden_planted = bridge.garden_grow(garden_id, 3, 0.3, 0.9, 0.5, 8, {0.6, 0.8, 0.1, 0.2}, 17);
+    auto garden_fitness = bridge.get_garden_fitness(garden_id);
+    std::vector<double> garden_sorted(garden_fitness);
+    std::sort(garden_sorted.begin(), garden_sorted.end());
+    const double garden_h = (garden_sorted.size() - 1) * 0.3;
+    const size_t garden_lo = static_cast<size_t>(garden_h);
+    const double garden_q = garden_sorted[garden_lo] + (garden_h - garden_lo) *
+                            (garden_sorted[garden_lo + 1] - garden_sorted[garden_lo]);
+    bool garden_ok = garden_planted > 0 && std::abs(bridge.garden_quantile(garden_id, 0.3) - garden_q) < 1e-15;
+    const double garden_median = bridge.garden_quantile(garden_id, 0.5);
+    int garden_pruned = bridge.garden_prune(garden_id, garden_median);
+    auto garden_after = bridge.get_garden_fitness(garden_id);
+    auto garden_after_membranes = bridge.get_garden_membranes(garden_id);
+    garden_ok = garden_ok && garden_pruned > 0 && garden_pruned + static_cast<int>(garden_after.size()) ==
+                static_cast<int>(garden_fitness.size());
+    for (double f : garden_after) garden_ok = garden_ok && f >= garden_median;
+    for (int m = 1; m <= 7; ++m) {
+        std::vector<int> rebuilt;
+        for (int r = 0; r < static_cast<int>(garden_after_membranes.size()); ++r) {
+            if (garden_after_membranes[r] == m) rebuilt.push_back(r);
+        }
+        garden_ok = garden_ok && bridge.get_garden_membrane_rows(garden_id, m) == rebuilt;
+    }
+    std::cout << "Garden table: " << garden_planted << " planted, " << garden_pruned << " pruned, index "
+              << (expect(garden_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Membrane-partitioned growth does not depend on the worker count: 1 and 4 workers agree.
+    // Tree ids are per-arena, so rows are compared by level sequence
+    std::vector<std::vector<std::vector<int>>> partitioned_trees;
+    std::vector<std::vector<int>> partitioned_membranes;
+    std::vector<std::vector<double>> partitioned_fitness;
+    std::vector<int> partitioned_counts;
+    for (int workers : {1, 4}) {
+        TaskflowBridge partitioned_bridge(workers);
+        std::vector<int> planted_trees;
+        for (int tree : garden_trees) {
+            planted_trees.push_back(partitioned_bridge.intern_tree(bridge.tree_level_sequence(tree)));
+        }
+        int pid = partitioned_bridge.create_garden_table();
+        partitioned_bridge.garden_plant(pid, planted_trees, garden_membranes);
+        partitioned_counts.push_back(
+            partitioned_bridge.garden_grow_membranes(pid, 3, 0.3, 0.9, 0.5, 8, {0.6, 0.8, 0.1, 0.2}, 23));
+        partitioned_counts.push_back(partitioned_bridge.garden_exchange(pid, {}, 2, 8, 23));
+        partitioned_trees.emplace_back();
+        for (int tree : partitioned_bridge.get_garden_trees(pid)) {
+            partitioned_trees.back().push_back(partitioned_bridge.tree_level_sequence(tree));
+        }
+        partitioned_membranes.push_back(partitioned_bridge.get_garden_membranes(pid));
+        partitioned_fitness.push_back(partitioned_bridge.get_garden_fitness(pid));
+    }
+    const bool partitioned_ok = partitioned_counts[0] == partitioned_counts[2] &&
+                                partitioned_counts[1] == partitioned_counts[3] &&
+                                partitioned_trees[0] == partitioned_trees[1] &&
+                                partitioned_membranes[0] == partitioned_membranes[1] &&
+                                partitioned_fitness[0] == partitioned_fitness[1];
+    std::cout << "Partitioned garden: " << partitioned_counts[0] << " planted, " << partitioned_counts[1]
+              << " hybrids, 1 vs 4 workers " << (expect(partitioned_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Lineage: a chain 0 → 1 → ... → 9 plus an extinct side branch 3 → 100 → 101
+    int lineage_id = bridge.create_lineage_log();
+    bridge.lineage_record(lineage_id, {0}, {-1}, {-1}, 0, 0);
+    for (int64_t k = 1; k < 10; ++k) bridge.lineage_record(lineage_id, {k}, {k - 1}, {-1}, 1, static_cast<int>(k));
+    bridge.lineage_record(lineage_id, {100, 101}, {3, 100}, {5, -1}, 2, 6);
+    bool lineage_ok = bridge.lineage_ancestors(lineage_id, 101, -1) == std::vector<int64_t>{100, 3, 5, 2, 4, 1, 0};
+    lineage_ok = lineage_ok && bridge.lineage_ancestors(lineage_id, 9, 2) == std::vector<int64_t>{8, 7};
+    lineage_ok = lineage_ok && bridge.lineage_descendants(lineage_id, 5, -1) == std::vector<int64_t>{100, 6, 101, 7, 8, 9};
+    const int lineage_pruned = bridge.lineage_prune(lineage_id, {9}, 0);
+    lineage_ok = lineage_ok && lineage_pruned == 2 && bridge.lineage_descendants(lineage_id, 3, -1).size() == 6;
+    std::cout << "Lineage log: " << lineage_pruned << " extinct entries pruned, queries "
+              << (expect(lineage_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Checkpoint round trip into a fresh bridge
+    const std::string checkpoint_path = "/tmp/dte_bridge_test_" + std::to_string(::getpid()) + ".ckpt";
+    const int64_t checkpoint_bytes = bridge.save_checkpoint(checkpoint_path);
+    bool checkpoint_ok;
+    {
+        TaskflowBridge restored(2);
+        const int restored_objects = restored.load_checkpoint(checkpoint_path, true);
+        checkpoint_ok = restored_objects >= 5 &&
+            restored.get_population_coefficients(population_id) == bridge.get_population_coefficients(population_id) &&
+            restored.get_population_ids(population_id) == bridge.get_population_ids(population_id) &&
+            restored.get_garden_trees(garden_id) == bridge.get_garden_trees(garden_id) &&
+            restored.get_garden_membrane_rows(garden_id, 3) == bridge.get_garden_membrane_rows(garden_id, 3) &&
+            restored.lineage_ancestors(lineage_id, 9, -1) == bridge.lineage_ancestors(lineage_id, 9, -1) &&
+            restored.get_membrane_global_state(network_id) == bridge.get_membrane_global_state(network_id) &&
+            restored.get_surface_coefficients(surface_id) == bridge.get_surface_coefficients(surface_id) &&
+            restored.get_surface_history(surface_id, 1) == bridge.get_surface_history(surface_id, 1) &&
+            restored.create_garden_table() > garden_id;
+    }
+    std::remove(checkpoint_path.c_str());
+    std::cout << "Checkpoint: " << checkpoint_bytes << " bytes, restore " << (expect(checkpoint_ok) ? "OK" : "MISMATCH") << "\n";
+
+    // Delta chain: base, two small deltas, then a background compaction
+    const std::string chain_path = "/tmp/dte_bridge_chain_" + std::to_string(::getpid()) + ".ckpt";
+    int chain_id = bridge.create_checkpoint_chain(chain_path, 4096, 0);
+    const int64_t chain_base = bridge.checkpoint_chain_base(chain_id);
+    bridge.garden_grow(garden_id, 1, 0.3, 0.9, 0.5, 8, {0.6, 0.8, 0.1, 0.2}, 29);
+    const int64_t chain_delta = bridge.checkpoint_chain_delta(chain_id);
+    bridge.surface_gradient_step(surface_id, std::vector<double>(surface_n, 0.1), 0.5);
+    bridge.checkpoint_chain_delta(chain_id);
+    auto chain_matches = [&] {
+        TaskflowBridge restored(2);
+        restored.load_checkpoint(chain_path, true);
+        return restored.get_garden_trees(garden_id) == bridge.get_garden_trees(garden_id) &&
+               restored.get_garden_fitness(garden_id) == bridge.get_garden_fitness(garden_id) &&
+               restored.get_surface_coefficients(surface_id) == bridge.get_surface_coefficients(surface_id) &&
+               restored.get_population_coefficients(population_id) == bridge.get_population_coefficients(population_id);
+    };
+    bool chain_ok = chain_delta < chain_base && chain_matches();
+    bridge.compact_checkpoint_chain(chain_id, true);
+    chain_ok = chain_ok && bridge.get_checkpoint_chain_stats(chain_id)[4] == 1.0 &&
+               std::remove(DeltaCheckpointer::delta_path(chain_path, 1).c_str()) != 0 && chain_matches();
+    // A new base removes the deltas written after the compaction
+    bridge.checkpoint_chain_delta(chain_id);
+    bridge.checkpoint_chain_delta(chain_id);
+    bridge.checkpoint_chain_base(chain_id);
+    for (std::uint64_t n = 1; n <= 4; ++n) {
+        chain_ok = chain_ok && std::remove(DeltaCheckpointer::delta_path(chain_path, n).c_str()) != 0;
+    }
+    chain_ok = chain_ok && chain_matches();
+    // Loads that overlap a background compaction still see the latest state
+    for (int round = 0; round < 4; ++round) {
+        bridge.surface_gradient_step(surface_id, std::vector<double>(surface_n, 0.1), 0.5);
+        bridge.checkpoint_chain_delta(chain_id);
+        bridge.compact_checkpoint_chain(chain_id, false);
+        chain_ok = chain_ok && chain_matches();
+        bridge.compact_checkpoint_chain(chain_id, true);
+    }
+    for (std::uint64_t n = 1; n <= 4; ++n) std::remove(DeltaCheckpointer::delta_path(chain_path, n).c_str());
+    std::remove(chain_path.c_str());
+    std::cout << "Delta checkpoints: base " << chain_base << " bytes, delta " << chain_delta << " bytes, replay "
+              << (expect(chain_ok) ? "OK" : "MISMATCH") << "\n";
+
     // Statistics
     std::cout << "\n=== Statistics ===\n";
     std::cout << "Taskflows: " << bridge.num_taskflows() << "\n";
     std::cout << "AtomSpaces: " << bridge.num_atomspaces() << "\n";
     std::cout << "Tensors: " << bridge.num_tensors() << "\n";
     
+    if (failures > 0) {
+        std::cout << "\n=== " << failures << " check(s) FAILED ===\n";
+        return 1;
+    }
     std::cout << "\n=== Test Complete ===\n";
     
     return 0;
@@ -0,0 +1,274 @@
+/**
+ * tree_arena.hpp
+ *
+ * Interned rooted trees (OEIS A000081) for the native bridge.
+ *
+ * Every distinct rooted tree is stored exactly once and identified by a dense
+ * TreeId. A tree is the multiset of its root's child subtrees, so two trees
+ * that share a subtree share its id; this is what lets elementary
+ * differentials, elementary weights and genetic operators reuse work across
+ * trees. Level sequences use the Julia convention (root at level 1) and are
+ * emitted in canonical form (child subtrees in non-increasing lexicographic
+ * order, as RootedTrees.jl does).
+ */
+
+#pragma once
+
+#include "checkpoint.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace taskflow_bridge {
+
+using TreeId = std::int32_t;
+
+/**
+ * TreeArena
+ *
+ * Append-only store of interned rooted trees. Children of every tree are kept
+ * sorted by id in one packed array, addressed by per-tree offsets.
+ */
+class TreeArena {
+public:
+    TreeArena() {
+        // The single-node tree is always id 0
+        intern({});
+    }
+
+    // Interning
+
+    TreeId intern(std::vector<TreeId> children) {
+        std::sort(children.begin(), children.end());
+        auto it = index_.find(children);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        return insert_sorted(std::move(children));
+    }
+
+    // Sorts the caller's buffer in place and copies it only for a new tree,
+    // so looking up known trees through a reused buffer allocates nothing
+    TreeId intern_in_place(std::vector<TreeId>& children) {
+        std::sort(children.begin(), children.end());
+        auto it = index_.find(children);
+        if (it != index_.end()) {
+            return it->second;
+        }
+        return insert_sorted(children);
+    }
+
+    TreeId intern_level_sequence(const std::vector<int>& levels) {
+        if (levels.empty()) {
+            throw std::runtime_error("Empty level sequence");
+        }
+        std::size_t pos = 0;
+        TreeId id = parse_subtree(levels, pos);
+        if (pos != levels.size()) {
+            throw std::runtime_error("Level sequence describes a forest, not a rooted tree");
+        }
+        return id;
+    }
+
+    // Enumeration
+
+    /**
+     * Intern every rooted tree of order <= max_order and return their ids
+     * sorted by order. Children always precede their parents in the result.
+     */
+    std::vector<TreeId> enumerate_up_to(int max_order) {
+        if (max_order < 1) {
+            return {};
+        }
+        while (static_cast<int>(by_order_.size()) < max_order) {
+            const int n = static_cast<int>(by_order_.size()) + 1;
+            std::vector<TreeId> trees;
+            if (n == 1) {
+                trees.push_back(0);
+            } else {
+                std::vector<TreeId> smaller;
+                for (const auto& level : by_order_) {
+                    smaller.insert(smaller.end(), level.begin(), level.end());
+                }
+                std::vector<TreeId> forest;
+                enumerate_forests(smaller, n - 1, smaller.size(), forest, trees);
+            }
+            by_order_.push_back(std::move(trees));
+        }
+
+        std::vector<TreeId> result;
+        for (int n = 1; n <= max_order; ++n) {
+            const auto& level = by_order_[n - 1];
+            result.insert(result.end(), level.begin(), level.end());
+        }
+        return result;
+    }
+
+    // Accessors
+
+    std::size_t size() const { return order_.size(); }
+
+    int order(TreeId id) const { return order_.at(id); }
+
+    // σ(τ): number of automorphisms
+    double symmetry(TreeId id) const { return symmetry_.at(id); }
+
+    // γ(τ): tree factorial (density)
+    double density(TreeId id) const { return density_.at(id); }
+
+    std::size_t num_children(TreeId id) const {
+        return child_end(id) - child_offset_.at(id);
+    }
+
+    const TreeId* children_begin(TreeId id) const {
+        return child_ids_.data() + child_offset_.at(id);
+    }
+
+    const TreeId* children_end(TreeId id) const {
+        return child_ids_.data() + child_end(id);
+    }
+
+    std::vector<TreeId> children(TreeId id) const {
+        return std::vector<TreeId>(children_begin(id), children_end(id));
+    }
+
+    std::vector<int> level_sequence(TreeId id) const {
+        std::vector<int> levels;
+        levels.reserve(order(id));
+        append_levels(id, 1, levels);
+        return levels;
+    }
+
+    // Checkpoints
+
+    void save(CheckpointWriter& writer, const std::string& prefix) const {
+        writer.add(prefix + "offsets", child_offset_);
+        writer.add(prefix + "children", child_ids_);
+    }
+
+    /**
+     * Re-intern the saved trees in id order. The live arena must already
+     * hold a prefix of them (a fresh arena always does), so every saved
+     * TreeId keeps its meaning.
+     */
+    void restore(const CheckpointReader& reader, const std::string& prefix) {
+        const auto offsets = reader.column<std::uint32_t>(prefix + "offsets");
+        const auto children = reader.column<TreeId>(prefix + "children");
+        std::vector<TreeId> buffer;
+        for (std::size_t id = 0; id < offsets.size; ++id) {
+            const std::size_t end = id + 1 < offsets.size ? offsets[id + 1] : children.size;
+            if (offsets[id] > end || end > children.size) {
+                throw std::runtime_error("Corrupt tree arena checkpoint");
+            }
+            buffer.assign(children.begin() + offsets[id], children.begin() + end);
+            if (intern_in_place(buffer) != static_cast<TreeId>(id)) {
+                throw std::runtime_error("Checkpoint arena does not match the live arena at tree " + std::to_string(id));
+            }
+        }
+    }
+
+private:
+    TreeId insert_sorted(std::vector<TreeId> children) {
+        int order = 1;
+        double symmetry = 1.0;
+        double density = 1.0;
+        for (std::size_t i = 0; i < children.size(); ) {
+            TreeId c = children[i];
+            if (c < 0 || c >= static_cast<TreeId>(size())) {
+                throw std::runtime_error("Invalid child tree id: " + std::to_string(c));
+            }
+            std::size_t j = i;
+            while (j < children.size() && children[j] == c) ++j;
+            const std::size_t multiplicity = j - i;
+            for (std::size_t k = 1; k <= multiplicity; ++k) {
+                symmetry *= symmetry_[c] * static_cast<double>(k);
+            }
+            order += static_cast<int>(multiplicity) * order_[c];
+            for (std::size_t k = 0; k < multiplicity; ++k) density *= density_[c];
+            i = j;
+        }
+        density *= order;
+
+        TreeId id = static_cast<TreeId>(size());
+        child_offset_.push_back(static_cast<std::uint32_t>(child_ids_.size()));
+        child_ids_.insert(child_ids_.end(), children.begin(), children.end());
+        order_.push_back(order);
+        symmetry_.push_back(symmetry);
+        density_.push_back(density);
+        index_.emplace(std::move(children), id);
+        return id;
+    }
+
+    TreeId parse_subtree(const std::vector<int>& levels, std::size_t& pos) {
+        const int root_level = levels[pos++];
+        std::vector<TreeId> children;
+        while (pos < levels.size() && levels[pos] > root_level) {
+            if (levels[pos] != root_level + 1) {
+                throw std::runtime_error("Invalid level sequence: level jumps by more than one");
+            }
+            children.push_back(parse_subtree(levels, pos));
+        }
+        return intern(std::move(children));
+    }
+
+    // Multisets of trees (indices into `pool` in non-increasing order) with
+    // total order `remaining`; each one becomes the children of a new root
+    void enumerate_forests(const std::vector<TreeId>& pool, int remaining,
+                           std::size_t max_index, std::vector<TreeId>& forest,
+                           std::vector<TreeId>& out) {
+        if (remaining == 0) {
+            out.push_back(intern(forest));
+            return;
+        }
+        for (std::size_t i = max_index; i-- > 0; ) {
+            const int o = order_[pool[i]];
+            if (o > remaining) continue;
+            forest.push_back(pool[i]);
+            enumerate_forests(pool, remaining - o, i + 1, forest, out);
+            forest.pop_back();
+        }
+    }
+
+    void append_levels(TreeId id, int level, std::vector<int>& out) const {
+        out.push_back(level);
+        std::vector<std::vector<int>> subtrees;
+        for (const TreeId* c = children_begin(id); c != children_end(id); ++c) {
+            subtrees.push_back(level_sequence(*c));
+        }
+        std::sort(subtrees.begin(), subtrees.end(), std::greater<std::vector<int>>());
+        for (const auto& sub : subtrees) {
+            for (int l : sub) out.push_back(l + level);
+        }
+    }
+
+    std::size_t child_end(TreeId id) const {
+        return static_cast<std::size_t>(id) + 1 < child_offset_.size()
+            ? child_offset_[id + 1]
+            : child_ids_.size();
+    }
+
+    struct ChildrenHash {
+        std::size_t operator()(const std::vector<TreeId>& v) const {
+            std::size_t h = 1469598103934665603ull;
+            for (TreeId x : v) {
+                h ^= static_cast<std::size_t>(x) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+    };
+
+    std::vector<std::uint32_t> child_offset_;
+    std::vector<TreeId> child_ids_;
+    std::vector<int> order_;
+    std::vector<double> symmetry_;
+    std::vector<double> density_;
+    std::vector<std::vector<TreeId>> by_order_;
+    std::unordered_map<std::vector<TreeId>, TreeId, ChildrenHash> index_;
+};
+
+} // namespace taskflow_bridge
@@ -0,0 +1,211 @@
+/**
+ * tree_operators.hpp
+ *
+ * Genetic operators on interned rooted trees.
+ *
+ * Operators act on TreeIds: a subtree is replaced, removed or grafted by
+ * rebuilding only the path from the root to the edit point and interning
+ * each rebuilt node. The output is therefore always a valid tree in
+ * canonical form; no level sequence is produced and patched afterwards.
+ * Path rebuilding uses per-depth child buffers owned by the operator object.
+ * Once they have grown, producing a tree the arena already knows allocates
+ * nothing.
+ *
+ * Nodes are addressed by preorder index (root = 0), visiting children in
+ * arena order. A subtree at node k spans nodes k .. k + |subtree| - 1.
+ *
+ * TreeArena is not synchronised, so batches run as one tight loop on the
+ * calling thread. Randomness comes from Philox streams keyed by
+ * (seed, generation, pair index, operator), so a batch is reproducible and
+ * independent of how pairs were scheduled.
+ */
+
+#pragma once
+
+#include "philox.hpp"
+#include "tree_arena.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace taskflow_bridge {
+
+struct BreedingParams {
+    int max_order = 20;
+    double crossover_rate = 0.7;
+    double mutation_rate = 0.1;
+    std::uint64_t seed = 0;
+    std::uint32_t generation = 0;
+};
+
+/**
+ * TreeOperators
+ */
+class TreeOperators {
+public:
+    explicit TreeOperators(TreeArena& arena) : arena_(arena) {}
+
+    TreeId subtree_at(TreeId t, int node) const {
+        check_node(t, node);
+        while (node > 0) {
+            --node;
+            for (const TreeId* c = arena_.children_begin(t); c != arena_.children_end(t); ++c) {
+                const int o = arena_.order(*c);
+                if (node < o) {
+                    t = *c;
+                    break;
+                }
+                node -= o;
+            }
+        }
+        return t;
+    }
+
+    // Subtree at node replaced by `replacement` (node 0 returns replacement)
+    TreeId replace(TreeId t, int node, TreeId replacement) {
+        check_node(t, node);
+        check_tree(replacement);
+        reserve_depth(arena_.order(t));
+        return rebuild(t, node, replacement, 0);
+    }
+
+    // Subtree at a non-root node removed
+    TreeId prune(TreeId t, int node) {
+        check_node(t, node);
+        if (node == 0) {
+            throw std::runtime_error("Cannot prune the root");
+        }
+        reserve_depth(arena_.order(t));
+        return rebuild(t, node, kRemove, 0);
+    }
+
+    // `subtree` attached as a new child of node
+    TreeId graft(TreeId t, int node, TreeId subtree) {
+        check_node(t, node);
+        check_tree(subtree);
+        reserve_depth(arena_.order(t) + 1);
+        graft_subtree_ = subtree;
+        return rebuild(t, node, kGraft, 0);
+    }
+
+    /**
+     * Subtree swap: a random non-root subtree of a (or a new child of a's
+     * root if a is a single node) is replaced by a random subtree of b. If
+     * the child would exceed max_order, the donor subtree shrinks to a
+     * random child until it fits.
+     */
+    TreeId crossover(TreeId a, TreeId b, int max_order, PhiloxStream& rng) {
+        const int na = arena_.order(a);
+        if (na == 1 && max_order < 2) return a;
+        const int node = na > 1 ? 1 + static_cast<int>(rng.below(na - 1)) : 0;
+        const int kept = na > 1 ? na - arena_.order(subtree_at(a, node)) : na;
+
+        TreeId donor = subtree_at(b, static_cast<int>(rng.below(arena_.order(b))));
+        while (kept + arena_.order(donor) > max_order) {
+            const int degree = static_cast<int>(arena_.num_children(donor));
+            if (degree == 0) break;
+            donor = arena_.children_begin(donor)[rng.below(degree)];
+        }
+        return na > 1 ? replace(a, node, donor) : graft(a, 0, donor);
+    }
+
+    /**
+     * With probability rate, one of: remove a random non-root subtree, graft
+     * a leaf at a random node (if below max_order), or move a random
+     * non-root subtree under a random node of the remainder. Otherwise t.
+     */
+    TreeId mutate(TreeId t, double rate, int max_order, PhiloxStream& rng) {
+        if (!(rng.uniform() < rate)) return t;
+        const int n = arena_.order(t);
+        switch (rng.below(3)) {
+            case 0:
+                if (n > 1) return prune(t, 1 + static_cast<int>(rng.below(n - 1)));
+                return t;
+            case 1:
+                if (n < max_order) return graft(t, static_cast<int>(rng.below(n)), kLeaf);
+                return t;
+            default: {
+                if (n < 3) return t;
+                const int node = 1 + static_cast<int>(rng.below(n - 1));
+                const TreeId moved = subtree_at(t, node);
+                const TreeId rest = prune(t, node);
+                return graft(rest, static_cast<int>(rng.below(arena_.order(rest))), moved);
+            }
+        }
+    }
+
+    /**
+     * Offspring k: crossover of (a[k], b[k]) with probability crossover_rate
+     * (else a copy of a[k]), then mutation. Pair k draws from the streams
+     * (seed, generation, k, Crossover) and (seed, generation, k, Mutation).
+     */
+    void breed(const TreeId* a, const TreeId* b, int num_pairs, const BreedingParams& params, TreeId* out) {
+        for (int k = 0; k < num_pairs; ++k) {
+            check_tree(a[k]);
+            check_tree(b[k]);
+            PhiloxStream cross(params.seed, params.generation, static_cast<std::uint32_t>(k), RandomOperator::Crossover);
+            TreeId child = cross.uniform() < params.crossover_rate
+                ? crossover(a[k], b[k], params.max_order, cross)
+                : a[k];
+            PhiloxStream mut(params.seed, params.generation, static_cast<std::uint32_t>(k), RandomOperator::Mutation);
+            out[k] = mutate(child, params.mutation_rate, params.max_order, mut);
+        }
+    }
+
+private:
+    static constexpr TreeId kLeaf = 0;
+    static constexpr TreeId kRemove = -1;
+    static constexpr TreeId kGraft = -2;
+
+    void check_tree(TreeId t) const {
+        if (t < 0 || t >= static_cast<TreeId>(arena_.size())) {
+            throw std::runtime_error("Invalid tree id: " + std::to_string(t));
+        }
+    }
+
+    void check_node(TreeId t, int node) const {
+        check_tree(t);
+        if (node < 0 || node >= arena_.order(t)) {
+            throw std::runtime_error("Node " + std::to_string(node) + " out of range for tree " + std::to_string(t));
+        }
+    }
+
+    // Paths are at most one node per level of the tree
+    void reserve_depth(int depth) {
+        if (static_cast<int>(scratch_.size()) < depth + 1) scratch_.resize(depth + 1);
+    }
+
+    TreeId rebuild(TreeId t, int node, TreeId replacement, int depth) {
+        if (node == 0 && replacement != kGraft) return replacement;
+
+        std::vector<TreeId>& children = scratch_[depth];
+        children.assign(arena_.children_begin(t), arena_.children_end(t));
+        if (node == 0) {
+            children.push_back(graft_subtree_);
+        } else {
+            int k = node - 1;
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                const int o = arena_.order(children[i]);
+                if (k < o) {
+                    const TreeId r = rebuild(children[i], k, replacement, depth + 1);
+                    if (r == kRemove) {
+                        children.erase(children.begin() + i);
+                    } else {
+                        children[i] = r;
+                    }
+                    break;
+                }
+                k -= o;
+            }
+        }
+        return arena_.intern_in_place(children);
+    }
+
+    TreeArena& arena_;
+    std::vector<std::vector<TreeId>> scratch_;
+    TreeId graft_subtree_ = kLeaf;
+};
+
+} // namespace taskflow_bridge
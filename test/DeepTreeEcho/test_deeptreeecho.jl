@@ -103,10 +103,36 @@ Random.seed!(42)
         inputs = Dict(1 => [0.5])
         step!(network, inputs)
         
+        # Membrane states are slices of one contiguous buffer, in ascending ID order
+        @test network.order == sort(collect(keys(network.membranes)))
+        @test membrane_network_size(network) == sum(length(m.state) for m in values(network.membranes))
+        @test all(parent(m.state) === network.global_state for m in values(network.membranes))
+        concatenated = reduce(vcat, [Vector(network.membranes[id].state) for id in network.order])
+        @test extract_global_state(network) == concatenated
+        
+        # In-place extraction into a history column, without allocating
+        history = zeros(membrane_network_size(network), 3)
+        extract_global_state!(view(history, :, 2), network)
+        @test history[:, 2] == concatenated
+        buffer = similar(concatenated)
+        extract_global_state!(buffer, network)
+        @test (@allocated extract_global_state!(buffer, network)) == 0
+        @test_throws DimensionMismatch extract_global_state!(zeros(length(buffer) + 1), network)
+        
         # Test topology adaptation
         metrics = Dict(id => 0.5 for id in keys(network.membranes))
         adapt_topology!(network, metrics)
         @test network.generation == 1
+        
+        # Dissolving a membrane rebuilds the order and buffer and keeps surviving states
+        survivors = Dict(id => Vector(m.state) for (id, m) in network.membranes)
+        dissolved = last(network.order)
+        delete!(survivors, dissolved)
+        adapt_topology!(network, Dict(dissolved => 0.1))
+        @test network.order == sort(collect(keys(survivors)))
+        @test membrane_network_size(network) == sum(length(v) for v in values(survivors))
+        @test all(Vector(network.membranes[id].state) == v for (id, v) in survivors)
+        @test all(parent(m.state) === network.global_state for m in values(network.membranes))
     end
     
     @testset "DeepTreeEchoReservoir" begin
@@ -131,6 +157,21 @@ Random.seed!(42)
         clone = clone_reservoir(reservoir)
         @test clone.id != reservoir.id
         @test clone.order == reservoir.order
+        
+        # train_reservoir! and predict match stepping the network by hand
+        inputs = reshape(sin.(0.3 .* (1:20)), 1, :)
+        reference = deepcopy(reservoir.membrane_network)
+        expected = Float64[]
+        for t in 1:size(inputs, 2)
+            step!(reference, Dict(1 => [inputs[1, t]]))
+            state = reduce(vcat, [Vector(reference.membranes[id].state)
+                                  for id in sort(collect(keys(reference.membranes)))])
+            push!(expected, sum(state) / length(state))
+        end
+        trained = deepcopy(reservoir)
+        train_reservoir!(trained, inputs, inputs)
+        @test trained.membrane_network.global_state == reference.global_state
+        @test predict(deepcopy(reservoir), inputs) ≈ expected
     end
     
     @testset "FitnessEvaluation" begin
@@ -7,6 +7,9 @@ using OrdinaryDiffEq
 using OrdinaryDiffEq: ReturnCode.Success
 using IfElse: ifelse
 
+include(joinpath(@__DIR__, "..", "src", "DeepTreeEcho", "NativeRHSExport.jl"))
+include(joinpath(@__DIR__, "..", "scripts", "generate_compiled_rhs_fixture.jl"))
+
 @testset "Chua Circuit" begin
     @component function NonlinearResistor(; name, Ga, Gb, Ve)
         @named oneport = OnePort()
@@ -48,4 +51,57 @@ using IfElse: ifelse
     sol = solve(prob, Rodas4())
 
     @test sol.retcode == Success
+
+    @testset "Native RHS export" begin
+        src = NativeRHSExport.emit_native_rhs(sys; name = "chua")
+        n = length(unknowns(sys))
+        @test length(src.unknowns) == n
+        @test occursin("DTE_EXPORT_COMPILED_RHS(\"chua\", $n, $(length(src.parameters))", src.code)
+        @test !occursin("Cannot emit", src.code)
+
+        # Native kernels are autonomous: a forced system is rejected
+        @variables v(t)
+        @named forced = System([ModelingToolkit.D_nounits(v) ~ -v + sin(t)], t)
+        @test_throws ErrorException NativeRHSExport.emit_native_rhs(mtkcompile(forced))
+
+        # The self-test fixture is current emitter output and builds against the ABI header
+        fixture = chua_fixture_source()
+        @test fixture.code == read(COMPILED_RHS_FIXTURE, String)
+        if Sys.which(get(ENV, "CXX", "c++")) !== nothing
+            @test isfile(NativeRHSExport.compile_native_rhs(fixture, mktempdir()))
+        end
+
+        # Compiled RHS and Jacobian agree with the MTK-generated function
+        if Sys.which(get(ENV, "CXX", "c++")) !== nothing
+            library = NativeRHSExport.compile_native_rhs(src, mktempdir())
+            p = NativeRHSExport.native_parameter_vector(src,
+                [q => prob.ps[q] for q in src.parameters])
+            handle = Base.Libc.Libdl.dlopen(library)
+            eval_rhs = Base.Libc.Libdl.dlsym(handle, :dte_rhs_eval)
+            eval_jac = Base.Libc.Libdl.dlsym(handle, :dte_rhs_jacobian)
+            for u in (copy(prob.u0), sol(1.0e3), sol(2.5e4))
+                du_native = zeros(n)
+                ccall(eval_rhs, Cvoid, (Ptr{Float64}, Ptr{Float64}, Float64, Ptr{Float64}),
+                    u, p, 0.0, du_native)
+                du = zeros(n)
+                prob.f(du, u, prob.p, 0.0)
+                @test du_native ≈ du rtol = 1e-10 atol = 1e-12
+
+                J_native = zeros(n * n)
+                ccall(eval_jac, Cvoid, (Ptr{Float64}, Ptr{Float64}, Float64, Ptr{Float64}),
+                    u, p, 0.0, J_native)
+                for j in 1:n
+                    h = 1e-6 * max(1.0, abs(u[j]))
+                    up, um = copy(u), copy(u)
+                    up[j] += h
+                    um[j] -= h
+                    fp, fm = zeros(n), zeros(n)
+                    prob.f(fp, up, prob.p, 0.0)
+                    prob.f(fm, um, prob.p, 0.0)
+                    @test [J_native[(i - 1) * n + j] for i in 1:n] ≈ (fp - fm) / (2h) rtol = 1e-5 atol = 1e-8
+                end
+            end
+            Base.Libc.Libdl.dlclose(handle)
+        end
+    end
 end
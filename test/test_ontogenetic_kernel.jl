@@ -20,6 +20,8 @@ using Random
 include("../src/DeepTreeEcho/DomainKernels.jl")
 using .DomainKernels
 
+include("../src/DeepTreeEcho/KernelEvolution.jl")
+
 # Access OntogeneticKernel through DomainKernels
 const OK = DomainKernels.OntogeneticKernel
 
@@ -40,7 +42,7 @@ Random.seed!(42)
 @testset "Ontogenetic Kernel Tests" begin
     
     @testset "1. Kernel Creation and Structure" begin
-        println("\n[1/6] Testing Kernel Creation and Structure...")
+        println("\n[1/7] Testing Kernel Creation and Structure...")
         
         # Test basic kernel creation
         kernel = create_kernel(4, symmetric=true, density=0.5)
@@ -74,7 +76,7 @@ Random.seed!(42)
     end
     
     @testset "2. Tree Generation" begin
-        println("\n[2/6] Testing Tree Generation...")
+        println("\n[2/7] Testing Tree Generation...")
         
         # Test tree generation
         trees_order_3 = generate_trees_up_to_order(3)
@@ -97,7 +99,7 @@ Random.seed!(42)
     end
     
     @testset "3. Fitness Evaluation" begin
-        println("\n[3/6] Testing Fitness Evaluation...")
+        println("\n[3/7] Testing Fitness Evaluation...")
         
         # Create test population
         population = [create_kernel(4) for _ in 1:5]
@@ -139,7 +141,7 @@ Random.seed!(42)
     end
     
     @testset "4. Kernel Operations" begin
-        println("\n[4/6] Testing Kernel Operations...")
+        println("\n[4/7] Testing Kernel Operations...")
         
         # Create parent kernels
         parent1 = create_kernel(4, symmetric=true, density=0.6)
@@ -185,7 +187,7 @@ Random.seed!(42)
     end
     
     @testset "5. Lifecycle Management" begin
-        println("\n[5/6] Testing Lifecycle Management...")
+        println("\n[5/7] Testing Lifecycle Management...")
         
         # Create kernel and age it
         kernel = create_kernel(4)
@@ -227,7 +229,7 @@ Random.seed!(42)
     end
     
     @testset "6. Domain-Specific Generators" begin
-        println("\n[6/6] Testing Domain-Specific Generators...")
+        println("\n[6/7] Testing Domain-Specific Generators...")
         
         # Test consciousness kernel
         consciousness = generate_consciousness_kernel(order=5, depth_bias=2.0)
@@ -277,6 +279,32 @@ Random.seed!(42)
         println("  ✓ Universal kernel generator working")
     end
     
+    @testset "7. Batch Fitness Hook" begin
+        println("\n[7/7] Testing Batch Fitness Hook...")
+        
+        KE = KernelEvolution
+        population = [KE.OntogeneticKernel.create_kernel(3) for _ in 1:6]
+        
+        # Ragged 0-based buffer, one slice per kernel
+        genomes, offsets = KE.pack_kernel_genomes(population)
+        @test offsets[1] == 0
+        @test offsets[end] == length(genomes)
+        @test diff(offsets) == [length(k.genome.coefficients) for k in population]
+        
+        # One batch call per generation scores every kernel
+        calls = Ref(0)
+        batch = (g, o) -> (calls[] += 1; [-sum(abs2, g[(o[i] + 1):o[i + 1]]; init = 0.0) for i in 1:(length(o) - 1)])
+        config = KE.EvolutionConfig(population_size = 6, max_generations = 1, fitness_threshold = -Inf)
+        KE.evolve_kernel_population!(population, config; batch_fitness = batch, verbose = false)
+        @test calls[] == 1
+        @test issorted([k.fitness for k in population], rev = true)
+        @test all(k -> k.fitness ≈ -sum(abs2, values(k.genome.coefficients); init = 0.0), population)
+        @test_throws DimensionMismatch KE.evolve_kernel_population!(population, config;
+            batch_fitness = (g, o) -> Float64[], verbose = false)
+        
+        println("  ✓ Batch fitness replaces the per-kernel loop")
+    end
+    
 end
 
 println("\n" * "="^70)